@@ -0,0 +1,149 @@
+#include "BatchRunner.h"
+
+#include "gameboy/Gameboy.h"
+#include "cartridge/Cartridge.h"
+#include "util/Assert.h"
+
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+
+namespace GBE
+{
+    namespace
+    {
+        bool ReadFile(const std::string& path, std::vector<uint8_t>& data)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open())
+                return false;
+
+            data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            return !data.empty();
+        }
+    } // namespace
+
+    BatchRunner::BatchRunner(size_t workersCount): m_ThreadPool(workersCount)
+    {
+    }
+
+    std::vector<BatchResult> BatchRunner::Run(const std::vector<BatchJob>& jobs)
+    {
+        // load every rom and input script once before dispatching, workers only read them
+        std::map<std::string, std::vector<uint8_t>> roms{};
+        std::map<std::string, InputScript> inputScripts{};
+        std::map<std::string, bool> validInputScripts{};
+
+        for (const BatchJob& job: jobs)
+        {
+            if (!roms.contains(job.RomPath))
+            {
+                std::vector<uint8_t> rom{};
+                ReadFile(job.RomPath, rom);
+                roms.emplace(job.RomPath, std::move(rom));
+            }
+
+            if (!job.InputScriptPath.empty() && !inputScripts.contains(job.InputScriptPath))
+            {
+                InputScript inputScript{};
+                validInputScripts[job.InputScriptPath] = inputScript.Load(job.InputScriptPath);
+                inputScripts.emplace(job.InputScriptPath, std::move(inputScript));
+            }
+        }
+
+        const InputScript emptyInputScript{};
+        std::vector<BatchResult> results(jobs.size());
+
+        m_ThreadPool.Run(jobs.size(), [&](size_t jobIndex, size_t)
+        {
+            const BatchJob& job = jobs[jobIndex];
+            BatchResult& result = results[jobIndex];
+
+            const std::vector<uint8_t>& rom = roms.at(job.RomPath);
+            if (rom.empty())
+            {
+                result.ExitReason = BatchExitReason::ROM_NOT_FOUND;
+                return;
+            }
+
+            const InputScript* inputScript = &emptyInputScript;
+            if (!job.InputScriptPath.empty())
+            {
+                if (!validInputScripts.at(job.InputScriptPath))
+                {
+                    result.ExitReason = BatchExitReason::INVALID_INPUT_SCRIPT;
+                    return;
+                }
+                inputScript = &inputScripts.at(job.InputScriptPath);
+            }
+
+            try
+            {
+                result = RunJob(job, rom, *inputScript);
+            }
+            catch (const std::exception&)
+            {
+                result.ExitReason = BatchExitReason::EXCEPTION;
+            }
+        });
+
+        return results;
+    }
+
+    BatchResult BatchRunner::RunJob(const BatchJob& job, std::span<const uint8_t> rom, const InputScript& inputScript)
+    {
+        GBE_ASSERT(job.MaxFrames > 0 || job.MaxCycles > 0);
+
+        BatchResult result{};
+
+        auto cartridge = std::make_shared<Cartridge>();
+        cartridge->LoadFromData(rom);
+
+        auto gameboy = std::make_unique<Gameboy>(job.Renderer);
+        gameboy->GetCpu().SetEngine(job.Engine);
+        gameboy->GetPpu().SetFrameSkip(job.FrameSkip);
+        gameboy->Start(cartridge);
+
+        size_t inputCursor = 0;
+        const auto startTime = std::chrono::steady_clock::now();
+
+        while (true)
+        {
+            if (!gameboy->IsRunning())
+            {
+                result.ExitReason = BatchExitReason::STOPPED;
+                break;
+            }
+
+            if (job.MaxFrames > 0 && result.Frames >= job.MaxFrames)
+            {
+                result.ExitReason = BatchExitReason::FRAME_LIMIT;
+                break;
+            }
+
+            if (job.MaxCycles > 0 && result.Cycles >= job.MaxCycles)
+            {
+                result.ExitReason = BatchExitReason::CYCLE_LIMIT;
+                break;
+            }
+
+            inputScript.QueueFrameEvents(result.Frames, gameboy->GetJoypad(), inputCursor);
+
+            result.Cycles += gameboy->Tick();
+            result.Frames++;
+        }
+
+        const auto endTime = std::chrono::steady_clock::now();
+
+        result.FrameHash = gameboy->GetPpu().GetLcdScreen().GetHash();
+        result.Instructions = gameboy->GetCpu().GetInstructionsCounter();
+        result.IdleLoopCycles = gameboy->GetCpu().GetIdleLoopSkippedCycles();
+        result.Seconds = std::chrono::duration<double>(endTime - startTime).count();
+
+        gameboy->Stop();
+        return result;
+    }
+} // namespace GBE
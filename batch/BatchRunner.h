@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "ThreadPool.h"
+#include "InputScript.h"
+
+#include "cpu/CpuEngine.h"
+#include "io/graphics/PpuRenderer.h"
+#include "util/Class.h"
+
+namespace GBE
+{
+    enum class BatchExitReason
+    {
+        NONE = 0,
+        FRAME_LIMIT,
+        CYCLE_LIMIT,
+        STOPPED,
+        ROM_NOT_FOUND,
+        INVALID_INPUT_SCRIPT,
+        EXCEPTION
+    };
+
+    // one gameboy instance to run
+    struct BatchJob
+    {
+        std::string RomPath = "";
+        // optional input script replayed on the joypad
+        std::string InputScriptPath = "";
+        // limits, 0 means no limit (at least one of them must be set)
+        uint64_t MaxFrames = 0;
+        uint64_t MaxCycles = 0;
+        CpuEngine Engine = CpuEngine::INTERPRETER;
+        PpuRenderer Renderer = PpuRenderer::FIFO;
+        // frames not drawn after each drawn frame
+        uint32_t FrameSkip = 0;
+    };
+
+    struct BatchResult
+    {
+        BatchExitReason ExitReason = BatchExitReason::NONE;
+        // hash of the last frame on the lcd screen
+        uint64_t FrameHash = 0;
+        uint64_t Frames = 0;
+        uint64_t Cycles = 0;
+        uint64_t Instructions = 0;
+        // m-cycles skipped by the idle loop detector
+        uint64_t IdleLoopCycles = 0;
+        double Seconds = 0.0;
+    };
+
+    // run many independent gameboy instances on a work stealing thread pool
+    // every job writes in its own result slot, so results are collected without a lock
+    class BatchRunner
+    {
+    public:
+        GBE_CLASS_NO_COPY_NO_MOVE(BatchRunner)
+
+        // 0 workers uses the hardware concurrency
+        BatchRunner(size_t workersCount = 0);
+        ~BatchRunner() = default;
+
+        // run all jobs, results[i] is the result of jobs[i]
+        std::vector<BatchResult> Run(const std::vector<BatchJob>& jobs);
+
+        // run one gameboy instance on the calling thread
+        static BatchResult RunJob(const BatchJob& job, std::span<const uint8_t> rom, const InputScript& inputScript);
+
+        inline const ThreadPool& GetThreadPool() const
+        {
+            return m_ThreadPool;
+        }
+
+    private:
+        ThreadPool m_ThreadPool;
+    };
+} // namespace GBE
@@ -0,0 +1,104 @@
+#include "InputScript.h"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <magic_enum.hpp>
+
+namespace GBE
+{
+    namespace
+    {
+        std::string_view TrimSpaces(std::string_view text)
+        {
+            size_t begin = text.find_first_not_of(" \t\r");
+            if (begin == std::string_view::npos)
+                return {};
+
+            size_t end = text.find_last_not_of(" \t\r");
+            return text.substr(begin, end - begin + 1);
+        }
+
+        std::string_view NextToken(std::string_view& text)
+        {
+            text = TrimSpaces(text);
+            size_t end = text.find_first_of(" \t");
+            std::string_view token = text.substr(0, end);
+            text = end == std::string_view::npos ? std::string_view{} : text.substr(end);
+            return token;
+        }
+    } // namespace
+
+    bool InputScript::Parse(std::string_view text)
+    {
+        m_Events.clear();
+
+        while (!text.empty())
+        {
+            size_t lineEnd = text.find('\n');
+            std::string_view line = text.substr(0, lineEnd);
+            text = lineEnd == std::string_view::npos ? std::string_view{} : text.substr(lineEnd + 1);
+
+            // strip comments
+            line = TrimSpaces(line.substr(0, line.find('#')));
+            if (line.empty())
+                continue;
+
+            std::string_view frameToken = NextToken(line);
+            std::string_view buttonToken = NextToken(line);
+            std::string_view stateToken = NextToken(line);
+            if (!TrimSpaces(line).empty())
+                return false;
+
+            InputScriptEvent event{};
+
+            auto [ptr, error] = std::from_chars(frameToken.data(), frameToken.data() + frameToken.size(), event.Frame);
+            if (error != std::errc{} || ptr != frameToken.data() + frameToken.size())
+                return false;
+
+            auto button = magic_enum::enum_cast<JoypadButton>(buttonToken, magic_enum::case_insensitive);
+            if (!button.has_value() || button.value() == JoypadButton::NONE)
+                return false;
+            event.Event.Button = button.value();
+
+            if (stateToken == "down")
+                event.Event.Pressed = true;
+            else if (stateToken == "up")
+                event.Event.Pressed = false;
+            else
+                return false;
+
+            m_Events.push_back(event);
+        }
+
+        std::stable_sort(m_Events.begin(), m_Events.end(), [](const InputScriptEvent& a, const InputScriptEvent& b)
+        {
+            return a.Frame < b.Frame;
+        });
+
+        return true;
+    }
+
+    bool InputScript::Load(std::string_view path)
+    {
+        std::ifstream file{std::string(path)};
+        if (!file.is_open())
+            return false;
+
+        std::stringstream buffer{};
+        buffer << file.rdbuf();
+        return Parse(buffer.str());
+    }
+
+    void InputScript::QueueFrameEvents(uint64_t frame, Joypad& joypad, size_t& cursor) const
+    {
+        while (cursor < m_Events.size() && m_Events[cursor].Frame <= frame)
+        {
+            joypad.QueueJoypadEvent(m_Events[cursor].Event);
+            cursor++;
+        }
+    }
+} // namespace GBE
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "io/joypad/Joypad.h"
+
+namespace GBE
+{
+    struct InputScriptEvent
+    {
+        uint64_t Frame = 0;
+        JoypadEvent Event{};
+    };
+
+    // list of joypad events to replay at given frames
+    // text format, one event per line: <frame> <button> <down|up>, '#' starts a comment
+    // example: 120 START down
+    class InputScript
+    {
+    public:
+        InputScript() = default;
+        ~InputScript() = default;
+
+        // parse script text, returns false on a malformed line
+        bool Parse(std::string_view text);
+        // load and parse script file
+        bool Load(std::string_view path);
+
+        // queue all events of the frame to the joypad, frames must be replayed in order
+        void QueueFrameEvents(uint64_t frame, Joypad& joypad, size_t& cursor) const;
+
+        inline const std::vector<InputScriptEvent>& GetEvents() const
+        {
+            return m_Events;
+        }
+
+    private:
+        std::vector<InputScriptEvent> m_Events{};
+    };
+} // namespace GBE
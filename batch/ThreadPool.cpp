@@ -0,0 +1,91 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace GBE
+{
+    ThreadPool::ThreadPool(size_t workersCount)
+    {
+        if (workersCount == 0)
+            workersCount = std::max(1u, std::thread::hardware_concurrency());
+
+        m_Queues.reserve(workersCount);
+        for (size_t i = 0; i < workersCount; i++)
+            m_Queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    void ThreadPool::Run(size_t jobsCount, const Job& job)
+    {
+        const size_t workersCount = m_Queues.size();
+
+        // split the jobs in contiguous ranges, one per worker
+        for (size_t worker = 0; worker < workersCount; worker++)
+        {
+            WorkerQueue& queue = *m_Queues[worker];
+            queue.Jobs.clear();
+            queue.StolenJobsCount = 0;
+
+            size_t begin = worker * jobsCount / workersCount;
+            size_t end = (worker + 1) * jobsCount / workersCount;
+            for (size_t jobIndex = begin; jobIndex < end; jobIndex++)
+                queue.Jobs.push_back(jobIndex);
+        }
+
+        // no job is added after this point, so a worker can stop as soon as there is nothing left to steal
+        {
+            std::vector<std::jthread> threads{};
+            threads.reserve(workersCount - 1);
+            for (size_t worker = 1; worker < workersCount; worker++)
+                threads.emplace_back(&ThreadPool::_WorkerLoop, this, worker, std::cref(job));
+
+            _WorkerLoop(0, job);
+        }
+
+        m_StolenJobsCount = 0;
+        for (const auto& queue: m_Queues)
+            m_StolenJobsCount += queue->StolenJobsCount;
+    }
+
+    void ThreadPool::_WorkerLoop(size_t workerIndex, const Job& job)
+    {
+        size_t jobIndex = 0;
+        while (_PopJob(workerIndex, jobIndex) || _StealJob(workerIndex, jobIndex))
+            job(jobIndex, workerIndex);
+    }
+
+    bool ThreadPool::_PopJob(size_t workerIndex, size_t& jobIndex)
+    {
+        WorkerQueue& queue = *m_Queues[workerIndex];
+        std::lock_guard lock{queue.Mutex};
+
+        if (queue.Jobs.empty())
+            return false;
+
+        // the owner takes jobs in order from the front
+        jobIndex = queue.Jobs.front();
+        queue.Jobs.pop_front();
+        return true;
+    }
+
+    bool ThreadPool::_StealJob(size_t workerIndex, size_t& jobIndex)
+    {
+        const size_t workersCount = m_Queues.size();
+        for (size_t i = 1; i < workersCount; i++)
+        {
+            WorkerQueue& victim = *m_Queues[(workerIndex + i) % workersCount];
+            std::lock_guard lock{victim.Mutex};
+
+            if (victim.Jobs.empty())
+                continue;
+
+            // thieves take from the back, away from the owner
+            jobIndex = victim.Jobs.back();
+            victim.Jobs.pop_back();
+            victim.StolenJobsCount++;
+            return true;
+        }
+
+        return false;
+    }
+} // namespace GBE
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "util/Class.h"
+
+namespace GBE
+{
+    // work stealing thread pool
+    // each worker owns a queue of job indices and steals from the other workers when its queue runs dry
+    class ThreadPool
+    {
+    public:
+        GBE_CLASS_NO_COPY_NO_MOVE(ThreadPool)
+
+        using Job = std::function<void(size_t jobIndex, size_t workerIndex)>;
+
+        // 0 workers uses the hardware concurrency
+        ThreadPool(size_t workersCount = 0);
+        ~ThreadPool() = default;
+
+        // run jobs [0, jobsCount) and wait for all of them to finish
+        // the calling thread is used as worker 0
+        void Run(size_t jobsCount, const Job& job);
+
+        inline size_t GetWorkersCount() const
+        {
+            return m_Queues.size();
+        }
+
+        // number of jobs stolen from another worker during the last run
+        inline size_t GetStolenJobsCount() const
+        {
+            return m_StolenJobsCount;
+        }
+
+    private:
+        struct WorkerQueue
+        {
+            std::mutex Mutex{};
+            std::deque<size_t> Jobs{};
+            size_t StolenJobsCount = 0;
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue>> m_Queues{};
+        size_t m_StolenJobsCount = 0;
+
+        void _WorkerLoop(size_t workerIndex, const Job& job);
+        bool _PopJob(size_t workerIndex, size_t& jobIndex);
+        bool _StealJob(size_t workerIndex, size_t& jobIndex);
+    };
+} // namespace GBE
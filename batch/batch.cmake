@@ -0,0 +1,11 @@
+set (GBE_HEADERS ${GBE_HEADERS}
+    ${CMAKE_CURRENT_LIST_DIR}/ThreadPool.h
+    ${CMAKE_CURRENT_LIST_DIR}/InputScript.h
+    ${CMAKE_CURRENT_LIST_DIR}/BatchRunner.h
+)
+
+set(GBE_SOURCES ${GBE_SOURCES}
+    ${CMAKE_CURRENT_LIST_DIR}/ThreadPool.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/InputScript.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/BatchRunner.cpp
+)
@@ -41,12 +41,31 @@ namespace GBE
 
         // Read bytes into buffer
         m_ROM = std::make_unique<uint8_t[]>(size);
+        m_ROMSize = size;
         file.read(reinterpret_cast<char *>(m_ROM.get()), size);
 
         SetReadFlag(true);
         SetWriteFlag(false);
     }
 
+    void Cartridge::LoadFromData(std::span<const uint8_t> data)
+    {
+        m_ROM = std::make_unique<uint8_t[]>(data.size());
+        m_ROMSize = data.size();
+        std::copy(data.begin(), data.end(), m_ROM.get());
+
+        SetReadFlag(true);
+        SetWriteFlag(false);
+    }
+
+    const uint8_t* Cartridge::GetReadData(uint16_t address, uint16_t size) const
+    {
+        if (!m_ROM || address + size > m_ROMSize)
+            return nullptr;
+
+        return m_ROM.get() + address;
+    }
+
     void Cartridge::_SetImp(uint16_t address, uint8_t value)
     {
         m_ROM[address] = value;
@@ -3,6 +3,7 @@
 #include "memory/MemoryArea.h"
 
 #include <memory>
+#include <span>
 #include <string_view>
 
 namespace GBE
@@ -14,10 +15,16 @@ namespace GBE
 
         void LoadFromAssets(std::string_view path);
         void Load(std::string_view path);
+        // load rom from an already read buffer (the data is copied)
+        void LoadFromData(std::span<const uint8_t> data);
 
         void Init() override;
+
+        // rom is read only, writes always go through the handler
+        const uint8_t* GetReadData(uint16_t address, uint16_t size) const override;
     private:
         std::unique_ptr<uint8_t[]> m_ROM = nullptr;
+        size_t m_ROMSize = 0;
         std::unique_ptr<uint8_t[]> m_RAM = nullptr;
 
         void _SetImp(uint16_t address, uint8_t value) override;
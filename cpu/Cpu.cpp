@@ -10,18 +10,28 @@
 #include "util/Binary.h" 
 #include "io/IORegister.h"
 #include "io/interrupts/InterruptManager.h"
+#include "util/StateWriter.h"
+#include "util/StateReader.h"
 
 #include <magic_enum.hpp>
+#include <bit>
 #include <iostream>
 #include <exception>
 
 
 namespace GBE
 {
+    namespace
+    {
+        // registers in a save state
+        constexpr std::array<Reg16, 6> STATE_REGISTERS = {Reg16::AF, Reg16::BC, Reg16::DE, Reg16::HL, Reg16::SP, Reg16::PC};
+    } // namespace
 
-    Cpu::Cpu(const std::shared_ptr<Memory> &memory, const std::shared_ptr<InstructionDecoder> &decoder):
+    Cpu::Cpu(const std::shared_ptr<Memory> &memory, const std::shared_ptr<InterruptManager> &interruptManager):
         m_Memory(memory),
-        m_Decoder(decoder)
+        m_InterruptManager(interruptManager),
+        m_BlockCache(memory),
+        m_Jit(*this, memory)
     {
     }
 
@@ -50,10 +60,49 @@ namespace GBE
         m_QueueIME = 0;
         m_IsHaltBug = false;
         m_IsHalted = false;
+        m_InstructionsCounter = 0;
+        m_IdleLoop = IdleLoopState{};
+        m_IdleLoopSkippedCycles = 0;
+
+        m_BlockCache.Clear();
+        m_Block = nullptr;
+        m_BlockOpIndex = 0;
+        m_Jit.Clear();
 
         m_Debugger.Init();
     }
 
+    void Cpu::SaveState(StateWriter& writer) const
+    {
+        for (Reg16 reg: STATE_REGISTERS)
+            writer.Write(m_Regs.GetReg16(reg));
+
+        writer.Write(m_IME);
+        writer.Write(m_IsHalted);
+        writer.Write(m_IsHaltBug);
+        writer.Write(m_QueueIME);
+        writer.Write(m_InstructionsCounter);
+        writer.Write(m_IdleLoopSkippedCycles);
+    }
+
+    void Cpu::LoadState(StateReader& reader)
+    {
+        for (Reg16 reg: STATE_REGISTERS)
+            m_Regs.SetReg16(reg, reader.Read<uint16_t>());
+
+        reader.Read(m_IME);
+        reader.Read(m_IsHalted);
+        reader.Read(m_IsHaltBug);
+        reader.Read(m_QueueIME);
+        reader.Read(m_InstructionsCounter);
+        reader.Read(m_IdleLoopSkippedCycles);
+
+        m_BlockCache.InvalidateRam();
+        m_Block = nullptr;
+        m_BlockOpIndex = 0;
+        m_IdleLoop = IdleLoopState{};
+    }
+
     uint8_t Cpu::GetReg16Adr(Reg16 adr) const
     {
         return m_Memory->Get(m_Regs.GetReg16(adr));
@@ -308,54 +357,17 @@ namespace GBE
         if (!m_IME)
             return false;
 
-
-        // list of interrupt flags ordered by priority
-        std::vector<InterruptFlag> flags = {
-            InterruptFlag::V_BLANK,
-            InterruptFlag::LCD,
-            InterruptFlag::TIMER,
-            InterruptFlag::SERIAL,
-            InterruptFlag::JOYPAD
-        };
-
-        for (auto flag: flags)
-        {
-            if (_HandleInterruptFlag(flag, result))
-            {
-                // std::cout << "Exception: " << magic_enum::enum_name(flag) << "\n";
-                return true;
-            }
-        }
-
-        return false;
-    }
-
-    bool Cpu::_HandleInterruptFlag(InterruptFlag flag, InstructionResult &result)
-    {
-        // cast flag to uint8_t
-        uint8_t flagBit = static_cast<uint8_t>(flag);
-
-
-        // get interrupt flags
-        uint8_t interruptEnable = m_Memory->Get(static_cast<uint16_t>(IORegister::IE));
-        uint8_t interruptFlag = m_Memory->Get(static_cast<uint16_t>(IORegister::IF));
-
-        // check interrupt enable
-        if (!Binary::TestBit(interruptEnable, flagBit))
-            return false;
-
-        // check interrupt flag
-        if (!Binary::TestBit(interruptFlag, flagBit))
+        uint8_t pendingInterrupts = m_InterruptManager->GetPendingInterrupts();
+        if (pendingInterrupts == 0)
             return false;
 
-        // get handler address
-        uint16_t handler = InterruptManager::GetHandler(flag);
+        // lowest bit has the highest priority (v-blank first)
+        InterruptFlag flag = static_cast<InterruptFlag>(std::countr_zero(pendingInterrupts));
 
         // handle interrupt
         m_IME = false; // disable IME flag
-        interruptFlag = Binary::ResetBit(interruptFlag, flagBit); // reset interrupt flag
-        m_Memory->Set(static_cast<uint16_t>(IORegister::IF), interruptFlag);
-        _Call(handler, result); // call interrupt
+        m_InterruptManager->AcknowledgeInterrupt(flag); // reset interrupt flag
+        _Call(InterruptManager::GetHandler(flag), result); // call interrupt
 
         // result
         result.Cycles = 5; // hard code 5 cycles it's easier that way
@@ -365,10 +377,7 @@ namespace GBE
 
     bool Cpu::_IsInterruptPending() const
     {
-        uint8_t interruptEnable = m_Memory->Get(static_cast<uint16_t>(IORegister::IE));
-        uint8_t interruptFlag = m_Memory->Get(static_cast<uint16_t>(IORegister::IF));
-
-        return (interruptEnable & interruptFlag) != 0;
+        return m_InterruptManager->GetPendingInterrupts() != 0;
     }
 
     void Cpu::Halt(const Instruction &instr, InstructionResult &result)
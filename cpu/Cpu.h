@@ -1,10 +1,15 @@
 #pragma once
 
 #include <memory>
+#include <functional>
+#include <array>
 
 #include "util/Class.h"
 
 #include "debugger/CpuDebugger.h"
+#include "block/CpuBlockCache.h"
+#include "jit/CpuJit.h"
+#include "CpuEngine.h"
 #include "registers/CpuRegistersSet.h"
 #include "alu/Alu.h"
 #include "instruction/Operand.h"
@@ -14,9 +19,11 @@
 namespace GBE
 {
     class Memory;
+    class InterruptManager;
     class InstructionResult;
-    class InstructionDecoder;
     class Instruction;
+    class StateWriter;
+    class StateReader;
 
     // cpu of the game boy
     // executes uintruction set
@@ -25,15 +32,61 @@ namespace GBE
     public:
         GBE_CLASS_NO_COPY_NO_MOVE(Cpu)
 
-        Cpu(const std::shared_ptr<Memory>& memory, const std::shared_ptr<InstructionDecoder>& decoder);
+        Cpu(const std::shared_ptr<Memory>& memory, const std::shared_ptr<InterruptManager>& interruptManager);
         ~Cpu();
 
         // init after boot load
         void Init();
 
+        // registers, interrupt and halt state
+        // loading drops the ram blocks since the ram is replaced behind the block cache
+        void SaveState(StateWriter& writer) const;
+        void LoadState(StateReader& reader);
+
         // run current instruction
         void Run(InstructionResult& result);
 
+        // set how instructions are fetched and dispatched
+        void SetEngine(CpuEngine engine);
+
+        inline CpuEngine GetEngine() const
+        {
+            return m_Engine;
+        }
+
+        inline const CpuBlockCache& GetBlockCache() const
+        {
+            return m_BlockCache;
+        }
+
+        inline const CpuJit& GetJit() const
+        {
+            return m_Jit;
+        }
+
+        // steps the rest of the hardware by cycles from inside a block
+        // returns false if the cycles weren't stepped (end of frame), the block then returns them to Run
+        using HardwareStep = std::function<bool(uint16_t cycles)>;
+
+        inline void SetHardwareStep(const HardwareStep& hardwareStep)
+        {
+            m_HardwareStep = hardwareStep;
+        }
+
+        // how many iterations of a busy-wait loop can be skipped before the polled io can change
+        using IdleLoopSkip = std::function<uint32_t(uint32_t iterationCycles)>;
+
+        inline void SetIdleLoopSkip(const IdleLoopSkip& idleLoopSkip)
+        {
+            m_IdleLoopSkip = idleLoopSkip;
+        }
+
+        // m-cycles skipped in busy-wait loops since init
+        inline uint64_t GetIdleLoopSkippedCycles() const
+        {
+            return m_IdleLoopSkippedCycles;
+        }
+
         // get registers
         inline CpuRegistersSet& GetRegisters() 
         {
@@ -90,6 +143,12 @@ namespace GBE
 
         inline void Nop(const Instruction &instr, InstructionResult &result) {}
 
+        // $CB: fetch and run the prefixed instruction
+        void Prefix(const Instruction &instr, InstructionResult &result);
+
+        // opcode without instruction
+        void InvalidInstruction(const Instruction &instr, InstructionResult &result);
+
         /*
             Load Operations
         */
@@ -176,10 +235,7 @@ namespace GBE
         // op A, imm8
         void ExecAluOpA_Imm8(Alu::OperationDestSrc8 op, bool addCarry, const Instruction &instr, InstructionResult &result);
         template <Alu::OperationDestSrc8 op, bool addCarry>
-        inline void ExecAluOpA_Imm8(const Instruction &instr, InstructionResult &result)
-        {
-            ExecAluOpA_Imm8(op, addCarry, instr, result);
-        }
+        void ExecAluOpA_Imm8(const Instruction &instr, InstructionResult &result);
 
         /*
             Bit manimulation
@@ -308,15 +364,94 @@ namespace GBE
             return m_IsHalted;
         }
 
+        // number of instructions executed since init
+        inline uint64_t GetInstructionsCounter() const
+        {
+            return m_InstructionsCounter;
+        }
+
          // get debugger
         inline CpuDebugger& GetDebugger()
         {
             return m_Debugger;
         }
 
+        /*
+            Handlers with operands known at compile time, one instantiation per opcode
+            (defined in CpuOpcodes.h and instantiated by the instruction decoder)
+        */
+
+        template <OperandR8 r8>
+        uint8_t GetOperandR8(InstructionResult &result);
+        template <OperandR8 r8>
+        void SetOperandR8(uint8_t value, InstructionResult &result);
+
+        template <OperandR16Stk r16stk>
+        uint16_t GetOperandR16Stk();
+        template <OperandR16Stk r16stk>
+        void SetOperandR16Stk(uint16_t value);
+
+        template <OperandR16Mem r16mem>
+        uint8_t GetOperandR16Mem(InstructionResult &result);
+        template <OperandR16Mem r16mem>
+        void SetOperandR16Mem(uint8_t value, InstructionResult &result);
+
+        template <OperandCond cc>
+        bool CheckOperandCond() const;
+
+        template <OperandR16 r16>
+        void LoadR16_Imm16(const Instruction &instr, InstructionResult &result);
+        template <OperandR16Mem r16mem>
+        void LoadR16Mem_A(const Instruction &instr, InstructionResult &result);
+        template <OperandR16Mem r16mem>
+        void LoadA_R16Mem(const Instruction &instr, InstructionResult &result);
+        template <OperandR8 r8>
+        void LoadR8_Imm8(const Instruction &instr, InstructionResult &result);
+        template <OperandR8 dest8, OperandR8 src8>
+        void LoadR8_R8(const Instruction &instr, InstructionResult &result);
+
+        template <OperandR16 r16>
+        void AddHL_R16(const Instruction &instr, InstructionResult &result);
+        template <Alu::OperationDest16 op, OperandR16 r16>
+        void ExecAluOpR16(const Instruction &instr, InstructionResult &result);
+        template <Alu::OperationDest8 op, OperandR8 r8>
+        void ExecAluOpR8(const Instruction &instr, InstructionResult &result);
+        template <Alu::OperationDestSrc8 op, bool addCarry, OperandR8 r8>
+        void ExecAluOpA_R8(const Instruction &instr, InstructionResult &result);
+
+        template <uint8_t bit, OperandR8 r8>
+        void TestBitR8(const Instruction &instr, InstructionResult &result);
+        template <uint8_t bit, OperandR8 r8>
+        void SetBitR8(const Instruction &instr, InstructionResult &result);
+        template <uint8_t bit, OperandR8 r8>
+        void ResetBitR8(const Instruction &instr, InstructionResult &result);
+
+        template <Alu::OperationRotateSrc op, ShiftDirection direction, OperandR8 r8, bool checkZero>
+        void RotateR8(const Instruction &instr, InstructionResult &result);
+        template <ShiftDirection direction, bool isLogical, OperandR8 r8>
+        void ShiftR8(const Instruction &instr, InstructionResult &result);
+        template <OperandR8 r8>
+        void SwapR8(const Instruction &instr, InstructionResult &result);
+
+        template <OperandR16Stk r16stk>
+        void PushR16Stk(const Instruction &instr, InstructionResult &result);
+        template <OperandR16Stk r16stk>
+        void PopR16Stk(const Instruction &instr, InstructionResult &result);
+
+        template <OperandCond cc>
+        void CallCC_Imm16(const Instruction &instr, InstructionResult &result);
+        template <OperandCond cc>
+        void JumpCC_Imm16(const Instruction &instr, InstructionResult &result);
+        template <OperandCond cc>
+        void JumpRelativeCC_Imm8(const Instruction &instr, InstructionResult &result);
+        template <OperandCond cc>
+        void ReturnCC(const Instruction &instr, InstructionResult &result);
+        template <uint8_t tgt3>
+        void RstVec(const Instruction &instr, InstructionResult &result);
+
     private: 
-        std::shared_ptr<InstructionDecoder> m_Decoder = nullptr;
         std::shared_ptr<Memory> m_Memory = nullptr;
+        std::shared_ptr<InterruptManager> m_InterruptManager = nullptr;
         CpuRegistersSet m_Regs{};
         CpuDebugger m_Debugger{};
 
@@ -326,15 +461,37 @@ namespace GBE
         bool m_IsHaltBug = false;
         int32_t m_QueueIME = 0; // Are we queuing IME to be set in the next instruction
 
+        uint64_t m_InstructionsCounter = 0;
+
+        CpuEngine m_Engine = CpuEngine::INTERPRETER;
+        CpuBlockCache m_BlockCache;
+        // block being run and index of its next op
+        const CpuBlock* m_Block = nullptr;
+        size_t m_BlockOpIndex = 0;
+
+        CpuJit m_Jit;
+        HardwareStep m_HardwareStep = nullptr;
+
+        // idle loop detector, an iteration leaving the registers unchanged is repeated until io changes
+        struct IdleLoopState
+        {
+            const CpuBlock* Block = nullptr;
+            std::array<uint16_t, 5> Regs{};
+            uint64_t Instructions = 0;
+            uint32_t Cycles = 0;
+        };
+        IdleLoopState m_IdleLoop{};
+        IdleLoopSkip m_IdleLoopSkip = nullptr;
+        uint64_t m_IdleLoopSkippedCycles = 0;
+
+        friend class CpuJit;
+
         // handle IME flag
         void _HandleIME();
 
         // handle interrupt and return if interrupt found
         bool _HandleInterrupts(InstructionResult &result);
 
-        // handle one interrupt flag and return if interrupt is found
-        bool _HandleInterruptFlag(InterruptFlag flag, InstructionResult &result);
-
         // handle halt state
         void _HandleHalt(InstructionResult &result);
 
@@ -361,6 +518,8 @@ namespace GBE
 
         // do operation on A 
         void _ExecAluOpA(Alu::OperationDestSrc8 op, uint8_t v8, bool addCarry);
+        template <Alu::OperationDestSrc8 op, bool addCarry>
+        void _ExecAluOpA(uint8_t v8);
     
         // call to adr16
         void _Call(uint16_t adr16, InstructionResult &result, bool isHaltBug = false);
@@ -374,8 +533,30 @@ namespace GBE
         // run instrunction
         void _RunInstruction(const Instruction &instr, InstructionResult &result);
 
-        // run prefix instruction
-        void _RunPrefixInstruction(InstructionResult &result);
+        // run next instruction of the block at pc, for the debugger and the halt bug
+        void _RunBlockInstruction(uint16_t pc, InstructionResult &result);
+
+        // is pc the next op of the current block
+        bool _IsInBlock(uint16_t pc) const;
+
+        // run the whole block, compiled or not (see CpuJit::Run)
+        uint32_t _RunBlock(CpuBlock* block);
+
+        // run the ops of block stepping the hardware between them (see CpuJit::Run)
+        uint32_t _RunBlockOps(const CpuBlock &block);
+
+        // run the compiled block, compiling it once hot, returns 0 if it isn't compiled
+        // block is looked up again if the cache is cleared
+        uint32_t _RunJitBlock(CpuBlock*& block);
+
+        // skip iterations of the idle loop block once it runs in place, false if nothing was skipped
+        bool _SkipIdleLoop(const CpuBlock &block, InstructionResult &result);
+
+        // called after each instruction of a block but the last, returns 0 to keep running the block
+        uint32_t _BlockStep(uint32_t cycles, bool isLoop);
+
+        // run op of a block, returns its cycles
+        uint32_t _RunBlockOp(const CpuBlockOp &op);
 
         // check if interrupt is pending
         bool _IsInterruptPending() const;
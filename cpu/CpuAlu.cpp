@@ -125,10 +125,6 @@ namespace GBE
 
     void Cpu::ExecAluOpA_Imm8(Alu::OperationDestSrc8 op, bool addCarry, const Instruction &instr, InstructionResult &result)
     {
-        // operands
-        auto [a, imm8] = instr.GetOperands<OperandR8, OperandImm8>();
-        GBE_ASSERT(a == OperandR8::A);
-
         // fetch
         uint8_t value = GetImm8(result);
 
@@ -0,0 +1,15 @@
+#pragma once
+
+namespace GBE
+{
+    // how the cpu fetches and dispatches instructions
+    enum class CpuEngine
+    {
+        // fetch and decode every instruction
+        INTERPRETER = 0,
+        // run pre-decoded straight-line blocks, a whole block per dispatch
+        BLOCK_CACHE,
+        // run hot blocks as native code, the others as BLOCK_CACHE
+        JIT
+    };
+} // namespace GBE
@@ -29,9 +29,6 @@ namespace GBE
 
     void Cpu::CallImm16(const Instruction &instr, InstructionResult &result)
     {
-        //  operands
-        auto [imm16] = instr.GetOperands<OperandImm16>();
-
         // fetch
         uint16_t imm16Value = GetImm16(result);
 
@@ -54,9 +51,6 @@ namespace GBE
 
     void Cpu::JumpHL(const Instruction &instr, InstructionResult &result)
     {
-        // operands
-        auto [hl] = instr.GetOperands<OperandR16>();
-     
         // fetch
         uint16_t adr16 = m_Regs.GetReg16(Reg16::HL);
 
@@ -49,13 +49,9 @@ namespace GBE
 
     void Cpu::LoadAdrImm16_SP(const Instruction &instr, InstructionResult &result)
     {
-        // operands
-        auto [imm16, sp] = instr.GetOperands<OperandImm16, OperandR16>();
-        GBE_ASSERT(sp == OperandR16::SP);
-
         // fetch
         int16_t imm16Value = GetImm16(result);
-        int16_t value = GetOperandR16(sp, result);
+        int16_t value = m_Regs.GetReg16(Reg16::SP);
 
         // execute
         m_Memory->Set16(imm16Value, value);
@@ -88,11 +84,6 @@ namespace GBE
 
     void Cpu::LoadHighC_A(const Instruction &instr, InstructionResult &result)
     {
-        // operands
-        auto [c, a] = instr.GetOperands<OperandR8, OperandR8>();
-        GBE_ASSERT(a == OperandR8::A);
-        GBE_ASSERT(c == OperandR8::C);
-
         // fetch
         uint8_t src = m_Regs.GetReg8(Reg8::A);
         uint16_t destAdr = 0xff00 + m_Regs.GetReg8(Reg8::C);
@@ -107,11 +98,6 @@ namespace GBE
 
     void Cpu::LoadA_HighC(const Instruction &instr, InstructionResult &result)
     {
-        // operands
-        auto [a, c] = instr.GetOperands<OperandR8, OperandR8>();
-        GBE_ASSERT(a == OperandR8::A);
-        GBE_ASSERT(c == OperandR8::C);
-
         // fetch
         uint16_t srcAdr = 0xff00 + m_Regs.GetReg8(Reg8::C);
         uint8_t src = m_Memory->Get(srcAdr);
@@ -123,10 +109,6 @@ namespace GBE
 
     void Cpu::LoadHighImm8_A(const Instruction &instr, InstructionResult &result)
     {
-        // operands
-        auto [imm8, a] = instr.GetOperands<OperandImm8, OperandR8>();
-        GBE_ASSERT(a == OperandR8::A);
-
         // fetch
         uint8_t src = m_Regs.GetReg8(Reg8::A);
         uint16_t destAdr = 0xff00 + GetImm8(result);
@@ -141,10 +123,6 @@ namespace GBE
 
     void Cpu::LoadA_HighImm8(const Instruction &instr, InstructionResult &result)
     {
-        // operands
-        auto [a, imm8] = instr.GetOperands<OperandR8, OperandImm8>();
-        GBE_ASSERT(a == OperandR8::A);
-
         // fetch
         uint16_t srcAdr = 0xff00 + GetImm8(result);
         uint8_t src = m_Memory->Get(srcAdr);
@@ -156,10 +134,6 @@ namespace GBE
 
     void Cpu::LoadAdrImm16_A(const Instruction &instr, InstructionResult &result)
     {
-        // operands
-        auto [imm16, a] = instr.GetOperands<OperandImm16, OperandR8>();
-        GBE_ASSERT(a == OperandR8::A);
-
         // fetch
         uint8_t src = m_Regs.GetReg8(Reg8::A);
         uint16_t destAdr = GetImm16(result);
@@ -174,10 +148,6 @@ namespace GBE
 
     void Cpu::LoadA_AdrImm16(const Instruction &instr, InstructionResult &result)
     {
-        // operands
-        auto [a, imm16] = instr.GetOperands<OperandR8, OperandImm16>();
-        GBE_ASSERT(a == OperandR8::A);
-
         // fetch
         uint16_t srcAdr = GetImm16(result);
         uint8_t src = m_Memory->Get(srcAdr);
@@ -189,21 +159,11 @@ namespace GBE
 
     void Cpu::LoadHL_SPImm8(const Instruction &instr, InstructionResult &result)
     {
-        // operands
-        auto [hl, sp, imm8] = instr.GetOperands<OperandR16, OperandR16, OperandImm8>();
-        GBE_ASSERT(sp == OperandR16::SP);
-        GBE_ASSERT(hl == OperandR16::HL);
-
         _AddToDestSP_Imm8(Reg16::HL, result);
     }
 
     void Cpu::LoadSP_HL(const Instruction &instr, InstructionResult &result)
     {
-        // operands
-        auto [sp, hl] = instr.GetOperands<OperandR16, OperandR16>();
-        GBE_ASSERT(sp == OperandR16::SP);
-        GBE_ASSERT(hl == OperandR16::HL);
-
         // fetch
         uint16_t hlValue = m_Regs.GetReg16(Reg16::HL);
 
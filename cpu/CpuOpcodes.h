@@ -0,0 +1,426 @@
+#pragma once
+
+// handlers with operands as template parameters
+// only included where the instruction table is built
+
+#include "Cpu.h"
+
+#include "instruction/Instruction.h"
+#include "instruction/InstructionResult.h"
+
+#include "alu/AluResult.h"
+#include "alu/Alu.h"
+
+#include "memory/Memory.h"
+
+namespace GBE
+{
+    /*
+        Operands
+    */
+
+    template <OperandR8 r8>
+    inline uint8_t Cpu::GetOperandR8(InstructionResult &result)
+    {
+        if constexpr (r8 == OperandR8::ADR_HL)
+        {
+            result.Cycles++;
+            return m_Memory->Get(m_Regs.GetReg16<Reg16::HL>());
+        }
+        else
+            return m_Regs.GetReg8<static_cast<Reg8>(r8)>();
+    }
+
+    template <OperandR8 r8>
+    inline void Cpu::SetOperandR8(uint8_t value, InstructionResult &result)
+    {
+        if constexpr (r8 == OperandR8::ADR_HL)
+        {
+            result.Cycles++;
+            m_Memory->Set(m_Regs.GetReg16<Reg16::HL>(), value);
+        }
+        else
+            m_Regs.SetReg8<static_cast<Reg8>(r8)>(value);
+    }
+
+    template <OperandR16Stk r16stk>
+    inline uint16_t Cpu::GetOperandR16Stk()
+    {
+        if constexpr (r16stk == OperandR16Stk::AF)
+            return m_Regs.GetReg16<Reg16::AF>();
+        else
+            return m_Regs.GetReg16<static_cast<Reg16>(r16stk)>();
+    }
+
+    template <OperandR16Stk r16stk>
+    inline void Cpu::SetOperandR16Stk(uint16_t value)
+    {
+        if constexpr (r16stk == OperandR16Stk::AF)
+            m_Regs.SetReg16<Reg16::AF>(value);
+        else
+            m_Regs.SetReg16<static_cast<Reg16>(r16stk)>(value);
+    }
+
+    template <OperandR16Mem r16mem>
+    inline uint8_t Cpu::GetOperandR16Mem(InstructionResult &result)
+    {
+        result.Cycles++;
+
+        if constexpr (r16mem == OperandR16Mem::HLI || r16mem == OperandR16Mem::HLD)
+        {
+            uint16_t hl = m_Regs.GetReg16<Reg16::HL>();
+            uint8_t value = m_Memory->Get(hl);
+            m_Regs.SetReg16<Reg16::HL>((r16mem == OperandR16Mem::HLI) ? hl + 1 : hl - 1);
+            return value;
+        }
+        else
+            return m_Memory->Get(m_Regs.GetReg16<static_cast<Reg16>(r16mem)>());
+    }
+
+    template <OperandR16Mem r16mem>
+    inline void Cpu::SetOperandR16Mem(uint8_t value, InstructionResult &result)
+    {
+        result.Cycles++;
+
+        if constexpr (r16mem == OperandR16Mem::HLI || r16mem == OperandR16Mem::HLD)
+        {
+            uint16_t hl = m_Regs.GetReg16<Reg16::HL>();
+            m_Memory->Set(hl, value);
+            m_Regs.SetReg16<Reg16::HL>((r16mem == OperandR16Mem::HLI) ? hl + 1 : hl - 1);
+        }
+        else
+            m_Memory->Set(m_Regs.GetReg16<static_cast<Reg16>(r16mem)>(), value);
+    }
+
+    template <OperandCond cc>
+    inline bool Cpu::CheckOperandCond() const
+    {
+        if constexpr (cc == OperandCond::Z)
+            return m_Regs.GetFlag(CpuFlag::Z);
+        else if constexpr (cc == OperandCond::NZ)
+            return !m_Regs.GetFlag(CpuFlag::Z);
+        else if constexpr (cc == OperandCond::C)
+            return m_Regs.GetFlag(CpuFlag::C);
+        else
+            return !m_Regs.GetFlag(CpuFlag::C);
+    }
+
+    /*
+        Load Operations
+    */
+
+    template <OperandR16 r16>
+    void Cpu::LoadR16_Imm16(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint16_t imm16Value = GetImm16(result);
+
+        // execute
+        m_Regs.SetReg16<static_cast<Reg16>(r16)>(imm16Value);
+    }
+
+    template <OperandR16Mem r16mem>
+    void Cpu::LoadR16Mem_A(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint8_t value = m_Regs.GetReg8<Reg8::A>();
+
+        // execute
+        SetOperandR16Mem<r16mem>(value, result);
+    }
+
+    template <OperandR16Mem r16mem>
+    void Cpu::LoadA_R16Mem(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint8_t value = GetOperandR16Mem<r16mem>(result);
+
+        // execute
+        m_Regs.SetReg8<Reg8::A>(value);
+    }
+
+    template <OperandR8 r8>
+    void Cpu::LoadR8_Imm8(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint8_t imm8Value = GetImm8(result);
+
+        // execute
+        SetOperandR8<r8>(imm8Value, result);
+    }
+
+    template <OperandR8 dest8, OperandR8 src8>
+    void Cpu::LoadR8_R8(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint8_t value = GetOperandR8<src8>(result);
+
+        // execute
+        SetOperandR8<dest8>(value, result);
+    }
+
+    /*
+        ALU Operations
+    */
+
+    template <OperandR16 r16>
+    void Cpu::AddHL_R16(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint16_t a = m_Regs.GetReg16<Reg16::HL>();
+        uint16_t b = m_Regs.GetReg16<static_cast<Reg16>(r16)>();
+
+        // execute
+        AluResult aluResult{};
+        Alu::Add16(a, b, aluResult);
+        result.Cycles++;
+
+        // save result
+        m_Regs.SetReg16<Reg16::HL>(aluResult.Result16);
+        m_Regs.SetFlags(aluResult.AffectedFlags, aluResult.Flags);
+    }
+
+    template <Alu::OperationDest16 op, OperandR16 r16>
+    void Cpu::ExecAluOpR16(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint16_t value = m_Regs.GetReg16<static_cast<Reg16>(r16)>();
+
+        // execute
+        AluResult aluResult{};
+        op(value, aluResult);
+        result.Cycles++;
+
+        // save result
+        m_Regs.SetReg16<static_cast<Reg16>(r16)>(aluResult.Result16);
+    }
+
+    template <Alu::OperationDest8 op, OperandR8 r8>
+    void Cpu::ExecAluOpR8(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint8_t value = GetOperandR8<r8>(result);
+
+        // execute
+        AluResult aluResult{};
+        op(value, aluResult);
+
+        // result
+        SetOperandR8<r8>(aluResult.Result8, result);
+        m_Regs.SetFlags(aluResult.AffectedFlags, aluResult.Flags);
+    }
+
+    template <Alu::OperationDestSrc8 op, bool addCarry>
+    inline void Cpu::_ExecAluOpA(uint8_t v8)
+    {
+        // fetch
+        uint8_t a = m_Regs.GetReg8<Reg8::A>();
+
+        // execute
+        AluResult aluResult{};
+        op(a, v8, aluResult, (addCarry) ? _GetCarry() : 0);
+
+        // result
+        m_Regs.SetReg8<Reg8::A>(aluResult.Result8);
+        m_Regs.SetFlags(aluResult.AffectedFlags, aluResult.Flags);
+    }
+
+    template <Alu::OperationDestSrc8 op, bool addCarry, OperandR8 r8>
+    void Cpu::ExecAluOpA_R8(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint8_t value = GetOperandR8<r8>(result);
+
+        // execute
+        _ExecAluOpA<op, addCarry>(value);
+    }
+
+    template <Alu::OperationDestSrc8 op, bool addCarry>
+    void Cpu::ExecAluOpA_Imm8(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint8_t value = GetImm8(result);
+
+        // execute
+        _ExecAluOpA<op, addCarry>(value);
+    }
+
+    /*
+        Bit manipulation
+    */
+
+    template <uint8_t bit, OperandR8 r8>
+    void Cpu::TestBitR8(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint8_t value = GetOperandR8<r8>(result);
+
+        // execute
+        AluResult aluResult{};
+        Alu::TestBit(bit, value, aluResult);
+
+        // result
+        m_Regs.SetFlags(aluResult.AffectedFlags, aluResult.Flags);
+    }
+
+    template <uint8_t bit, OperandR8 r8>
+    void Cpu::SetBitR8(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint8_t value = GetOperandR8<r8>(result);
+
+        // execute
+        AluResult aluResult{};
+        Alu::SetBit(bit, value, aluResult);
+
+        // result
+        SetOperandR8<r8>(aluResult.Result8, result);
+        m_Regs.SetFlags(aluResult.AffectedFlags, aluResult.Flags);
+    }
+
+    template <uint8_t bit, OperandR8 r8>
+    void Cpu::ResetBitR8(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint8_t value = GetOperandR8<r8>(result);
+
+        // execute
+        AluResult aluResult{};
+        Alu::ResetBit(bit, value, aluResult);
+
+        // result
+        SetOperandR8<r8>(aluResult.Result8, result);
+        m_Regs.SetFlags(aluResult.AffectedFlags, aluResult.Flags);
+    }
+
+    /*
+        Shift operations
+    */
+
+    template <Alu::OperationRotateSrc op, ShiftDirection direction, OperandR8 r8, bool checkZero>
+    void Cpu::RotateR8(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint8_t value = GetOperandR8<r8>(result);
+        uint8_t carry = _GetCarry();
+
+        // run alu rotation op
+        AluResult aluResult{};
+        op(value, carry, direction, aluResult, checkZero);
+
+        // save result
+        SetOperandR8<r8>(aluResult.Result8, result);
+        m_Regs.SetFlags(aluResult.AffectedFlags, aluResult.Flags);
+    }
+
+    template <ShiftDirection direction, bool isLogical, OperandR8 r8>
+    void Cpu::ShiftR8(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint8_t value = GetOperandR8<r8>(result);
+
+        // run alu shift op
+        AluResult aluResult{};
+        Alu::Shift(value, direction, aluResult, isLogical);
+
+        // save result
+        SetOperandR8<r8>(aluResult.Result8, result);
+        m_Regs.SetFlags(aluResult.AffectedFlags, aluResult.Flags);
+    }
+
+    template <OperandR8 r8>
+    void Cpu::SwapR8(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint8_t value = GetOperandR8<r8>(result);
+
+        // run alu swap op
+        AluResult aluResult{};
+        Alu::Swap(value, aluResult);
+
+        // save result
+        SetOperandR8<r8>(aluResult.Result8, result);
+        m_Regs.SetFlags(aluResult.AffectedFlags, aluResult.Flags);
+    }
+
+    /*
+        Stack manipulation
+    */
+
+    template <OperandR16Stk r16stk>
+    void Cpu::PushR16Stk(const Instruction &, InstructionResult &result)
+    {
+        // execute
+        Push(GetOperandR16Stk<r16stk>(), result);
+    }
+
+    template <OperandR16Stk r16stk>
+    void Cpu::PopR16Stk(const Instruction &, InstructionResult &result)
+    {
+        // execute
+        uint16_t top = Pop(result);
+
+        // result
+        SetOperandR16Stk<r16stk>(top);
+    }
+
+    /*
+        Jumps and subroutine instructions
+    */
+
+    template <OperandCond cc>
+    void Cpu::CallCC_Imm16(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint16_t imm16Value = GetImm16(result);
+
+        // execute
+        if (CheckOperandCond<cc>())
+            _Call(imm16Value, result);
+    }
+
+    template <OperandCond cc>
+    void Cpu::JumpCC_Imm16(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint16_t adr16 = GetImm16(result);
+
+        // execute
+        if (CheckOperandCond<cc>())
+        {
+            m_Regs.SetReg16<Reg16::PC>(adr16);
+            result.Cycles += 1;
+        }
+    }
+
+    template <OperandCond cc>
+    void Cpu::JumpRelativeCC_Imm8(const Instruction &, InstructionResult &result)
+    {
+        // fetch
+        uint8_t offset = GetImm8(result);
+
+        // execute
+        if (CheckOperandCond<cc>())
+            _JumpRelative(offset, result);
+    }
+
+    template <OperandCond cc>
+    void Cpu::ReturnCC(const Instruction &instr, InstructionResult &result)
+    {
+        result.Cycles++;
+
+        if (CheckOperandCond<cc>())
+            Return(instr, result);
+    }
+
+    template <uint8_t tgt3>
+    void Cpu::RstVec(const Instruction &, InstructionResult &result)
+    {
+        constexpr uint16_t adr16 = OperandTgt3{ tgt3 }.GetTargetAddress();
+
+        _Call(adr16, result, m_IsHaltBug);
+
+        m_IsHaltBug = false; // not run twice this instruction
+    }
+
+} // namespace GBE
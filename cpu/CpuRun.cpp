@@ -42,9 +42,53 @@ namespace GBE
         // handle instruction
         result.Cycles = 0;
 
-        uint8_t opcode = GetImm8(result);
-        const Instruction& instr = m_Decoder->Decode(opcode);
-        _RunInstruction(instr, result);
+        if (m_Engine == CpuEngine::INTERPRETER)
+        {
+            uint8_t opcode = GetImm8(result);
+            _RunInstruction(INSTRUCTION_TABLE[opcode], result);
+        }
+        else if (m_Debugger.IsEnabled() || m_IsHaltBug)
+        {
+            // the debugger and the halt bug need one instruction per run
+            _RunBlockInstruction(pc, result);
+        }
+        else
+        {
+            // the per instruction block is left, it may be retired by the lookup
+            m_Block = nullptr;
+
+            CpuBlock* block = m_BlockCache.GetBlock(pc);
+            if (block && block->IsIdleLoop)
+            {
+                // busy-wait loop, skip to when the polled io can change
+                if (_SkipIdleLoop(*block, result))
+                    return;
+            }
+            else
+                m_IdleLoop.Block = nullptr;
+
+            uint32_t blockExit = block ? _RunBlock(block) : 0;
+            if (blockExit == CpuJit::EXIT_INTERRUPT)
+            {
+                // the block instructions are already stepped and counted
+                _HandleInterrupts(result);
+                return;
+            }
+
+            if (blockExit > 0)
+            {
+                // last instruction of the block, stepped by the caller
+                result.Cycles = blockExit;
+            }
+            else
+            {
+                // not cacheable, fetch and decode
+                uint8_t opcode = GetImm8(result);
+                _RunInstruction(INSTRUCTION_TABLE[opcode], result);
+            }
+        }
+        m_InstructionsCounter++;
+        m_IdleLoop.Cycles += result.Cycles;
 
         // handle queue TME
         _HandleIME();
@@ -56,25 +100,185 @@ namespace GBE
 
     void Cpu::_RunInstruction(const Instruction &instr, InstructionResult& result)
     {
-        GBE_ASSERT(instr.GetType() != InstructionType::INVALID);
+        // invalid and prefix opcodes have their own handlers, no need to check the type
+        (this->*instr.GetMethod())(instr, result);
+    }
+
+    void Cpu::SetEngine(CpuEngine engine)
+    {
+        m_Engine = engine;
+
+        m_BlockCache.Clear();
+        m_Block = nullptr;
+        m_BlockOpIndex = 0;
+        m_Jit.Clear();
+    }
+
+    bool Cpu::_IsInBlock(uint16_t pc) const
+    {
+        return m_Block && m_Block->IsValid && 
+            m_BlockOpIndex < m_Block->Ops.size() && 
+            m_Block->Ops[m_BlockOpIndex].PC == pc;
+    }
+
+    void Cpu::_RunBlockInstruction(uint16_t pc, InstructionResult &result)
+    {
+        // keep running the current block while pc follows it
+        // (interrupts, halt bug and written code leave the block)
+        if (!_IsInBlock(pc))
+        {
+            m_Block = m_BlockCache.GetBlock(pc);
+            m_BlockOpIndex = 0;
+        }
 
-        if (instr.GetType() == InstructionType::PREFIX_INST)
+        // not cacheable, fetch and decode
+        if (!m_Block)
         {
-            _RunPrefixInstruction(result);
+            uint8_t opcode = GetImm8(result);
+            _RunInstruction(INSTRUCTION_TABLE[opcode], result);
             return;
         }
-        
-        // run instruction method
-        (this->*instr.GetMethod())(instr, result);
+
+        const CpuBlockOp &op = m_Block->Ops[m_BlockOpIndex++];
+
+        // opcode (and $CB prefix) fetch
+        _AddPC(op.OpcodeSize);
+        result.Cycles += op.OpcodeSize;
+
+        _RunInstruction(*op.Instr, result);
     }
 
-    void Cpu::_RunPrefixInstruction(InstructionResult &result)
+    uint32_t Cpu::_RunBlock(CpuBlock* block)
     {
-        uint8_t opcode = GetImm8(result);
-        const Instruction& instr = m_Decoder->DecodePrefix(opcode);
-        (this->*instr.GetMethod())(instr, result);
+        if (m_Engine == CpuEngine::JIT)
+        {
+            uint32_t jitExit = _RunJitBlock(block);
+            if (jitExit > 0)
+                return jitExit;
+        }
+
+        return _RunBlockOps(*block);
     }
 
+    uint32_t Cpu::_RunBlockOps(const CpuBlock &block)
+    {
+        const size_t lastOp = block.Ops.size() - 1;
+        for (size_t i = 0;; i++)
+        {
+            uint32_t cycles = _RunBlockOp(block.Ops[i]);
 
+            // written code leaves the block
+            if (i == lastOp || !block.IsValid)
+                return cycles;
+
+            uint32_t exit = _BlockStep(cycles, false);
+            if (exit > 0)
+                return exit;
+        }
+    }
+
+    uint32_t Cpu::_RunJitBlock(CpuBlock*& block)
+    {
+        if (!m_Jit.IsAvailable())
+            return 0;
+
+        if (!block->Code)
+        {
+            if (block->Runs++ < CpuJit::HOT_BLOCK_RUNS)
+                return 0;
+
+            // code buffer full, start over
+            if (!m_Jit.Compile(*block))
+            {
+                uint16_t start = block->Start;
+                m_Jit.Clear();
+                m_BlockCache.Clear();
+                block = m_BlockCache.GetBlock(start);
+                return 0;
+            }
+        }
+
+        return m_Jit.Run(*block);
+    }
+
+    bool Cpu::_SkipIdleLoop(const CpuBlock &block, InstructionResult &result)
+    {
+        // nothing else depending on the instruction count
+        if (!m_IdleLoopSkip || m_QueueIME != 0)
+            return false;
+
+        const std::array<uint16_t, 5> regs = {
+            m_Regs.GetReg16<Reg16::AF>(),
+            m_Regs.GetReg16<Reg16::BC>(),
+            m_Regs.GetReg16<Reg16::DE>(),
+            m_Regs.GetReg16<Reg16::HL>(),
+            m_Regs.GetReg16<Reg16::SP>()
+        };
+
+        // exactly one iteration since the last entry, leaving the registers as they were
+        bool isFixedPoint = m_IdleLoop.Block == &block &&
+            m_IdleLoop.Instructions + block.Ops.size() == m_InstructionsCounter &&
+            m_IdleLoop.Regs == regs;
+
+        uint32_t iterationCycles = m_IdleLoop.Cycles;
+        m_IdleLoop = IdleLoopState{
+            .Block = &block,
+            .Regs = regs,
+            .Instructions = m_InstructionsCounter,
+            .Cycles = 0
+        };
+
+        if (!isFixedPoint || iterationCycles == 0)
+            return false;
+
+        uint32_t iterations = m_IdleLoopSkip(iterationCycles);
+        if (iterations == 0)
+            return false;
+
+        result.Cycles = iterations * iterationCycles;
+        m_InstructionsCounter += iterations * block.Ops.size();
+        m_IdleLoop.Instructions = m_InstructionsCounter;
+        m_IdleLoopSkippedCycles += result.Cycles;
+        return true;
+    }
+
+    uint32_t Cpu::_BlockStep(uint32_t cycles, bool isLoop)
+    {
+        // without hardware only the straight-line part of the block runs
+        bool isStepped = m_HardwareStep ? m_HardwareStep(cycles) : !isLoop;
+        if (!isStepped)
+            return cycles;
+
+        m_InstructionsCounter++;
+        m_IdleLoop.Cycles += cycles;
+        _HandleIME();
+
+        if (m_IME && _IsInterruptPending())
+            return CpuJit::EXIT_INTERRUPT;
+
+        return 0;
+    }
+
+    uint32_t Cpu::_RunBlockOp(const CpuBlockOp &op)
+    {
+        InstructionResult result{};
+        result.Cycles = op.OpcodeSize;
+        _AddPC(op.OpcodeSize);
+
+        _RunInstruction(*op.Instr, result);
+        return result.Cycles;
+    }
+
+    void Cpu::Prefix(const Instruction &instr, InstructionResult &result)
+    {
+        uint8_t opcode = GetImm8(result);
+        const Instruction& prefixInstr = INSTRUCTION_TABLE[INSTRUCTION_TABLE_PREFIX_OFFSET + opcode];
+        (this->*prefixInstr.GetMethod())(prefixInstr, result);
+    }
+
+    void Cpu::InvalidInstruction(const Instruction &instr, InstructionResult &result)
+    {
+        GBE_ASSERT(instr.GetType() != InstructionType::INVALID);
+    }
 
 } // namespace GBE
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace GBE
+{
+    class Instruction;
+
+    // pre-decoded instruction of a block
+    struct CpuBlockOp
+    {
+        // decoded instruction (from the prefix table for $CB opcodes)
+        const Instruction* Instr = nullptr;
+        // address of the opcode
+        uint16_t PC = 0;
+        // bytes fetched before running the handler, 2 for $CB opcodes
+        uint8_t OpcodeSize = 1;
+    };
+
+    // straight-line run of instructions, ends after the first control flow instruction
+    struct CpuBlock
+    {
+        uint16_t Start = 0;
+        // last byte of the block (inclusive)
+        uint16_t End = 0;
+        // false once the block code has been written to
+        bool IsValid = true;
+        std::vector<CpuBlockOp> Ops{};
+        // busy-wait loop branching back to its start, its other ops only read registers or polled io
+        bool IsIdleLoop = false;
+
+        // times the block was entered by the jit engine
+        uint32_t Runs = 0;
+        // native code, null until compiled by the jit
+        const void* Code = nullptr;
+    };
+} // namespace GBE
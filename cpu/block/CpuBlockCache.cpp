@@ -0,0 +1,286 @@
+#include "CpuBlockCache.h"
+
+#include "cpu/instruction/Instruction.h"
+#include "cpu/instruction/InstructionDecoder.h"
+
+#include "memory/Memory.h"
+#include "memory/Ram.h"
+#include "util/Assert.h"
+
+#include <algorithm>
+#include <array>
+
+namespace GBE
+{
+    namespace
+    {
+        // regions blocks can be built from, a block never crosses a region
+        constexpr std::array<MemoryMap, 4> CACHEABLE_REGIONS = {
+            MMAP_ROM_BANK_0,
+            MMAP_ROM_BANK_1_N,
+            MMAP_WRAM,
+            MMAP_HRAM
+        };
+
+        // instructions that can change pc or stop the cpu
+        constexpr bool EndsBlock(InstructionType type)
+        {
+            switch (type)
+            {
+            case InstructionType::JP:
+            case InstructionType::JR:
+            case InstructionType::CALL:
+            case InstructionType::RET:
+            case InstructionType::RETI:
+            case InstructionType::RST:
+            case InstructionType::HALT:
+            case InstructionType::STOP:
+            case InstructionType::INVALID:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        // io registers only changed by the hardware events (LY, STAT, IF)
+        constexpr bool IsPolledRegister(uint16_t address)
+        {
+            return address == 0xFF44 || address == 0xFF41 || address == 0xFF0F;
+        }
+
+        // op only changes registers and flags, memory reads are limited to polled io registers
+        bool IsIdleLoopBodyOp(const CpuBlockOp& op, const Memory& memory)
+        {
+            const uint8_t opcode = op.Instr->GetOpcode();
+            const bool isHL = (opcode & 0x7) == 6;
+
+            // bit b, r8
+            if (op.OpcodeSize == 2)
+                return opcode >= 0x40 && opcode <= 0x7F && !isHL;
+
+            // ld r8, r8 (not halt or [hl])
+            if (opcode >= 0x40 && opcode <= 0x7F)
+                return !isHL && (opcode & 0x38) != 0x30;
+
+            // and / xor / or / cp a, r8
+            if (opcode >= 0xA0 && opcode <= 0xBF)
+                return !isHL;
+
+            switch (opcode)
+            {
+            case 0x00: // nop
+            case 0xE6: // and a, imm8
+            case 0xEE: // xor a, imm8
+            case 0xF6: // or a, imm8
+            case 0xFE: // cp a, imm8
+                return true;
+            case 0xF0: // ldh a, [imm8]
+                return IsPolledRegister(0xFF00 + memory.Get(op.PC + 1));
+            case 0xFA: // ld a, [imm16]
+                return IsPolledRegister(memory.Get16(op.PC + 1));
+            default:
+                return false;
+            }
+        }
+
+        // jr / jp (cond) back to the block start
+        bool IsIdleLoopBranch(const CpuBlockOp& op, const CpuBlock& block, const Memory& memory)
+        {
+            if (op.OpcodeSize != 1)
+                return false;
+
+            switch (op.Instr->GetOpcode())
+            {
+            case 0x18: case 0x20: case 0x28: case 0x30: case 0x38:
+                return static_cast<uint16_t>(op.PC + 2 + static_cast<int8_t>(memory.Get(op.PC + 1))) == block.Start;
+            case 0xC3: case 0xC2: case 0xCA: case 0xD2: case 0xDA:
+                return memory.Get16(op.PC + 1) == block.Start;
+            default:
+                return false;
+            }
+        }
+
+        bool IsIdleLoop(const CpuBlock& block, const Memory& memory)
+        {
+            if (!IsIdleLoopBranch(block.Ops.back(), block, memory))
+                return false;
+
+            return std::all_of(block.Ops.begin(), block.Ops.end() - 1, [&](const CpuBlockOp& op)
+            {
+                return IsIdleLoopBodyOp(op, memory);
+            });
+        }
+    } // namespace
+
+    CpuBlockCache::CpuBlockCache(const std::shared_ptr<Memory> &memory):
+        m_Memory(memory),
+        m_Blocks(UINT16_MAX + 1),
+        m_RamCode(UINT16_MAX + 1, 0)
+    {
+    }
+
+    CpuBlockCache::~CpuBlockCache()
+    {
+        Clear();
+    }
+
+    CpuBlock* CpuBlockCache::GetBlock(uint16_t pc)
+    {
+        if (!m_RetiredBlocks.empty())
+            m_RetiredBlocks.clear();
+
+        if (m_Blocks[pc])
+            return m_Blocks[pc].get();
+
+        const MemoryMap* region = _GetRegion(pc);
+        if (!region)
+            return nullptr;
+
+        std::unique_ptr<CpuBlock> block = _BuildBlock(pc, *region);
+        if (!block)
+            return nullptr;
+
+        // rom is read only, only ram blocks can be written to
+        if (MMAP_WRAM.In(pc) || MMAP_HRAM.In(pc))
+        {
+            _WatchBlock(*block);
+            m_RamBlocks.push_back(block.get());
+        }
+
+        m_Blocks[pc] = std::move(block);
+        m_BlocksCount++;
+        return m_Blocks[pc].get();
+    }
+
+    void CpuBlockCache::Invalidate(uint16_t address)
+    {
+        if (m_RamCode[address] == 0)
+            return;
+
+        for (size_t i = 0; i < m_RamBlocks.size();)
+        {
+            CpuBlock* block = m_RamBlocks[i];
+            if (address < block->Start || address > block->End)
+            {
+                i++;
+                continue;
+            }
+
+            for (uint32_t codeAddress = block->Start; codeAddress <= block->End; codeAddress++)
+                m_RamCode[codeAddress]--;
+
+            block->IsValid = false;
+            m_RetiredBlocks.push_back(std::move(m_Blocks[block->Start]));
+            m_BlocksCount--;
+
+            m_RamBlocks[i] = m_RamBlocks.back();
+            m_RamBlocks.pop_back();
+        }
+    }
+
+    void CpuBlockCache::InvalidateRam()
+    {
+        for (CpuBlock* block: m_RamBlocks)
+        {
+            for (uint32_t codeAddress = block->Start; codeAddress <= block->End; codeAddress++)
+                m_RamCode[codeAddress]--;
+
+            block->IsValid = false;
+            m_RetiredBlocks.push_back(std::move(m_Blocks[block->Start]));
+            m_BlocksCount--;
+        }
+
+        m_RamBlocks.clear();
+    }
+
+    void CpuBlockCache::Clear()
+    {
+        if (m_BlocksCount > 0)
+        {
+            for (auto& block: m_Blocks)
+                block.reset();
+        }
+
+        m_BlocksCount = 0;
+        m_RamBlocks.clear();
+        m_RetiredBlocks.clear();
+        std::fill(m_RamCode.begin(), m_RamCode.end(), 0);
+
+        if (m_IsWatching)
+        {
+            m_Memory->SetWriteWatcher(nullptr);
+            m_IsWatching = false;
+        }
+    }
+
+    const MemoryMap* CpuBlockCache::_GetRegion(uint16_t address)
+    {
+        for (const MemoryMap& region: CACHEABLE_REGIONS)
+        {
+            if (region.In(address))
+                return &region;
+        }
+
+        return nullptr;
+    }
+
+    std::unique_ptr<CpuBlock> CpuBlockCache::_BuildBlock(uint16_t pc, const MemoryMap& region) const
+    {
+        auto block = std::make_unique<CpuBlock>();
+        block->Start = pc;
+
+        uint32_t address = pc;
+        while (block->Ops.size() < MAX_BLOCK_OPS)
+        {
+            CpuBlockOp op{};
+            op.PC = address;
+            op.Instr = &InstructionDecoder::Decode(m_Memory->Get(address));
+
+            if (op.Instr->GetType() == InstructionType::PREFIX_INST)
+            {
+                if (address + 1 > region.GetEnd())
+                    break;
+
+                op.Instr = &InstructionDecoder::DecodePrefix(m_Memory->Get(address + 1));
+                op.OpcodeSize = 2;
+            }
+
+            // opcode and immediates must be inside the region
+            uint32_t size = (op.OpcodeSize - 1) + op.Instr->GetSize();
+            if (address + size - 1 > region.GetEnd())
+                break;
+
+            block->Ops.push_back(op);
+            address += size;
+
+            if (EndsBlock(op.Instr->GetType()) || address > region.GetEnd())
+                break;
+        }
+
+        if (block->Ops.empty())
+            return nullptr;
+
+        block->End = address - 1;
+        block->IsIdleLoop = IsIdleLoop(*block, *m_Memory);
+        return block;
+    }
+
+    void CpuBlockCache::_WatchBlock(const CpuBlock& block)
+    {
+        if (!m_IsWatching)
+        {
+            m_Memory->SetWriteWatcher([this](uint16_t address)
+            {
+                Invalidate(address);
+            });
+            m_IsWatching = true;
+        }
+
+        for (uint32_t address = block.Start; address <= block.End; address++)
+        {
+            GBE_ASSERT(m_RamCode[address] < UINT16_MAX);
+            m_RamCode[address]++;
+            m_Memory->WatchPage(address, true);
+        }
+    }
+} // namespace GBE
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "CpuBlock.h"
+
+#include "memory/MemoryMap.h"
+#include "util/Class.h"
+
+namespace GBE
+{
+    class Memory;
+
+    // cache of decoded blocks indexed by their start address
+    // blocks are only built from rom and ram, writes to ram invalidate the blocks they overlap
+    class CpuBlockCache
+    {
+    public:
+        GBE_CLASS_NO_COPY_NO_MOVE(CpuBlockCache)
+
+        static constexpr size_t MAX_BLOCK_OPS = 64;
+
+        CpuBlockCache(const std::shared_ptr<Memory>& memory);
+        ~CpuBlockCache();
+
+        // get block starting at pc (decoded on first use), null if pc isn't cacheable
+        CpuBlock* GetBlock(uint16_t pc);
+
+        // invalidate the blocks containing address
+        void Invalidate(uint16_t address);
+
+        // remove all blocks
+        void Clear();
+
+        // invalidate all the ram blocks, when the ram is replaced without going through memory
+        void InvalidateRam();
+
+        inline size_t GetBlocksCount() const
+        {
+            return m_BlocksCount;
+        }
+
+    private:
+        std::shared_ptr<Memory> m_Memory = nullptr;
+        // one slot per address
+        std::vector<std::unique_ptr<CpuBlock>> m_Blocks{};
+        size_t m_BlocksCount = 0;
+
+        // ram blocks, checked on invalidation
+        std::vector<CpuBlock*> m_RamBlocks{};
+        // number of ram blocks containing each address
+        std::vector<uint16_t> m_RamCode{};
+        // invalidated blocks, kept alive until the next lookup since the cpu may still point to them
+        std::vector<std::unique_ptr<CpuBlock>> m_RetiredBlocks{};
+        bool m_IsWatching = false;
+
+        // get memory map of the cacheable region containing address
+        static const MemoryMap* _GetRegion(uint16_t address);
+
+        std::unique_ptr<CpuBlock> _BuildBlock(uint16_t pc, const MemoryMap& region) const;
+        void _WatchBlock(const CpuBlock& block);
+    };
+} // namespace GBE
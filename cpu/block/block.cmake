@@ -0,0 +1,8 @@
+set (GBE_HEADERS ${GBE_HEADERS}
+    ${CMAKE_CURRENT_LIST_DIR}/CpuBlock.h
+    ${CMAKE_CURRENT_LIST_DIR}/CpuBlockCache.h
+)
+
+set(GBE_SOURCES ${GBE_SOURCES}
+    ${CMAKE_CURRENT_LIST_DIR}/CpuBlockCache.cpp
+)
@@ -3,9 +3,13 @@ include(${CMAKE_CURRENT_LIST_DIR}/instruction/instruction.cmake)
 include(${CMAKE_CURRENT_LIST_DIR}/registers/registers.cmake)
 include (${CMAKE_CURRENT_LIST_DIR}/debugger/debugger.cmake)
 include (${CMAKE_CURRENT_LIST_DIR}/disassembler/disassembler.cmake)
+include (${CMAKE_CURRENT_LIST_DIR}/block/block.cmake)
+include (${CMAKE_CURRENT_LIST_DIR}/jit/jit.cmake)
 
 set (GBE_HEADERS ${GBE_HEADERS}
     ${CMAKE_CURRENT_LIST_DIR}/Cpu.h
+    ${CMAKE_CURRENT_LIST_DIR}/CpuEngine.h
+    ${CMAKE_CURRENT_LIST_DIR}/CpuOpcodes.h
 )
 
 set(GBE_SOURCES ${GBE_SOURCES}
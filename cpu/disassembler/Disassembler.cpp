@@ -13,12 +13,8 @@
 
 namespace GBE
 {
-    Disassembler::Disassembler(
-        const std::shared_ptr<Memory>& memory, 
-        const std::shared_ptr<InstructionDecoder>& decoder
-    ):
-        m_Memory(memory),
-        m_Decoder(decoder)
+    Disassembler::Disassembler(const std::shared_ptr<Memory>& memory):
+        m_Memory(memory)
     {
     }
 
@@ -131,11 +127,11 @@ namespace GBE
         uint8_t opcode = m_Memory->Get(address);
 
         // decode instruction
-        const Instruction &instr = m_Decoder->Decode(opcode);
+        const Instruction &instr = InstructionDecoder::Decode(opcode);
         if (instr.GetType() == InstructionType::PREFIX_INST)
         {
             uint8_t prefixOpcode = m_Memory->Get(address + 1);
-            const Instruction &prefixInstr = m_Decoder->DecodePrefix(prefixOpcode);
+            const Instruction &prefixInstr = InstructionDecoder::DecodePrefix(prefixOpcode);
 
             _CreateAssembly(address, prefixInstr, assembly, true);
             return;
@@ -10,7 +10,6 @@
 
 namespace GBE
 {
-    class InstructionDecoder;
     class Memory;
     class Instruction;
 
@@ -25,7 +24,7 @@ namespace GBE
     public:
         GBE_CLASS_NO_COPY_NO_MOVE(Disassembler)
 
-        Disassembler(const std::shared_ptr<Memory>& memory, const std::shared_ptr<InstructionDecoder>& decoder);
+        Disassembler(const std::shared_ptr<Memory>& memory);
         ~Disassembler() = default;
         
         void Disassemble(uint16_t startAddress, const AssemblySection& secion);
@@ -44,7 +43,6 @@ namespace GBE
         
     private:
         std::shared_ptr<Memory> m_Memory = nullptr;
-        std::shared_ptr<InstructionDecoder> m_Decoder = nullptr;
 
         std::array<Assembly, UINT16_MAX + 1 > m_AssemblyInstructions{};
         std::array<bool, UINT16_MAX + 1> m_IsDisassembled = { false };
@@ -2,6 +2,8 @@
 
 #include <cstdint>
 #include <array>
+#include <tuple>
+#include <utility>
 
 #include "Operand.h"
 #include "InstructionType.h"
@@ -17,17 +19,22 @@ namespace GBE
     class Instruction
     {   
     public:
-        Instruction() = default;
-        ~Instruction() = default;
+        // cpu handler running the instruction
+        using Method = void (Cpu::*)(const Instruction &istr, InstructionResult &result);
+
+        constexpr Instruction() = default;
+        constexpr ~Instruction() = default;
 
         template <typename T, typename... Args>
-        inline void AddOperand(T operand, Args... args)
+        constexpr void AddOperand(T operand, Args... args)
         {
-            m_Operands[m_OperandsCount++].Set(operand);
+            Operand& op = m_Operands[m_OperandsCount++];
+            op.Set(operand);
 
-            if (Operand::GetOperandType<T>() == OperandType::IMM8)
+            // type of the operand, also for [imm8] / [imm16]
+            if (op.GetType() == OperandType::IMM8)
                 m_Size += 1;
-            else if (Operand::GetOperandType<T>() == OperandType::IMM16)
+            else if (op.GetType() == OperandType::IMM16)
                 m_Size += 2;
 
             if constexpr (sizeof...(args) > 0)
@@ -36,7 +43,7 @@ namespace GBE
 
         
         template <typename T>
-        inline T GetOperand(size_t indx) const
+        constexpr T GetOperand(size_t indx) const
         {
             GBE_ASSERT(Operand::GetOperandType<T>() == m_Operands[indx].GetType());
             GBE_ASSERT(indx < m_OperandsCount);
@@ -45,7 +52,7 @@ namespace GBE
 
         // get operand at as tuple of types T...
         template <typename... T>
-        inline std::tuple<T...> GetOperands() const
+        constexpr std::tuple<T...> GetOperands() const
         {
             GBE_ASSERT(sizeof...(T) == m_OperandsCount);
 
@@ -56,70 +63,70 @@ namespace GBE
             return getOperandsImpl(std::index_sequence_for<T...>{});
         }
 
-        inline size_t GetOperandsCount() const 
+        constexpr size_t GetOperandsCount() const 
         { 
             return m_OperandsCount; 
         }
 
-        inline void ClearOperands()
+        constexpr void ClearOperands()
         {
             m_OperandsCount = 0;
         }
 
-        inline OperandType GetOperandType(size_t indx) const 
+        constexpr OperandType GetOperandType(size_t indx) const 
         {
             GBE_ASSERT(indx < m_OperandsCount);
             return m_Operands[indx].GetType(); 
         }
 
-        inline bool IsOperandAddress(size_t indx) const
+        constexpr bool IsOperandAddress(size_t indx) const
         {
             GBE_ASSERT(indx < m_OperandsCount);
             return m_Operands[indx].IsAddress();
         }
 
-        inline Operand GetOperand(size_t indx) const
+        constexpr Operand GetOperand(size_t indx) const
         {
             GBE_ASSERT(indx < m_OperandsCount);
             return m_Operands[indx];
         }
 
-        inline void SetOpcode(uint8_t opcode)
+        constexpr void SetOpcode(uint8_t opcode)
         {
             m_Opcode = opcode;
         }
 
-        inline uint8_t GetOpcode() const
+        constexpr uint8_t GetOpcode() const
         {
             return m_Opcode;
         }
         
-        inline void SetType(InstructionType type)
+        constexpr void SetType(InstructionType type)
         {
             m_Type = type;
         }
         
-        inline InstructionType GetType() const
+        constexpr InstructionType GetType() const
         {
             return m_Type;
         }
 
-        inline void SetSize(uint16_t size)
+        constexpr void SetSize(uint16_t size)
         {
             m_Size = size;
         }
 
-        inline uint16_t GetSize() const
+        constexpr uint16_t GetSize() const
         {
             return m_Size;
         }
 
-        inline void SetMethod(void (Cpu::*method)(const Instruction &istr, InstructionResult &result))
+        constexpr void SetMethod(Method method)
         {
             m_Method = method;
         }
 
-        inline auto GetMethod() const
+        constexpr Method GetMethod() const
         {
             return m_Method;
         }
@@ -132,6 +139,6 @@ namespace GBE
         InstructionType m_Type = InstructionType::NONE;
         uint16_t m_Size = 1;
 
-        void (Cpu::*m_Method)(const Instruction &istr, InstructionResult &result) = nullptr;
+        Method m_Method = nullptr;
     };
 } // namespace GBE
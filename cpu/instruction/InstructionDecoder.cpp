@@ -1,17 +1,18 @@
 #include "InstructionDecoder.h"
 #include "cpu/Cpu.h"
+#include "cpu/CpuOpcodes.h"
 #include "cpu/alu/Alu.h"
 
 #include <print>
+#include <stdexcept>
+#include <utility>
 
 
 namespace GBE
 {
-    const Instruction &InstructionDecoder::Decode(uint8_t opcode) const
+    constexpr Instruction InstructionDecoder::_DecodeInstruction(uint8_t opcode)
     {
-        Instruction& instr = m_Instructions.at(opcode);
-        if (instr.GetType() != InstructionType::NONE)
-            return instr;
+        Instruction instr{};
 
         // read block instruction (inspired by: https://gbdev.io/pandocs/CPU_Instruction_Set.html)
         // block id is the last 2 bits (6 and 7)
@@ -19,7 +20,7 @@ namespace GBE
         // invalid by default
         instr.SetType(InstructionType::INVALID);
         instr.SetSize(1);
-        instr.SetMethod(&Cpu::Nop);
+        instr.SetMethod(&Cpu::InvalidInstruction);
 
         // decode !!
         instr.SetOpcode(opcode);
@@ -49,11 +50,9 @@ namespace GBE
         return instr;
     }
 
-    const Instruction &InstructionDecoder::DecodePrefix(uint8_t opcode) const
+    constexpr Instruction InstructionDecoder::_DecodePrefix(uint8_t opcode)
     {
-        Instruction &instr = m_PrefixInstructions.at(opcode);
-        if (instr.GetType() != InstructionType::NONE)
-            return instr;
+        Instruction instr{};
 
         instr.SetOpcode(opcode);
         _DecodePrefixInstruction(instr);
@@ -62,7 +61,7 @@ namespace GBE
         return instr;
     }
 
-    void InstructionDecoder::_DecodeBlock0(Instruction &instr)
+    constexpr void InstructionDecoder::_DecodeBlock0(Instruction &instr)
     {
         uint8_t opcode = instr.GetOpcode();
 
@@ -219,7 +218,7 @@ namespace GBE
         }
     }
 
-    void InstructionDecoder::_DecodeBlock1(Instruction &instr)
+    constexpr void InstructionDecoder::_DecodeBlock1(Instruction &instr)
     {
         uint8_t opcode = instr.GetOpcode();
 
@@ -241,7 +240,7 @@ namespace GBE
         instr.AddOperand(dest8, src8);
     }
 
-    void InstructionDecoder::_DecodeBlock2(Instruction &instr)
+    constexpr void InstructionDecoder::_DecodeBlock2(Instruction &instr)
     {
         uint8_t opcode = instr.GetOpcode();
         
@@ -296,7 +295,7 @@ namespace GBE
         }
     }
 
-    void InstructionDecoder::_DecodeBlock3(Instruction &instr)
+    constexpr void InstructionDecoder::_DecodeBlock3(Instruction &instr)
     {
         uint8_t opcode = instr.GetOpcode();
 
@@ -382,6 +381,7 @@ namespace GBE
         // $CB prefix
         case 0xCB:
             instr.SetType(InstructionType::PREFIX_INST);
+            instr.SetMethod(&Cpu::Prefix);
             return;
         // ldh [c], a
         case 0xE2:
@@ -501,7 +501,7 @@ namespace GBE
         }
     }
 
-    void InstructionDecoder::_DecodePrefixInstruction(Instruction &instr)
+    constexpr void InstructionDecoder::_DecodePrefixInstruction(Instruction &instr)
     {
         // retreive opcode
         uint8_t opcode = instr.GetOpcode();
@@ -591,11 +591,134 @@ namespace GBE
         _ThrowInvalidInstruction();
     }
 
+    constexpr InstructionTable InstructionDecoder::BuildTable()
+    {
+        auto buildTableImpl = []<std::size_t... I>(std::index_sequence<I...>)
+        {
+            return InstructionTable{ _DecodeSpecialised<I>()... };
+        };
+        return buildTableImpl(std::make_index_sequence<INSTRUCTION_TABLE_SIZE>{});
+    }
+
+    constexpr bool InstructionDecoder::_IsMethod(Instruction::Method method, Instruction::Method other)
+    {
+        return method == other;
+    }
+
+    template <uint16_t index>
+    constexpr Instruction InstructionDecoder::_DecodeSpecialised()
+    {
+        constexpr bool isPrefix = index >= INSTRUCTION_TABLE_PREFIX_OFFSET;
+        constexpr Instruction decoded = (isPrefix) ? 
+            _DecodePrefix(index - INSTRUCTION_TABLE_PREFIX_OFFSET) : 
+            _DecodeInstruction(index);
+        constexpr Instruction::Method method = decoded.GetMethod();
+
+        Instruction instr = decoded;
+
+        // load
+        if constexpr (_IsMethod(method, &Cpu::LoadR16_Imm16))
+            instr.SetMethod(&Cpu::LoadR16_Imm16<decoded.GetOperand<OperandR16>(0)>);
+        else if constexpr (_IsMethod(method, &Cpu::LoadR16Mem_A))
+            instr.SetMethod(&Cpu::LoadR16Mem_A<decoded.GetOperand<OperandR16Mem>(0)>);
+        else if constexpr (_IsMethod(method, &Cpu::LoadA_R16Mem))
+            instr.SetMethod(&Cpu::LoadA_R16Mem<decoded.GetOperand<OperandR16Mem>(1)>);
+        else if constexpr (_IsMethod(method, &Cpu::LoadR8_Imm8))
+            instr.SetMethod(&Cpu::LoadR8_Imm8<decoded.GetOperand<OperandR8>(0)>);
+        else if constexpr (_IsMethod(method, &Cpu::LoadR8_R8))
+            instr.SetMethod(&Cpu::LoadR8_R8<decoded.GetOperand<OperandR8>(0), decoded.GetOperand<OperandR8>(1)>);
+
+        // alu
+        else if constexpr (_IsMethod(method, &Cpu::AddHL_R16))
+            instr.SetMethod(&Cpu::AddHL_R16<decoded.GetOperand<OperandR16>(1)>);
+        else if constexpr (_IsMethod(method, &Cpu::ExecAluOpR16<&Alu::Increment16>))
+            instr.SetMethod(&Cpu::ExecAluOpR16<&Alu::Increment16, decoded.GetOperand<OperandR16>(0)>);
+        else if constexpr (_IsMethod(method, &Cpu::ExecAluOpR16<&Alu::Decrement16>))
+            instr.SetMethod(&Cpu::ExecAluOpR16<&Alu::Decrement16, decoded.GetOperand<OperandR16>(0)>);
+        else if constexpr (_IsMethod(method, &Cpu::ExecAluOpR8<&Alu::Increment8>))
+            instr.SetMethod(&Cpu::ExecAluOpR8<&Alu::Increment8, decoded.GetOperand<OperandR8>(0)>);
+        else if constexpr (_IsMethod(method, &Cpu::ExecAluOpR8<&Alu::Decrement8>))
+            instr.SetMethod(&Cpu::ExecAluOpR8<&Alu::Decrement8, decoded.GetOperand<OperandR8>(0)>);
+        else if constexpr (_IsMethod(method, &Cpu::ExecAluOpA_R8<&Alu::Add8, false>))
+            instr.SetMethod(&Cpu::ExecAluOpA_R8<&Alu::Add8, false, decoded.GetOperand<OperandR8>(1)>);
+        else if constexpr (_IsMethod(method, &Cpu::ExecAluOpA_R8<&Alu::Add8, true>))
+            instr.SetMethod(&Cpu::ExecAluOpA_R8<&Alu::Add8, true, decoded.GetOperand<OperandR8>(1)>);
+        else if constexpr (_IsMethod(method, &Cpu::ExecAluOpA_R8<&Alu::Sub8, false>))
+            instr.SetMethod(&Cpu::ExecAluOpA_R8<&Alu::Sub8, false, decoded.GetOperand<OperandR8>(1)>);
+        else if constexpr (_IsMethod(method, &Cpu::ExecAluOpA_R8<&Alu::Sub8, true>))
+            instr.SetMethod(&Cpu::ExecAluOpA_R8<&Alu::Sub8, true, decoded.GetOperand<OperandR8>(1)>);
+        else if constexpr (_IsMethod(method, &Cpu::ExecAluOpA_R8<&Alu::And8, false>))
+            instr.SetMethod(&Cpu::ExecAluOpA_R8<&Alu::And8, false, decoded.GetOperand<OperandR8>(1)>);
+        else if constexpr (_IsMethod(method, &Cpu::ExecAluOpA_R8<&Alu::Xor8, false>))
+            instr.SetMethod(&Cpu::ExecAluOpA_R8<&Alu::Xor8, false, decoded.GetOperand<OperandR8>(1)>);
+        else if constexpr (_IsMethod(method, &Cpu::ExecAluOpA_R8<&Alu::Or8, false>))
+            instr.SetMethod(&Cpu::ExecAluOpA_R8<&Alu::Or8, false, decoded.GetOperand<OperandR8>(1)>);
+        else if constexpr (_IsMethod(method, &Cpu::ExecAluOpA_R8<&Alu::Cmp8, false>))
+            instr.SetMethod(&Cpu::ExecAluOpA_R8<&Alu::Cmp8, false, decoded.GetOperand<OperandR8>(1)>);
+
+        // bits
+        else if constexpr (_IsMethod(method, &Cpu::TestBitR8))
+            instr.SetMethod(&Cpu::TestBitR8<decoded.GetOperand<OperandBit3>(0).Value, decoded.GetOperand<OperandR8>(1)>);
+        else if constexpr (_IsMethod(method, &Cpu::SetBitR8))
+            instr.SetMethod(&Cpu::SetBitR8<decoded.GetOperand<OperandBit3>(0).Value, decoded.GetOperand<OperandR8>(1)>);
+        else if constexpr (_IsMethod(method, &Cpu::ResetBitR8))
+            instr.SetMethod(&Cpu::ResetBitR8<decoded.GetOperand<OperandBit3>(0).Value, decoded.GetOperand<OperandR8>(1)>);
+
+        // shifts (rlca/rrca/rla/rra are the operand-less rotations of A without zero flag)
+        else if constexpr (_IsMethod(method, &Cpu::RotateR8<Alu::RotateCarry, ShiftDirection::LEFT>) && !isPrefix)
+            instr.SetMethod(&Cpu::RotateR8<Alu::RotateCarry, ShiftDirection::LEFT, OperandR8::A, false>);
+        else if constexpr (_IsMethod(method, &Cpu::RotateR8<Alu::RotateCarry, ShiftDirection::RIGHT>) && !isPrefix)
+            instr.SetMethod(&Cpu::RotateR8<Alu::RotateCarry, ShiftDirection::RIGHT, OperandR8::A, false>);
+        else if constexpr (_IsMethod(method, &Cpu::RotateR8<Alu::Rotate, ShiftDirection::LEFT>) && !isPrefix)
+            instr.SetMethod(&Cpu::RotateR8<Alu::Rotate, ShiftDirection::LEFT, OperandR8::A, false>);
+        else if constexpr (_IsMethod(method, &Cpu::RotateR8<Alu::Rotate, ShiftDirection::RIGHT>) && !isPrefix)
+            instr.SetMethod(&Cpu::RotateR8<Alu::Rotate, ShiftDirection::RIGHT, OperandR8::A, false>);
+        else if constexpr (_IsMethod(method, &Cpu::RotateR8<Alu::RotateCarry, ShiftDirection::LEFT>))
+            instr.SetMethod(&Cpu::RotateR8<Alu::RotateCarry, ShiftDirection::LEFT, decoded.GetOperand<OperandR8>(0), true>);
+        else if constexpr (_IsMethod(method, &Cpu::RotateR8<Alu::RotateCarry, ShiftDirection::RIGHT>))
+            instr.SetMethod(&Cpu::RotateR8<Alu::RotateCarry, ShiftDirection::RIGHT, decoded.GetOperand<OperandR8>(0), true>);
+        else if constexpr (_IsMethod(method, &Cpu::RotateR8<Alu::Rotate, ShiftDirection::LEFT>))
+            instr.SetMethod(&Cpu::RotateR8<Alu::Rotate, ShiftDirection::LEFT, decoded.GetOperand<OperandR8>(0), true>);
+        else if constexpr (_IsMethod(method, &Cpu::RotateR8<Alu::Rotate, ShiftDirection::RIGHT>))
+            instr.SetMethod(&Cpu::RotateR8<Alu::Rotate, ShiftDirection::RIGHT, decoded.GetOperand<OperandR8>(0), true>);
+        else if constexpr (_IsMethod(method, &Cpu::ShiftR8<ShiftDirection::LEFT, false>))
+            instr.SetMethod(&Cpu::ShiftR8<ShiftDirection::LEFT, false, decoded.GetOperand<OperandR8>(0)>);
+        else if constexpr (_IsMethod(method, &Cpu::ShiftR8<ShiftDirection::RIGHT, false>))
+            instr.SetMethod(&Cpu::ShiftR8<ShiftDirection::RIGHT, false, decoded.GetOperand<OperandR8>(0)>);
+        else if constexpr (_IsMethod(method, &Cpu::ShiftR8<ShiftDirection::RIGHT, true>))
+            instr.SetMethod(&Cpu::ShiftR8<ShiftDirection::RIGHT, true, decoded.GetOperand<OperandR8>(0)>);
+        else if constexpr (_IsMethod(method, &Cpu::SwapR8))
+            instr.SetMethod(&Cpu::SwapR8<decoded.GetOperand<OperandR8>(0)>);
+
+        // stack
+        else if constexpr (_IsMethod(method, &Cpu::PushR16Stk))
+            instr.SetMethod(&Cpu::PushR16Stk<decoded.GetOperand<OperandR16Stk>(0)>);
+        else if constexpr (_IsMethod(method, &Cpu::PopR16Stk))
+            instr.SetMethod(&Cpu::PopR16Stk<decoded.GetOperand<OperandR16Stk>(0)>);
+
+        // jumps
+        else if constexpr (_IsMethod(method, &Cpu::CallCC_Imm16))
+            instr.SetMethod(&Cpu::CallCC_Imm16<decoded.GetOperand<OperandCond>(0)>);
+        else if constexpr (_IsMethod(method, &Cpu::JumpCC_Imm16))
+            instr.SetMethod(&Cpu::JumpCC_Imm16<decoded.GetOperand<OperandCond>(0)>);
+        else if constexpr (_IsMethod(method, &Cpu::JumpRelativeCC_Imm8))
+            instr.SetMethod(&Cpu::JumpRelativeCC_Imm8<decoded.GetOperand<OperandCond>(0)>);
+        else if constexpr (_IsMethod(method, &Cpu::ReturnCC))
+            instr.SetMethod(&Cpu::ReturnCC<decoded.GetOperand<OperandCond>(0)>);
+        else if constexpr (_IsMethod(method, &Cpu::RstVec))
+            instr.SetMethod(&Cpu::RstVec<decoded.GetOperand<OperandTgt3>(0).Value>);
+
+        // the other handlers have fixed operands
+        return instr;
+    }
+
     void InstructionDecoder::_ThrowInvalidInstruction()
     {
         GBE_ASSERT(false);
         throw std::runtime_error("Instruction unknown!");
     }
 
+    constexpr InstructionTable INSTRUCTION_TABLE = InstructionDecoder::BuildTable();
+
 } // namespace GBE
 
@@ -6,27 +6,52 @@
 
 namespace GBE
 {
+    // base instructions followed by the $CB prefixed ones
+    constexpr uint16_t INSTRUCTION_TABLE_PREFIX_OFFSET = UINT8_MAX + 1;
+    constexpr uint16_t INSTRUCTION_TABLE_SIZE = INSTRUCTION_TABLE_PREFIX_OFFSET * 2;
+
+    using InstructionTable = std::array<Instruction, INSTRUCTION_TABLE_SIZE>;
+
+    // every instruction decoded at compile time, read only and shared by all cpus
+    extern const InstructionTable INSTRUCTION_TABLE;
+
     class InstructionDecoder
     {
     public:
         InstructionDecoder() = default;
         ~InstructionDecoder() = default;
         
-        const Instruction& Decode(uint8_t opcode) const;
-        const Instruction& DecodePrefix(uint8_t opcode) const;
+        static inline const Instruction& Decode(uint8_t opcode)
+        {
+            return INSTRUCTION_TABLE[opcode];
+        }
+
+        static inline const Instruction& DecodePrefix(uint8_t opcode)
+        {
+            return INSTRUCTION_TABLE[INSTRUCTION_TABLE_PREFIX_OFFSET + opcode];
+        }
+
+        // decode all instructions (evaluated at compile time for INSTRUCTION_TABLE)
+        static constexpr InstructionTable BuildTable();
 
     private:
-        static void _DecodeBlock0(Instruction &instr);
-        static void _DecodeBlock1(Instruction &instr);
-        static void _DecodeBlock2(Instruction &instr);
-        static void _DecodeBlock3(Instruction &instr);
-        static void _DecodePrefixInstruction(Instruction &instr);
+        // decode the instruction at table index and swap its handler for
+        // the instantiation with the operands as template parameters
+        template <uint16_t index>
+        static constexpr Instruction _DecodeSpecialised();
+
+        static constexpr bool _IsMethod(Instruction::Method method, Instruction::Method other);
+
+        static constexpr Instruction _DecodeInstruction(uint8_t opcode);
+        static constexpr Instruction _DecodePrefix(uint8_t opcode);
+
+        static constexpr void _DecodeBlock0(Instruction &instr);
+        static constexpr void _DecodeBlock1(Instruction &instr);
+        static constexpr void _DecodeBlock2(Instruction &instr);
+        static constexpr void _DecodeBlock3(Instruction &instr);
+        static constexpr void _DecodePrefixInstruction(Instruction &instr);
 
         // invalid instruction
         static void _ThrowInvalidInstruction();
-
-        // cache
-        mutable std::array<Instruction, UINT8_MAX + 1> m_Instructions{ {} };
-        mutable std::array<Instruction, UINT8_MAX + 1> m_PrefixInstructions{ {} };
     };
 } // namespace GBE
@@ -59,7 +59,7 @@ namespace GBE
     struct OperandTgt3 { 
         uint8_t Value = 0;
 
-        inline uint16_t GetTargetAddress() const 
+        constexpr uint16_t GetTargetAddress() const 
         {
             return static_cast<uint16_t>(Value) * 8;
         }
@@ -76,7 +76,7 @@ namespace GBE
     };
 
     template <typename T>
-    static OperandAddress<T> OperandAddressOf(T t)
+    constexpr OperandAddress<T> OperandAddressOf(T t)
     {
         OperandAddress<T> opAdr{};
         opAdr.Op = t;
@@ -147,38 +147,38 @@ namespace GBE
         };
 
         template <typename T>
-        inline void Set(T op)
+        constexpr void Set(T op)
         {
             m_Operand = op;
             m_Type = GetOperandType<T>();
         }
 
         template <typename T>
-        inline void Set(OperandAddress<T> op)
+        constexpr void Set(OperandAddress<T> op)
         {
             Set<T>(op.Op);
             m_IsAddress = true;
         }
 
         template <typename T>
-        inline const T& Get() const
+        constexpr const T& Get() const
         {
             GBE_ASSERT(GetOperandType<T>() == m_Type);
             return std::get<T>(m_Operand);
         }
 
-        inline OperandType GetType() const
+        constexpr OperandType GetType() const
         {
             return m_Type;
         }
 
-        inline bool IsAddress() const 
+        constexpr bool IsAddress() const
         {
             return m_IsAddress;
         }
 
     private:
-        Variant m_Operand;
+        Variant m_Operand{};
 
         OperandType m_Type = OperandType::NONE;
         bool m_IsAddress = false;
@@ -0,0 +1,852 @@
+#include "CpuJit.h"
+
+#include "cpu/Cpu.h"
+#include "cpu/block/CpuBlock.h"
+#include "cpu/instruction/Instruction.h"
+
+#include "memory/Memory.h"
+#include "memory/MemoryArea.h"
+#include "util/Assert.h"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__linux__)
+    #define GBE_JIT_SUPPORTED 1
+    #include <sys/mman.h>
+#else
+    #define GBE_JIT_SUPPORTED 0
+#endif
+
+namespace GBE
+{
+    namespace
+    {
+        // guest registers kept in callee saved host registers for the whole block
+        // pairs hold the 16 bits value, A and F one byte each
+        constexpr X64Reg HOST_A = X64Reg::R12;
+        constexpr X64Reg HOST_F = X64Reg::R13;
+        constexpr X64Reg HOST_BC = X64Reg::RBX;
+        constexpr X64Reg HOST_DE = X64Reg::RBP;
+        constexpr X64Reg HOST_HL = X64Reg::R14;
+        // registers set, SP and PC stay in memory
+        constexpr X64Reg HOST_REGS = X64Reg::R15;
+
+        // operands encoding of the opcodes
+        constexpr uint8_t R8_ADR_HL = 6;
+        constexpr uint8_t R8_A = 7;
+
+        // lahf (SF ZF 0 AF 0 PF 1 CF) to Z N H C flags
+        constexpr std::array<uint8_t, 256> LAHF_FLAGS = []()
+        {
+            std::array<uint8_t, 256> flags{};
+            for (size_t i = 0; i < flags.size(); i++)
+            {
+                if (i & 0x40)
+                    flags[i] |= CpuFlag::Z;
+                if (i & 0x10)
+                    flags[i] |= CpuFlag::H;
+                if (i & 0x01)
+                    flags[i] |= CpuFlag::C;
+            }
+            return flags;
+        }();
+
+
+        constexpr X64Reg GetHostPair(uint8_t r8)
+        {
+            switch (r8 >> 1)
+            {
+            case 0:
+                return HOST_BC;
+            case 1:
+                return HOST_DE;
+            default:
+                return HOST_HL;
+            }
+        }
+
+        template <typename T>
+        const void* FunctionAddress(T function)
+        {
+            return reinterpret_cast<const void*>(function);
+        }
+    } // namespace
+
+    // page table layout, memory areas aren't standard layout but have no virtual base
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+    const CpuJit::MemoryLayout CpuJit::MEMORY_LAYOUT = {
+        .PageSize = sizeof(Memory::MemoryPage),
+        .PageReadData = offsetof(Memory::MemoryPage, ReadData),
+        .PageWriteData = offsetof(Memory::MemoryPage, WriteData),
+        .PageArea = offsetof(Memory::MemoryPage, Area),
+        .AreaReadFlag = offsetof(MemoryArea, m_ReadFlag),
+        .AreaWriteFlag = offsetof(MemoryArea, m_WriteFlag)
+    };
+#pragma GCC diagnostic pop
+
+    CpuJit::CpuJit(Cpu &cpu, const std::shared_ptr<Memory> &memory):
+        m_Cpu(cpu),
+        m_Memory(memory)
+    {
+        const CpuRegistersSet& regs = cpu.GetRegisters();
+        auto offset = [&regs](const void* field)
+        {
+            return static_cast<int32_t>(static_cast<const uint8_t*>(field) - reinterpret_cast<const uint8_t*>(&regs));
+        };
+
+        m_Layout.A = offset(&regs.m_AF.m_High);
+        m_Layout.F = offset(&regs.m_AF.m_Low);
+        m_Layout.B = offset(&regs.m_BC.m_High);
+        m_Layout.C = offset(&regs.m_BC.m_Low);
+        m_Layout.D = offset(&regs.m_DE.m_High);
+        m_Layout.E = offset(&regs.m_DE.m_Low);
+        m_Layout.H = offset(&regs.m_HL.m_High);
+        m_Layout.L = offset(&regs.m_HL.m_Low);
+        m_Layout.SP = offset(&regs.m_SP);
+        m_Layout.PC = offset(&regs.m_PC);
+    }
+
+    CpuJit::~CpuJit()
+    {
+#if GBE_JIT_SUPPORTED
+        if (m_Code)
+            munmap(m_Code, CODE_BUFFER_SIZE);
+#endif
+    }
+
+    bool CpuJit::IsSupported()
+    {
+        return GBE_JIT_SUPPORTED;
+    }
+
+    bool CpuJit::Compile(CpuBlock &block)
+    {
+#if GBE_JIT_SUPPORTED
+        if (!m_Code)
+        {
+            // never writable and executable at once, hardened kernels deny it
+            void* code = mmap(nullptr, CODE_BUFFER_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (code == MAP_FAILED)
+            {
+                m_IsAvailable = false;
+                return false;
+            }
+
+            m_Code = static_cast<uint8_t*>(code);
+        }
+
+        X64Emitter emitter{};
+        X64Emitter::Label top = emitter.NewLabel();
+        X64Emitter::Label exit = emitter.NewLabel();
+
+        // prologue, 6 pushes and the cycles slot keep the stack aligned for calls
+        emitter.Push(X64Reg::RBX);
+        emitter.Push(X64Reg::RBP);
+        emitter.Push(X64Reg::R12);
+        emitter.Push(X64Reg::R13);
+        emitter.Push(X64Reg::R14);
+        emitter.Push(X64Reg::R15);
+        emitter.Alu64(X64Alu::SUB, X64Reg::RSP, 8);
+        emitter.Mov64(HOST_REGS, &m_Cpu.GetRegisters());
+        _EmitLoadRegs(emitter);
+
+        emitter.Bind(top);
+        for (size_t i = 0; i < block.Ops.size(); i++)
+        {
+            const CpuBlockOp& op = block.Ops[i];
+            const uint16_t nextPC = op.PC + (op.OpcodeSize - 1) + op.Instr->GetSize();
+            const bool isLast = i + 1 == block.Ops.size();
+
+            if (isLast && _EmitJump(emitter, block, op, nextPC, top, exit))
+                break;
+
+            // the instruction cycles end up in esi
+            bool isWrite = false;
+            uint8_t cycles = _EmitOp(emitter, op, isWrite);
+            if (cycles > 0)
+            {
+                emitter.Store16(HOST_REGS, m_Layout.PC, nextPC);
+                emitter.Mov32(X64Reg::RSI, cycles);
+            }
+            else
+            {
+                // interpreter handler, it may write anything
+                _EmitStoreRegs(emitter);
+                emitter.Mov64(X64Reg::RDI, &m_Cpu);
+                emitter.Mov64(X64Reg::RSI, &op);
+                _EmitCall(emitter, FunctionAddress(&CpuJit::_RunOp));
+                _EmitLoadRegs(emitter);
+                emitter.Mov32(X64Reg::RSI, X64Reg::RAX);
+                isWrite = true;
+            }
+
+            // the block wrote to its own code, leave it
+            if (isWrite)
+            {
+                X64Emitter::Label isValid = emitter.NewLabel();
+                emitter.Mov64(X64Reg::RAX, &block.IsValid);
+                emitter.Cmp8(X64Reg::RAX, 0, 0);
+                emitter.JumpIf(X64Cond::NE, isValid);
+                emitter.Mov32(X64Reg::RAX, X64Reg::RSI);
+                emitter.Jump(exit);
+                emitter.Bind(isValid);
+            }
+
+            if (isLast)
+            {
+                emitter.Mov32(X64Reg::RAX, X64Reg::RSI);
+                emitter.Jump(exit);
+            }
+            else
+                _EmitStep(emitter, exit, false);
+        }
+
+        // epilogue, eax is the exit value
+        emitter.Bind(exit);
+        _EmitStoreRegs(emitter);
+        emitter.Alu64(X64Alu::ADD, X64Reg::RSP, 8);
+        emitter.Pop(X64Reg::R15);
+        emitter.Pop(X64Reg::R14);
+        emitter.Pop(X64Reg::R13);
+        emitter.Pop(X64Reg::R12);
+        emitter.Pop(X64Reg::RBP);
+        emitter.Pop(X64Reg::RBX);
+        emitter.Ret();
+
+        const std::vector<uint8_t>& code = emitter.GetCode();
+        if (m_CodeSize + code.size() > CODE_BUFFER_SIZE)
+            return false;
+
+        // writable only while copying the new block
+        if (mprotect(m_Code, CODE_BUFFER_SIZE, PROT_READ | PROT_WRITE) != 0)
+        {
+            m_IsAvailable = false;
+            return false;
+        }
+
+        std::memcpy(m_Code + m_CodeSize, code.data(), code.size());
+
+        if (mprotect(m_Code, CODE_BUFFER_SIZE, PROT_READ | PROT_EXEC) != 0)
+        {
+            m_IsAvailable = false;
+            return false;
+        }
+
+        block.Code = m_Code + m_CodeSize;
+
+        // keep blocks 16 bytes aligned
+        m_CodeSize = (m_CodeSize + code.size() + 15) & ~static_cast<size_t>(15);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    uint32_t CpuJit::Run(const CpuBlock &block)
+    {
+        GBE_ASSERT(block.Code);
+        BlockCode code = reinterpret_cast<BlockCode>(const_cast<void*>(block.Code));
+        return code();
+    }
+
+    void CpuJit::Clear()
+    {
+        m_CodeSize = 0;
+    }
+
+    void CpuJit::_EmitLoadRegs(X64Emitter &emitter) const
+    {
+        // eax is preserved (cycles of interpreted instructions)
+        emitter.Movzx8(HOST_A, HOST_REGS, m_Layout.A);
+        emitter.Movzx8(HOST_F, HOST_REGS, m_Layout.F);
+
+        auto loadPair = [&](X64Reg pair, int32_t high, int32_t low)
+        {
+            emitter.Movzx8(pair, HOST_REGS, high);
+            emitter.Shl32(pair, 8);
+            emitter.Movzx8(X64Reg::RCX, HOST_REGS, low);
+            emitter.Alu32(X64Alu::OR, pair, X64Reg::RCX);
+        };
+
+        loadPair(HOST_BC, m_Layout.B, m_Layout.C);
+        loadPair(HOST_DE, m_Layout.D, m_Layout.E);
+        loadPair(HOST_HL, m_Layout.H, m_Layout.L);
+    }
+
+    void CpuJit::_EmitStoreRegs(X64Emitter &emitter) const
+    {
+        // eax is preserved (exit value)
+        emitter.Store8(HOST_REGS, m_Layout.A, HOST_A);
+        emitter.Store8(HOST_REGS, m_Layout.F, HOST_F);
+
+        auto storePair = [&](X64Reg pair, int32_t high, int32_t low)
+        {
+            emitter.Store8(HOST_REGS, low, pair);
+            emitter.Mov32(X64Reg::RCX, pair);
+            emitter.Shr32(X64Reg::RCX, 8);
+            emitter.Store8(HOST_REGS, high, X64Reg::RCX);
+        };
+
+        storePair(HOST_BC, m_Layout.B, m_Layout.C);
+        storePair(HOST_DE, m_Layout.D, m_Layout.E);
+        storePair(HOST_HL, m_Layout.H, m_Layout.L);
+    }
+
+    void CpuJit::_EmitGetR8(X64Emitter &emitter, X64Reg dest, uint8_t r8) const
+    {
+        GBE_ASSERT(r8 != R8_ADR_HL);
+
+        if (r8 == R8_A)
+        {
+            emitter.Mov32(dest, HOST_A);
+            return;
+        }
+
+        X64Reg pair = GetHostPair(r8);
+        if (r8 & 1)
+        {
+            emitter.Movzx8(dest, pair);
+            return;
+        }
+
+        emitter.Mov32(dest, pair);
+        emitter.Shr32(dest, 8);
+    }
+
+    void CpuJit::_EmitSetR8(X64Emitter &emitter, uint8_t r8, X64Reg src) const
+    {
+        // src is zero extended and clobbered
+        GBE_ASSERT(r8 != R8_ADR_HL);
+
+        if (r8 == R8_A)
+        {
+            emitter.Mov32(HOST_A, src);
+            return;
+        }
+
+        X64Reg pair = GetHostPair(r8);
+        if (r8 & 1)
+        {
+            emitter.Alu32(X64Alu::AND, pair, 0xFF00);
+            emitter.Alu32(X64Alu::OR, pair, src);
+            return;
+        }
+
+        emitter.Shl32(src, 8);
+        emitter.Alu32(X64Alu::AND, pair, 0xFF);
+        emitter.Alu32(X64Alu::OR, pair, src);
+    }
+
+    void CpuJit::_EmitRead(X64Emitter &emitter) const
+    {
+        // address in esi, value in eax
+        X64Emitter::Label slow = emitter.NewLabel();
+        X64Emitter::Label done = emitter.NewLabel();
+
+        // same fast path as Memory::Get
+        emitter.Mov32(X64Reg::RAX, X64Reg::RSI);
+        emitter.Shr32(X64Reg::RAX, 8);
+        emitter.Imul64(X64Reg::RAX, X64Reg::RAX, MEMORY_LAYOUT.PageSize);
+        emitter.Mov64(X64Reg::RCX, m_Memory->m_Pages.data());
+        emitter.Alu64(X64Alu::ADD, X64Reg::RCX, X64Reg::RAX);
+        emitter.Load64(X64Reg::RDX, X64Reg::RCX, MEMORY_LAYOUT.PageReadData);
+        emitter.Alu64(X64Alu::CMP, X64Reg::RDX, 0);
+        emitter.JumpIf(X64Cond::E, slow);
+        emitter.Load64(X64Reg::RAX, X64Reg::RCX, MEMORY_LAYOUT.PageArea);
+        emitter.Cmp8(X64Reg::RAX, MEMORY_LAYOUT.AreaReadFlag, 0);
+        emitter.JumpIf(X64Cond::E, slow);
+        emitter.Movzx8(X64Reg::RCX, X64Reg::RSI);
+        emitter.Movzx8(X64Reg::RAX, X64Reg::RDX, X64Reg::RCX);
+        emitter.Jump(done);
+
+        emitter.Bind(slow);
+        emitter.Mov64(X64Reg::RDI, m_Memory.get());
+        _EmitCall(emitter, FunctionAddress(&CpuJit::_Read));
+        emitter.Movzx8(X64Reg::RAX, X64Reg::RAX);
+
+        emitter.Bind(done);
+    }
+
+    void CpuJit::_EmitWrite(X64Emitter &emitter) const
+    {
+        // address in esi, value in edx
+        X64Emitter::Label slow = emitter.NewLabel();
+        X64Emitter::Label done = emitter.NewLabel();
+
+        // same fast path as Memory::Set, watched pages go through the watcher
+        emitter.Mov32(X64Reg::RAX, X64Reg::RSI);
+        emitter.Shr32(X64Reg::RAX, 8);
+        emitter.Mov64(X64Reg::RCX, m_Memory->m_WatchedPages.data());
+        emitter.Cmp8(X64Reg::RCX, X64Reg::RAX, 0);
+        emitter.JumpIf(X64Cond::NE, slow);
+        emitter.Imul64(X64Reg::RAX, X64Reg::RAX, MEMORY_LAYOUT.PageSize);
+        emitter.Mov64(X64Reg::RCX, m_Memory->m_Pages.data());
+        emitter.Alu64(X64Alu::ADD, X64Reg::RCX, X64Reg::RAX);
+        emitter.Load64(X64Reg::R8, X64Reg::RCX, MEMORY_LAYOUT.PageWriteData);
+        emitter.Alu64(X64Alu::CMP, X64Reg::R8, 0);
+        emitter.JumpIf(X64Cond::E, slow);
+        emitter.Load64(X64Reg::RAX, X64Reg::RCX, MEMORY_LAYOUT.PageArea);
+        emitter.Cmp8(X64Reg::RAX, MEMORY_LAYOUT.AreaWriteFlag, 0);
+        emitter.JumpIf(X64Cond::E, slow);
+        emitter.Movzx8(X64Reg::RCX, X64Reg::RSI);
+        emitter.Store8(X64Reg::R8, X64Reg::RCX, X64Reg::RDX);
+        emitter.Jump(done);
+
+        emitter.Bind(slow);
+        emitter.Mov64(X64Reg::RDI, m_Memory.get());
+        _EmitCall(emitter, FunctionAddress(&CpuJit::_Write));
+
+        emitter.Bind(done);
+    }
+
+    void CpuJit::_EmitFlags(X64Emitter &emitter, uint8_t mask, uint8_t set, uint8_t keep) const
+    {
+        // after lahf: result in al, host flags in ah
+        emitter.MovzxAH(X64Reg::RCX);
+        emitter.Movzx8(X64Reg::RAX, X64Reg::RAX);
+        emitter.Mov64(X64Reg::RDX, LAHF_FLAGS.data());
+        emitter.Movzx8(X64Reg::RCX, X64Reg::RDX, X64Reg::RCX);
+        emitter.Alu32(X64Alu::AND, X64Reg::RCX, mask);
+
+        if (set)
+            emitter.Alu32(X64Alu::OR, X64Reg::RCX, set);
+
+        if (!keep)
+        {
+            emitter.Mov32(HOST_F, X64Reg::RCX);
+            return;
+        }
+
+        emitter.Alu32(X64Alu::AND, HOST_F, keep);
+        emitter.Alu32(X64Alu::OR, HOST_F, X64Reg::RCX);
+    }
+
+    void CpuJit::_EmitCall(X64Emitter &emitter, const void *function) const
+    {
+        emitter.Mov64(X64Reg::RAX, function);
+        emitter.Call(X64Reg::RAX);
+    }
+
+    void CpuJit::_EmitStep(X64Emitter &emitter, X64Emitter::Label exit, bool isLoop) const
+    {
+        // cycles in esi, leave the block if the step returns an exit value
+        emitter.Mov64(X64Reg::RDI, &m_Cpu);
+        emitter.Mov32(X64Reg::RDX, static_cast<uint32_t>(isLoop));
+        _EmitCall(emitter, FunctionAddress(&CpuJit::_Step));
+        emitter.Alu32(X64Alu::CMP, X64Reg::RAX, 0);
+        emitter.JumpIf(X64Cond::NE, exit);
+    }
+
+    uint8_t CpuJit::_EmitOp(X64Emitter &emitter, const CpuBlockOp &op, bool& isWrite)
+    {
+        // $CB opcodes always go through the interpreter
+        if (op.OpcodeSize != 1)
+            return 0;
+
+        const uint8_t opcode = op.Instr->GetOpcode();
+        auto imm8 = [&]() -> uint8_t
+        {
+            return m_Memory->Get(op.PC + 1);
+        };
+        auto imm16 = [&]() -> uint16_t
+        {
+            return m_Memory->Get16(op.PC + 1);
+        };
+
+        // address of [r16mem] in esi
+        auto r16MemAddress = [&](uint8_t r16mem)
+        {
+            if (r16mem == 0)
+                emitter.Mov32(X64Reg::RSI, HOST_BC);
+            else if (r16mem == 1)
+                emitter.Mov32(X64Reg::RSI, HOST_DE);
+            else
+                emitter.Mov32(X64Reg::RSI, HOST_HL);
+        };
+        auto r16MemIncDec = [&](uint8_t r16mem)
+        {
+            if (r16mem < 2)
+                return;
+
+            emitter.Alu32((r16mem == 2) ? X64Alu::ADD : X64Alu::SUB, HOST_HL, 1);
+            emitter.Alu32(X64Alu::AND, HOST_HL, 0xFFFF);
+        };
+
+        // ld r8 / alu a, r8 operand in ecx
+        auto aluA = [&](uint8_t aluOp)
+        {
+            emitter.Mov32(X64Reg::RAX, HOST_A);
+
+            switch (aluOp)
+            {
+            // add, adc
+            case 0:
+            case 1:
+                if (aluOp == 1)
+                    emitter.Bt32(HOST_F, 4);
+                emitter.Alu8((aluOp == 1) ? X64Alu::ADC : X64Alu::ADD, X64Reg::RAX, X64Reg::RCX);
+                emitter.Lahf();
+                _EmitFlags(emitter, CpuFlag::Z | CpuFlag::H | CpuFlag::C, 0, 0);
+                break;
+            // sub, sbc, cp
+            case 2:
+            case 3:
+            case 7:
+                if (aluOp == 3)
+                    emitter.Bt32(HOST_F, 4);
+                emitter.Alu8((aluOp == 3) ? X64Alu::SBB : X64Alu::SUB, X64Reg::RAX, X64Reg::RCX);
+                emitter.Lahf();
+                _EmitFlags(emitter, CpuFlag::Z | CpuFlag::H | CpuFlag::C, CpuFlag::N, 0);
+                break;
+            // and
+            case 4:
+                emitter.Alu8(X64Alu::AND, X64Reg::RAX, X64Reg::RCX);
+                emitter.Lahf();
+                _EmitFlags(emitter, CpuFlag::Z, CpuFlag::H, 0);
+                break;
+            // xor, or
+            default:
+                emitter.Alu8((aluOp == 5) ? X64Alu::XOR : X64Alu::OR, X64Reg::RAX, X64Reg::RCX);
+                emitter.Lahf();
+                _EmitFlags(emitter, CpuFlag::Z, 0, 0);
+                break;
+            }
+
+            if (aluOp != 7)
+                emitter.Mov32(HOST_A, X64Reg::RAX);
+        };
+
+        // nop
+        if (opcode == 0x00)
+            return 1;
+
+        // ld r16, imm16
+        if ((opcode & 0xCF) == 0x01)
+        {
+            uint8_t r16 = (opcode >> 4) & 3;
+            if (r16 == 3)
+                emitter.Store16(HOST_REGS, m_Layout.SP, imm16());
+            else
+                emitter.Mov32(GetHostPair(r16 << 1), imm16());
+            return 3;
+        }
+
+        // ld [r16mem], a
+        if ((opcode & 0xCF) == 0x02)
+        {
+            uint8_t r16mem = (opcode >> 4) & 3;
+            r16MemAddress(r16mem);
+            emitter.Mov32(X64Reg::RDX, HOST_A);
+            _EmitWrite(emitter);
+            r16MemIncDec(r16mem);
+            isWrite = true;
+            return 2;
+        }
+
+        // ld a, [r16mem]
+        if ((opcode & 0xCF) == 0x0A)
+        {
+            uint8_t r16mem = (opcode >> 4) & 3;
+            r16MemAddress(r16mem);
+            _EmitRead(emitter);
+            emitter.Mov32(HOST_A, X64Reg::RAX);
+            r16MemIncDec(r16mem);
+            return 2;
+        }
+
+        // inc r16, dec r16
+        if ((opcode & 0xC7) == 0x03)
+        {
+            uint8_t r16 = (opcode >> 4) & 3;
+            X64Alu aluOp = (opcode & 0x08) ? X64Alu::SUB : X64Alu::ADD;
+
+            if (r16 == 3)
+            {
+                emitter.Movzx16(X64Reg::RAX, HOST_REGS, m_Layout.SP);
+                emitter.Alu32(aluOp, X64Reg::RAX, 1);
+                emitter.Store16(HOST_REGS, m_Layout.SP, X64Reg::RAX);
+                return 2;
+            }
+
+            X64Reg pair = GetHostPair(r16 << 1);
+            emitter.Alu32(aluOp, pair, 1);
+            emitter.Alu32(X64Alu::AND, pair, 0xFFFF);
+            return 2;
+        }
+
+        // inc r8, dec r8
+        if ((opcode & 0xC6) == 0x04)
+        {
+            uint8_t r8 = (opcode >> 3) & 7;
+            bool isInc = (opcode & 1) == 0;
+
+            if (r8 == R8_ADR_HL)
+            {
+                emitter.Mov32(X64Reg::RSI, HOST_HL);
+                _EmitRead(emitter);
+            }
+            else
+                _EmitGetR8(emitter, X64Reg::RAX, r8);
+
+            if (isInc)
+                emitter.Inc8(X64Reg::RAX);
+            else
+                emitter.Dec8(X64Reg::RAX);
+            emitter.Lahf();
+            _EmitFlags(emitter, CpuFlag::Z | CpuFlag::H, isInc ? 0 : CpuFlag::N, CpuFlag::C);
+
+            if (r8 != R8_ADR_HL)
+            {
+                _EmitSetR8(emitter, r8, X64Reg::RAX);
+                return 1;
+            }
+
+            emitter.Mov32(X64Reg::RDX, X64Reg::RAX);
+            emitter.Mov32(X64Reg::RSI, HOST_HL);
+            _EmitWrite(emitter);
+            isWrite = true;
+            return 3;
+        }
+
+        // ld r8, imm8
+        if ((opcode & 0xC7) == 0x06)
+        {
+            uint8_t r8 = (opcode >> 3) & 7;
+            if (r8 == R8_ADR_HL)
+            {
+                emitter.Mov32(X64Reg::RDX, imm8());
+                emitter.Mov32(X64Reg::RSI, HOST_HL);
+                _EmitWrite(emitter);
+                isWrite = true;
+                return 3;
+            }
+
+            emitter.Mov32(X64Reg::RAX, imm8());
+            _EmitSetR8(emitter, r8, X64Reg::RAX);
+            return 2;
+        }
+
+        // cpl
+        if (opcode == 0x2F)
+        {
+            emitter.Alu32(X64Alu::XOR, HOST_A, 0xFF);
+            emitter.Alu32(X64Alu::OR, HOST_F, CpuFlag::N | CpuFlag::H);
+            return 1;
+        }
+
+        // scf
+        if (opcode == 0x37)
+        {
+            emitter.Alu32(X64Alu::AND, HOST_F, CpuFlag::Z);
+            emitter.Alu32(X64Alu::OR, HOST_F, CpuFlag::C);
+            return 1;
+        }
+
+        // ccf
+        if (opcode == 0x3F)
+        {
+            emitter.Alu32(X64Alu::AND, HOST_F, CpuFlag::Z | CpuFlag::C);
+            emitter.Alu32(X64Alu::XOR, HOST_F, CpuFlag::C);
+            return 1;
+        }
+
+        // ld r8, r8 (halt excluded)
+        if (opcode >= 0x40 && opcode < 0x80 && opcode != 0x76)
+        {
+            uint8_t dest = (opcode >> 3) & 7;
+            uint8_t src = opcode & 7;
+
+            if (src == R8_ADR_HL)
+            {
+                emitter.Mov32(X64Reg::RSI, HOST_HL);
+                _EmitRead(emitter);
+                _EmitSetR8(emitter, dest, X64Reg::RAX);
+                return 2;
+            }
+
+            if (dest == R8_ADR_HL)
+            {
+                _EmitGetR8(emitter, X64Reg::RDX, src);
+                emitter.Mov32(X64Reg::RSI, HOST_HL);
+                _EmitWrite(emitter);
+                isWrite = true;
+                return 2;
+            }
+
+            if (dest != src)
+            {
+                _EmitGetR8(emitter, X64Reg::RAX, src);
+                _EmitSetR8(emitter, dest, X64Reg::RAX);
+            }
+            return 1;
+        }
+
+        // alu a, r8
+        if (opcode >= 0x80 && opcode < 0xC0)
+        {
+            uint8_t src = opcode & 7;
+            if (src == R8_ADR_HL)
+            {
+                emitter.Mov32(X64Reg::RSI, HOST_HL);
+                _EmitRead(emitter);
+                emitter.Mov32(X64Reg::RCX, X64Reg::RAX);
+            }
+            else
+                _EmitGetR8(emitter, X64Reg::RCX, src);
+
+            aluA((opcode >> 3) & 7);
+            return (src == R8_ADR_HL) ? 2 : 1;
+        }
+
+        // alu a, imm8
+        if ((opcode & 0xC7) == 0xC6)
+        {
+            emitter.Mov32(X64Reg::RCX, imm8());
+            aluA((opcode >> 3) & 7);
+            return 2;
+        }
+
+        switch (opcode)
+        {
+        // ldh [imm8], a
+        case 0xE0:
+            emitter.Mov32(X64Reg::RSI, 0xFF00 + imm8());
+            emitter.Mov32(X64Reg::RDX, HOST_A);
+            _EmitWrite(emitter);
+            isWrite = true;
+            return 3;
+        // ldh a, [imm8]
+        case 0xF0:
+            emitter.Mov32(X64Reg::RSI, 0xFF00 + imm8());
+            _EmitRead(emitter);
+            emitter.Mov32(HOST_A, X64Reg::RAX);
+            return 3;
+        // ldh [c], a
+        case 0xE2:
+            emitter.Movzx8(X64Reg::RSI, HOST_BC);
+            emitter.Alu32(X64Alu::OR, X64Reg::RSI, 0xFF00);
+            emitter.Mov32(X64Reg::RDX, HOST_A);
+            _EmitWrite(emitter);
+            isWrite = true;
+            return 2;
+        // ldh a, [c]
+        case 0xF2:
+            emitter.Movzx8(X64Reg::RSI, HOST_BC);
+            emitter.Alu32(X64Alu::OR, X64Reg::RSI, 0xFF00);
+            _EmitRead(emitter);
+            emitter.Mov32(HOST_A, X64Reg::RAX);
+            return 2;
+        // ld [imm16], a
+        case 0xEA:
+            emitter.Mov32(X64Reg::RSI, imm16());
+            emitter.Mov32(X64Reg::RDX, HOST_A);
+            _EmitWrite(emitter);
+            isWrite = true;
+            return 4;
+        // ld a, [imm16]
+        case 0xFA:
+            emitter.Mov32(X64Reg::RSI, imm16());
+            _EmitRead(emitter);
+            emitter.Mov32(HOST_A, X64Reg::RAX);
+            return 4;
+        default:
+            return 0;
+        }
+    }
+
+    bool CpuJit::_EmitJump(X64Emitter &emitter, const CpuBlock &block, const CpuBlockOp &op, uint16_t nextPC, X64Emitter::Label top, X64Emitter::Label exit)
+    {
+        if (op.OpcodeSize != 1)
+            return false;
+
+        const uint8_t opcode = op.Instr->GetOpcode();
+
+        // jp hl
+        if (opcode == 0xE9)
+        {
+            emitter.Store16(HOST_REGS, m_Layout.PC, HOST_HL);
+            emitter.Mov32(X64Reg::RAX, 1);
+            emitter.Jump(exit);
+            return true;
+        }
+
+        // jr e, jr cc e, jp imm16, jp cc imm16
+        const bool isRelative = opcode == 0x18 || (opcode & 0xE7) == 0x20;
+        const bool isAbsolute = opcode == 0xC3 || (opcode & 0xE7) == 0xC2;
+        if (!isRelative && !isAbsolute)
+            return false;
+
+        const bool hasCond = opcode != 0x18 && opcode != 0xC3;
+        const uint8_t cond = (opcode >> 3) & 3;
+
+        uint16_t target = 0;
+        uint8_t takenCycles = 0;
+        if (isRelative)
+        {
+            int8_t offset = static_cast<int8_t>(m_Memory->Get(op.PC + 1));
+            target = nextPC + offset;
+            takenCycles = 3;
+        }
+        else
+        {
+            target = m_Memory->Get16(op.PC + 1);
+            takenCycles = 4;
+        }
+
+        // nz, z test Z and nc, c test C
+        X64Emitter::Label notTaken = emitter.NewLabel();
+        if (hasCond)
+        {
+            emitter.Test32(HOST_F, (cond < 2) ? CpuFlag::Z : CpuFlag::C);
+            emitter.JumpIf((cond & 1) ? X64Cond::E : X64Cond::NE, notTaken);
+        }
+
+        emitter.Store16(HOST_REGS, m_Layout.PC, target);
+        emitter.Mov32(X64Reg::RSI, takenCycles);
+
+        // loops stay in native code, idle loops leave to be skipped by the cpu
+        if (target == block.Start && !block.IsIdleLoop)
+        {
+            _EmitStep(emitter, exit, true);
+            emitter.Jump(top);
+        }
+        else
+        {
+            emitter.Mov32(X64Reg::RAX, X64Reg::RSI);
+            emitter.Jump(exit);
+        }
+
+        if (hasCond)
+        {
+            emitter.Bind(notTaken);
+            emitter.Store16(HOST_REGS, m_Layout.PC, nextPC);
+            emitter.Mov32(X64Reg::RAX, takenCycles - 1);
+            emitter.Jump(exit);
+        }
+
+        return true;
+    }
+
+    uint8_t CpuJit::_Read(Memory *memory, uint32_t address)
+    {
+        return memory->Get(address);
+    }
+
+    void CpuJit::_Write(Memory *memory, uint32_t address, uint32_t value)
+    {
+        memory->Set(address, value);
+    }
+
+    uint32_t CpuJit::_Step(Cpu *cpu, uint32_t cycles, uint32_t isLoop)
+    {
+        return cpu->_BlockStep(cycles, isLoop);
+    }
+
+    uint32_t CpuJit::_RunOp(Cpu *cpu, const CpuBlockOp *op)
+    {
+        return cpu->_RunBlockOp(*op);
+    }
+} // namespace GBE
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+#include "X64Emitter.h"
+
+#include "util/Class.h"
+
+namespace GBE
+{
+    class Cpu;
+    class Memory;
+    struct CpuBlock;
+    struct CpuBlockOp;
+
+    // compiles hot cpu blocks to x86-64 code
+    // inside a block the guest registers live in host registers and memory goes through an inline page lookup,
+    // everything else (io handlers, stack, $CB opcodes ...) calls the interpreter handler
+    // the hardware is stepped between instructions so timing is the same as the interpreter
+    class CpuJit
+    {
+    public:
+        GBE_CLASS_NO_COPY_NO_MOVE(CpuJit)
+
+        // returned by a block stopped on an interrupt, all its instructions were stepped
+        static constexpr uint32_t EXIT_INTERRUPT = 0x100;
+        // times a block is run by the interpreter before being compiled
+        static constexpr uint32_t HOT_BLOCK_RUNS = 4;
+        static constexpr size_t CODE_BUFFER_SIZE = 4 * 1024 * 1024;
+
+        CpuJit(Cpu& cpu, const std::shared_ptr<Memory>& memory);
+        ~CpuJit();
+
+        // native code can run on this host (x86-64 linux)
+        static bool IsSupported();
+
+        // supported and the code buffer could be allocated
+        inline bool IsAvailable() const
+        {
+            return m_IsAvailable;
+        }
+
+        // compile block to native code, false if the code buffer is full
+        bool Compile(CpuBlock& block);
+
+        // run compiled block
+        // returns the cycles of the last instruction, not stepped yet, or EXIT_INTERRUPT
+        uint32_t Run(const CpuBlock& block);
+
+        // drop all the compiled code, blocks pointing to it must be cleared too
+        void Clear();
+
+        inline size_t GetCodeSize() const
+        {
+            return m_CodeSize;
+        }
+
+    private:
+        using BlockCode = uint32_t (*)();
+
+        Cpu& m_Cpu;
+        std::shared_ptr<Memory> m_Memory = nullptr;
+
+        // executable memory, allocated on first compile, read-execute except while a block is copied
+        uint8_t* m_Code = nullptr;
+        size_t m_CodeSize = 0;
+        bool m_IsAvailable = IsSupported();
+
+        // offsets of the guest registers from the registers set
+        struct RegsLayout
+        {
+            int32_t A, F, B, C, D, E, H, L, SP, PC;
+        };
+        RegsLayout m_Layout{};
+
+        // offsets in the memory page table
+        struct MemoryLayout
+        {
+            int32_t PageSize, PageReadData, PageWriteData, PageArea, AreaReadFlag, AreaWriteFlag;
+        };
+        static const MemoryLayout MEMORY_LAYOUT;
+
+        // emit helpers, see CpuJit.cpp for the host registers mapping
+        void _EmitLoadRegs(X64Emitter& emitter) const;
+        void _EmitStoreRegs(X64Emitter& emitter) const;
+        void _EmitGetR8(X64Emitter& emitter, X64Reg dest, uint8_t r8) const;
+        void _EmitSetR8(X64Emitter& emitter, uint8_t r8, X64Reg src) const;
+        void _EmitRead(X64Emitter& emitter) const;
+        void _EmitWrite(X64Emitter& emitter) const;
+        // flags of the lahf in ah masked with mask, or set, F bits in keep are preserved
+        void _EmitFlags(X64Emitter& emitter, uint8_t mask, uint8_t set, uint8_t keep) const;
+        void _EmitCall(X64Emitter& emitter, const void* function) const;
+        void _EmitStep(X64Emitter& emitter, X64Emitter::Label exit, bool isLoop) const;
+
+        // native version of op, returns its cycles or 0 if it must run in the interpreter
+        // isWrite is set if the op writes to memory
+        uint8_t _EmitOp(X64Emitter& emitter, const CpuBlockOp& op, bool& isWrite);
+        // jr / jp ending the block, false if not a native jump
+        bool _EmitJump(X64Emitter& emitter, const CpuBlock& block, const CpuBlockOp& op, uint16_t nextPC, X64Emitter::Label top, X64Emitter::Label exit);
+
+        // called from native code
+        static uint8_t _Read(Memory* memory, uint32_t address);
+        static void _Write(Memory* memory, uint32_t address, uint32_t value);
+        static uint32_t _Step(Cpu* cpu, uint32_t cycles, uint32_t isLoop);
+        static uint32_t _RunOp(Cpu* cpu, const CpuBlockOp* op);
+    };
+} // namespace GBE
@@ -0,0 +1,346 @@
+#include "X64Emitter.h"
+
+#include "util/Assert.h"
+
+namespace GBE
+{
+    namespace
+    {
+        constexpr uint8_t RegIndex(X64Reg reg)
+        {
+            return static_cast<uint8_t>(reg);
+        }
+
+        constexpr bool IsInt8(int32_t value)
+        {
+            return value >= INT8_MIN && value <= INT8_MAX;
+        }
+    } // namespace
+
+    X64Emitter::Label X64Emitter::NewLabel()
+    {
+        m_Labels.emplace_back();
+        return m_Labels.size() - 1;
+    }
+
+    void X64Emitter::Bind(Label label)
+    {
+        LabelInfo& info = m_Labels[label];
+        GBE_ASSERT(info.Position < 0);
+        info.Position = m_Code.size();
+
+        for (size_t patch: info.Patches)
+        {
+            int32_t rel = static_cast<int32_t>(info.Position - static_cast<int64_t>(patch + 4));
+            for (size_t i = 0; i < 4; i++)
+                m_Code[patch + i] = (rel >> (i * 8)) & 0xFF;
+        }
+        info.Patches.clear();
+    }
+
+    void X64Emitter::Jump(Label label)
+    {
+        _Emit8(0xE9);
+        _EmitRel32(label);
+    }
+
+    void X64Emitter::JumpIf(X64Cond cond, Label label)
+    {
+        _Emit8(0x0F);
+        _Emit8(0x80 + static_cast<uint8_t>(cond));
+        _EmitRel32(label);
+    }
+
+    void X64Emitter::Push(X64Reg reg)
+    {
+        _EmitRex(false, 0, 0, RegIndex(reg), false);
+        _Emit8(0x50 + (RegIndex(reg) & 7));
+    }
+
+    void X64Emitter::Pop(X64Reg reg)
+    {
+        _EmitRex(false, 0, 0, RegIndex(reg), false);
+        _Emit8(0x58 + (RegIndex(reg) & 7));
+    }
+
+    void X64Emitter::Call(X64Reg reg)
+    {
+        _EmitRegReg({0xFF}, 2, reg, false, false);
+    }
+
+    void X64Emitter::Ret()
+    {
+        _Emit8(0xC3);
+    }
+
+    void X64Emitter::Mov32(X64Reg dest, X64Reg src)
+    {
+        _EmitRegReg({0x89}, RegIndex(src), dest, false, false);
+    }
+
+    void X64Emitter::Mov32(X64Reg dest, uint32_t imm)
+    {
+        _EmitRex(false, 0, 0, RegIndex(dest), false);
+        _Emit8(0xB8 + (RegIndex(dest) & 7));
+        _Emit32(imm);
+    }
+
+    void X64Emitter::Mov64(X64Reg dest, uint64_t imm)
+    {
+        _EmitRex(true, 0, 0, RegIndex(dest), false);
+        _Emit8(0xB8 + (RegIndex(dest) & 7));
+        _Emit64(imm);
+    }
+
+    void X64Emitter::Mov64(X64Reg dest, const void *pointer)
+    {
+        Mov64(dest, reinterpret_cast<uint64_t>(pointer));
+    }
+
+    void X64Emitter::Load64(X64Reg dest, X64Reg base, int32_t disp)
+    {
+        _EmitRegMem({0x8B}, RegIndex(dest), base, disp, true, false);
+    }
+
+    void X64Emitter::Movzx8(X64Reg dest, X64Reg src)
+    {
+        _EmitRegReg({0x0F, 0xB6}, RegIndex(dest), src, false, true);
+    }
+
+    void X64Emitter::Movzx8(X64Reg dest, X64Reg base, int32_t disp)
+    {
+        _EmitRegMem({0x0F, 0xB6}, RegIndex(dest), base, disp, false, false);
+    }
+
+    void X64Emitter::Movzx8(X64Reg dest, X64Reg base, X64Reg index)
+    {
+        _EmitRegMemIndex({0x0F, 0xB6}, RegIndex(dest), base, index, false, false);
+    }
+
+    void X64Emitter::Movzx16(X64Reg dest, X64Reg base, int32_t disp)
+    {
+        _EmitRegMem({0x0F, 0xB7}, RegIndex(dest), base, disp, false, false);
+    }
+
+    void X64Emitter::MovzxAH(X64Reg dest)
+    {
+        // ah is only encodable without rex
+        GBE_ASSERT(RegIndex(dest) < 8);
+        _Emit8(0x0F);
+        _Emit8(0xB6);
+        _Emit8(0xC0 | (RegIndex(dest) << 3) | 4);
+    }
+
+    void X64Emitter::Store8(X64Reg base, int32_t disp, X64Reg src)
+    {
+        _EmitRegMem({0x88}, RegIndex(src), base, disp, false, true);
+    }
+
+    void X64Emitter::Store8(X64Reg base, X64Reg index, X64Reg src)
+    {
+        _EmitRegMemIndex({0x88}, RegIndex(src), base, index, false, true);
+    }
+
+    void X64Emitter::Store16(X64Reg base, int32_t disp, X64Reg src)
+    {
+        _Emit8(0x66);
+        _EmitRegMem({0x89}, RegIndex(src), base, disp, false, false);
+    }
+
+    void X64Emitter::Store16(X64Reg base, int32_t disp, uint16_t imm)
+    {
+        _Emit8(0x66);
+        _EmitRegMem({0xC7}, 0, base, disp, false, false);
+        _Emit16(imm);
+    }
+
+    void X64Emitter::Alu8(X64Alu op, X64Reg dest, X64Reg src)
+    {
+        uint8_t opcode = static_cast<uint8_t>(op) * 8;
+        _EmitRegReg({opcode}, RegIndex(src), dest, false, true);
+    }
+
+    void X64Emitter::Alu32(X64Alu op, X64Reg dest, X64Reg src)
+    {
+        uint8_t opcode = static_cast<uint8_t>(op) * 8 + 1;
+        _EmitRegReg({opcode}, RegIndex(src), dest, false, false);
+    }
+
+    void X64Emitter::Alu32(X64Alu op, X64Reg dest, int32_t imm)
+    {
+        if (IsInt8(imm))
+        {
+            _EmitRegReg({0x83}, static_cast<uint8_t>(op), dest, false, false);
+            _Emit8(static_cast<uint8_t>(imm));
+            return;
+        }
+
+        _EmitRegReg({0x81}, static_cast<uint8_t>(op), dest, false, false);
+        _Emit32(static_cast<uint32_t>(imm));
+    }
+
+    void X64Emitter::Alu64(X64Alu op, X64Reg dest, X64Reg src)
+    {
+        uint8_t opcode = static_cast<uint8_t>(op) * 8 + 1;
+        _EmitRegReg({opcode}, RegIndex(src), dest, true, false);
+    }
+
+    void X64Emitter::Alu64(X64Alu op, X64Reg dest, int32_t imm)
+    {
+        if (IsInt8(imm))
+        {
+            _EmitRegReg({0x83}, static_cast<uint8_t>(op), dest, true, false);
+            _Emit8(static_cast<uint8_t>(imm));
+            return;
+        }
+
+        _EmitRegReg({0x81}, static_cast<uint8_t>(op), dest, true, false);
+        _Emit32(static_cast<uint32_t>(imm));
+    }
+
+    void X64Emitter::Cmp8(X64Reg base, int32_t disp, uint8_t imm)
+    {
+        _EmitRegMem({0x80}, static_cast<uint8_t>(X64Alu::CMP), base, disp, false, false);
+        _Emit8(imm);
+    }
+
+    void X64Emitter::Cmp8(X64Reg base, X64Reg index, uint8_t imm)
+    {
+        _EmitRegMemIndex({0x80}, static_cast<uint8_t>(X64Alu::CMP), base, index, false, false);
+        _Emit8(imm);
+    }
+
+    void X64Emitter::Inc8(X64Reg reg)
+    {
+        _EmitRegReg({0xFE}, 0, reg, false, true);
+    }
+
+    void X64Emitter::Dec8(X64Reg reg)
+    {
+        _EmitRegReg({0xFE}, 1, reg, false, true);
+    }
+
+    void X64Emitter::Shl32(X64Reg reg, uint8_t count)
+    {
+        _EmitRegReg({0xC1}, 4, reg, false, false);
+        _Emit8(count);
+    }
+
+    void X64Emitter::Shr32(X64Reg reg, uint8_t count)
+    {
+        _EmitRegReg({0xC1}, 5, reg, false, false);
+        _Emit8(count);
+    }
+
+    void X64Emitter::Imul64(X64Reg dest, X64Reg src, int32_t imm)
+    {
+        _EmitRegReg({0x69}, RegIndex(dest), src, true, false);
+        _Emit32(static_cast<uint32_t>(imm));
+    }
+
+    void X64Emitter::Test32(X64Reg reg, uint32_t imm)
+    {
+        _EmitRegReg({0xF7}, 0, reg, false, false);
+        _Emit32(imm);
+    }
+
+    void X64Emitter::Bt32(X64Reg reg, uint8_t bit)
+    {
+        _EmitRegReg({0x0F, 0xBA}, 4, reg, false, false);
+        _Emit8(bit);
+    }
+
+    void X64Emitter::Lahf()
+    {
+        _Emit8(0x9F);
+    }
+
+    void X64Emitter::_Emit8(uint8_t byte)
+    {
+        m_Code.push_back(byte);
+    }
+
+    void X64Emitter::_Emit16(uint16_t value)
+    {
+        _Emit8(value & 0xFF);
+        _Emit8(value >> 8);
+    }
+
+    void X64Emitter::_Emit32(uint32_t value)
+    {
+        for (size_t i = 0; i < 4; i++)
+            _Emit8((value >> (i * 8)) & 0xFF);
+    }
+
+    void X64Emitter::_Emit64(uint64_t value)
+    {
+        for (size_t i = 0; i < 8; i++)
+            _Emit8((value >> (i * 8)) & 0xFF);
+    }
+
+    void X64Emitter::_EmitRel32(Label label)
+    {
+        const LabelInfo& info = m_Labels[label];
+        if (info.Position >= 0)
+        {
+            int32_t rel = static_cast<int32_t>(info.Position - static_cast<int64_t>(m_Code.size() + 4));
+            _Emit32(static_cast<uint32_t>(rel));
+            return;
+        }
+
+        m_Labels[label].Patches.push_back(m_Code.size());
+        _Emit32(0);
+    }
+
+    void X64Emitter::_EmitRex(bool w, uint8_t reg, uint8_t index, uint8_t base, bool isByteReg)
+    {
+        uint8_t rex = 0x40 | (w << 3) | ((reg >> 3) << 2) | ((index >> 3) << 1) | (base >> 3);
+        if (rex != 0x40 || isByteReg)
+            _Emit8(rex);
+    }
+
+    void X64Emitter::_EmitRegReg(std::initializer_list<uint8_t> opcode, uint8_t reg, X64Reg rm, bool w, bool isByte)
+    {
+        uint8_t rmIndex = RegIndex(rm);
+        bool isByteReg = isByte && ((reg >= 4 && reg < 8) || (rmIndex >= 4 && rmIndex < 8));
+
+        _EmitRex(w, reg, 0, rmIndex, isByteReg);
+        for (uint8_t byte: opcode)
+            _Emit8(byte);
+        _Emit8(0xC0 | ((reg & 7) << 3) | (rmIndex & 7));
+    }
+
+    void X64Emitter::_EmitRegMem(std::initializer_list<uint8_t> opcode, uint8_t reg, X64Reg base, int32_t disp, bool w, bool isByte)
+    {
+        uint8_t baseIndex = RegIndex(base);
+        bool isByteReg = isByte && reg >= 4 && reg < 8;
+
+        _EmitRex(w, reg, 0, baseIndex, isByteReg);
+        for (uint8_t byte: opcode)
+            _Emit8(byte);
+
+        // [base + disp32], rsp / r12 need a sib byte
+        _Emit8(0x80 | ((reg & 7) << 3) | (baseIndex & 7));
+        if ((baseIndex & 7) == 4)
+            _Emit8(0x24);
+        _Emit32(static_cast<uint32_t>(disp));
+    }
+
+    void X64Emitter::_EmitRegMemIndex(std::initializer_list<uint8_t> opcode, uint8_t reg, X64Reg base, X64Reg index, bool w, bool isByte)
+    {
+        uint8_t baseIndex = RegIndex(base);
+        uint8_t indexIndex = RegIndex(index);
+        GBE_ASSERT(index != X64Reg::RSP);
+
+        bool isByteReg = isByte && reg >= 4 && reg < 8;
+
+        _EmitRex(w, reg, indexIndex, baseIndex, isByteReg);
+        for (uint8_t byte: opcode)
+            _Emit8(byte);
+
+        // [base + index + disp8 0], the disp8 keeps rbp / r13 bases encodable
+        _Emit8(0x44 | ((reg & 7) << 3));
+        _Emit8(((indexIndex & 7) << 3) | (baseIndex & 7));
+        _Emit8(0);
+    }
+} // namespace GBE
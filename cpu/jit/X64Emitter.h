@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+namespace GBE
+{
+    // x86-64 general purpose registers (encoding order)
+    enum class X64Reg : uint8_t
+    {
+        RAX = 0,
+        RCX,
+        RDX,
+        RBX,
+        RSP,
+        RBP,
+        RSI,
+        RDI,
+        R8,
+        R9,
+        R10,
+        R11,
+        R12,
+        R13,
+        R14,
+        R15
+    };
+
+    // condition codes of jcc / setcc
+    enum class X64Cond : uint8_t
+    {
+        O = 0,
+        NO,
+        B,
+        AE,
+        E,
+        NE,
+        BE,
+        A,
+        S,
+        NS,
+        P,
+        NP,
+        L,
+        GE,
+        LE,
+        G
+    };
+
+    // two operands alu instructions, value is the /digit of the immediate forms
+    enum class X64Alu : uint8_t
+    {
+        ADD = 0,
+        OR,
+        ADC,
+        SBB,
+        AND,
+        SUB,
+        XOR,
+        CMP
+    };
+
+    // minimal x86-64 assembler, only the instructions used by the cpu jit
+    // memory operands are [base + disp32] or [base + index]
+    class X64Emitter
+    {
+    public:
+        using Label = size_t;
+
+        X64Emitter() = default;
+        ~X64Emitter() = default;
+
+        inline const std::vector<uint8_t>& GetCode() const
+        {
+            return m_Code;
+        }
+
+        // labels, jumps to unbound labels are patched on bind
+        Label NewLabel();
+        void Bind(Label label);
+        void Jump(Label label);
+        void JumpIf(X64Cond cond, Label label);
+
+        // stack and calls
+        void Push(X64Reg reg);
+        void Pop(X64Reg reg);
+        void Call(X64Reg reg);
+        void Ret();
+
+        // mov
+        void Mov32(X64Reg dest, X64Reg src);
+        void Mov32(X64Reg dest, uint32_t imm);
+        void Mov64(X64Reg dest, uint64_t imm);
+        void Mov64(X64Reg dest, const void* pointer);
+        void Load64(X64Reg dest, X64Reg base, int32_t disp);
+
+        // zero extended loads
+        void Movzx8(X64Reg dest, X64Reg src);
+        void Movzx8(X64Reg dest, X64Reg base, int32_t disp);
+        void Movzx8(X64Reg dest, X64Reg base, X64Reg index);
+        void Movzx16(X64Reg dest, X64Reg base, int32_t disp);
+        // movzx dest, ah (dest < r8)
+        void MovzxAH(X64Reg dest);
+
+        // stores
+        void Store8(X64Reg base, int32_t disp, X64Reg src);
+        void Store8(X64Reg base, X64Reg index, X64Reg src);
+        void Store16(X64Reg base, int32_t disp, X64Reg src);
+        void Store16(X64Reg base, int32_t disp, uint16_t imm);
+
+        // alu
+        void Alu8(X64Alu op, X64Reg dest, X64Reg src);
+        void Alu32(X64Alu op, X64Reg dest, X64Reg src);
+        void Alu32(X64Alu op, X64Reg dest, int32_t imm);
+        void Alu64(X64Alu op, X64Reg dest, X64Reg src);
+        void Alu64(X64Alu op, X64Reg dest, int32_t imm);
+        void Cmp8(X64Reg base, int32_t disp, uint8_t imm);
+        void Cmp8(X64Reg base, X64Reg index, uint8_t imm);
+        void Inc8(X64Reg reg);
+        void Dec8(X64Reg reg);
+        void Shl32(X64Reg reg, uint8_t count);
+        void Shr32(X64Reg reg, uint8_t count);
+        void Imul64(X64Reg dest, X64Reg src, int32_t imm);
+        void Test32(X64Reg reg, uint32_t imm);
+        void Bt32(X64Reg reg, uint8_t bit);
+        void Lahf();
+
+    private:
+        struct LabelInfo
+        {
+            int64_t Position = -1;
+            // offsets of the rel32 to patch once bound
+            std::vector<size_t> Patches{};
+        };
+
+        std::vector<uint8_t> m_Code{};
+        std::vector<LabelInfo> m_Labels{};
+
+        void _Emit8(uint8_t byte);
+        void _Emit16(uint16_t value);
+        void _Emit32(uint32_t value);
+        void _Emit64(uint64_t value);
+        void _EmitRel32(Label label);
+
+        // rex prefix, forced for the spl / bpl / sil / dil byte registers
+        void _EmitRex(bool w, uint8_t reg, uint8_t index, uint8_t base, bool isByteReg);
+
+        void _EmitRegReg(std::initializer_list<uint8_t> opcode, uint8_t reg, X64Reg rm, bool w, bool isByte);
+        void _EmitRegMem(std::initializer_list<uint8_t> opcode, uint8_t reg, X64Reg base, int32_t disp, bool w, bool isByte);
+        void _EmitRegMemIndex(std::initializer_list<uint8_t> opcode, uint8_t reg, X64Reg base, X64Reg index, bool w, bool isByte);
+    };
+} // namespace GBE
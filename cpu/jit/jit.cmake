@@ -0,0 +1,9 @@
+set (GBE_HEADERS ${GBE_HEADERS}
+    ${CMAKE_CURRENT_LIST_DIR}/X64Emitter.h
+    ${CMAKE_CURRENT_LIST_DIR}/CpuJit.h
+)
+
+set(GBE_SOURCES ${GBE_SOURCES}
+    ${CMAKE_CURRENT_LIST_DIR}/X64Emitter.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/CpuJit.cpp
+)
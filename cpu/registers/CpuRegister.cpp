@@ -9,20 +9,6 @@ namespace GBE
     {
     }
 
-    void CpuRegister::Set16(uint16_t value)
-    {
-        SetLow(value & 0xff);
-        SetHigh(value >> 8);
-    }
-
-    uint16_t CpuRegister::Get16() const
-    {
-        uint16_t low = GetLow();
-        uint16_t high = GetHigh() << 8;
-
-        return low | high;
-    }
-
     std::string CpuRegister::ToString(std::string_view name, bool showHighLow) const
     {
         // 16 bits
@@ -14,10 +14,20 @@ namespace GBE
         ~CpuRegister();
 
         // set full 16 bits 
-        void Set16(uint16_t value);
+        inline void Set16(uint16_t value)
+        {
+            SetLow(value & 0xff);
+            SetHigh(value >> 8);
+        }
 
         // get as 16 bits number
-        uint16_t Get16() const;
+        inline uint16_t Get16() const
+        {
+            uint16_t low = GetLow();
+            uint16_t high = GetHigh() << 8;
+
+            return low | high;
+        }
 
         // set high 8bits
         inline void SetHigh(uint8_t value)
@@ -55,6 +65,9 @@ namespace GBE
             m_LowMask = mask;
         }
 
+        // compiled code accesses the fields directly
+        friend class CpuJit;
+
     private:
         uint8_t m_High = 0;
         uint8_t m_HighMask = 0xFF;
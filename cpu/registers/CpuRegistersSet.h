@@ -53,6 +53,84 @@ namespace GBE
         // set Reg16
         void SetReg16(Reg16 r16, uint16_t value);
 
+        // get Reg8 known at compile time
+        template <Reg8 r8>
+        inline uint8_t GetReg8() const
+        {
+            if constexpr (r8 == Reg8::A)
+                return m_AF.GetHigh();
+            else if constexpr (r8 == Reg8::B)
+                return m_BC.GetHigh();
+            else if constexpr (r8 == Reg8::C)
+                return m_BC.GetLow();
+            else if constexpr (r8 == Reg8::D)
+                return m_DE.GetHigh();
+            else if constexpr (r8 == Reg8::E)
+                return m_DE.GetLow();
+            else if constexpr (r8 == Reg8::H)
+                return m_HL.GetHigh();
+            else if constexpr (r8 == Reg8::L)
+                return m_HL.GetLow();
+            else
+                return 0xff;
+        }
+
+        // set Reg8 known at compile time
+        template <Reg8 r8>
+        inline void SetReg8(uint8_t value)
+        {
+            if constexpr (r8 == Reg8::A)
+                m_AF.SetHigh(value);
+            else if constexpr (r8 == Reg8::B)
+                m_BC.SetHigh(value);
+            else if constexpr (r8 == Reg8::C)
+                m_BC.SetLow(value);
+            else if constexpr (r8 == Reg8::D)
+                m_DE.SetHigh(value);
+            else if constexpr (r8 == Reg8::E)
+                m_DE.SetLow(value);
+            else if constexpr (r8 == Reg8::H)
+                m_HL.SetHigh(value);
+            else if constexpr (r8 == Reg8::L)
+                m_HL.SetLow(value);
+        }
+
+        // get Reg16 known at compile time
+        template <Reg16 r16>
+        inline uint16_t GetReg16() const
+        {
+            if constexpr (r16 == Reg16::BC)
+                return m_BC.Get16();
+            else if constexpr (r16 == Reg16::DE)
+                return m_DE.Get16();
+            else if constexpr (r16 == Reg16::HL)
+                return m_HL.Get16();
+            else if constexpr (r16 == Reg16::AF)
+                return m_AF.Get16();
+            else if constexpr (r16 == Reg16::PC)
+                return m_PC;
+            else
+                return m_SP;
+        }
+
+        // set Reg16 known at compile time
+        template <Reg16 r16>
+        inline void SetReg16(uint16_t value)
+        {
+            if constexpr (r16 == Reg16::BC)
+                m_BC.Set16(value);
+            else if constexpr (r16 == Reg16::DE)
+                m_DE.Set16(value);
+            else if constexpr (r16 == Reg16::HL)
+                m_HL.Set16(value);
+            else if constexpr (r16 == Reg16::AF)
+                m_AF.Set16(value);
+            else if constexpr (r16 == Reg16::PC)
+                m_PC = value;
+            else
+                m_SP = value;
+        }
+
         // get flags
         uint8_t GetFlags() const;
 
@@ -68,6 +146,9 @@ namespace GBE
         // to string
         std::string ToString() const;
 
+        // compiled code accesses the fields directly
+        friend class CpuJit;
+
     private:
         CpuRegister m_AF{};
         CpuRegister m_BC{};
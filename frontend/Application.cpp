@@ -5,6 +5,8 @@
 #include <print>
 
 #include "gameboy/Gameboy.h"
+#include "gameboy/RewindBuffer.h"
+#include "gameboy/RunAhead.h"
 
 #include "rendering/Window.h"
 #include "rendering/Renderer.h"
@@ -14,15 +16,22 @@
 
 namespace GBE
 {
+    // rewind history, a snapshot every 4 frames (about 15 per second)
+    constexpr size_t REWIND_CAPACITY = 64 * 1024 * 1024;
+    constexpr uint32_t REWIND_INTERVAL = 4;
+
     Application::Application()
     {
         SDL_Init(SDL_INIT_VIDEO);
 
         m_GB = std::make_shared<Gameboy>();
+        // off until enabled in the gui
+        m_RunAhead = std::make_shared<RunAhead>(0);
         m_Window = std::make_shared<Window>(1280, 720);
         m_Renderer = std::make_shared<Renderer>(m_Window, m_GB);
-        m_GuiManager = std::make_shared<GuiManager>(m_Window, m_Renderer, m_GB);
+        m_GuiManager = std::make_shared<GuiManager>(m_Window, m_Renderer, m_GB, m_RunAhead);
         m_EventManager = std::make_shared<EventManager>(m_Window, m_GB, m_GuiManager);
+        m_Rewind = std::make_unique<RewindBuffer>(REWIND_CAPACITY, REWIND_INTERVAL);
     }
 
     Application::~Application()
@@ -45,7 +54,17 @@ namespace GBE
         m_GBTickTimer += delta;
         if (m_GBTickTimer >= FRAME_TIME)
         {
-            m_GB->Tick();
+            // step back one frame instead while rewinding
+            if (m_EventManager->IsRewinding())
+            {
+                m_Rewind->StepBack(*m_GB);
+            }
+            else
+            {
+                m_RunAhead->Tick(*m_GB);
+                m_Rewind->Push(*m_GB);
+            }
+
             m_GBTickTimer -= FRAME_TIME;
         }
 
@@ -9,6 +9,8 @@ namespace GBE
     class Window;
     class GuiManager;
     class EventManager;
+    class RewindBuffer;
+    class RunAhead;
 
     // application containing the front end of the game boy emulator
     class Application
@@ -25,6 +27,8 @@ namespace GBE
         std::shared_ptr<Window> m_Window = nullptr;
         std::shared_ptr<GuiManager> m_GuiManager = nullptr;
         std::shared_ptr<EventManager> m_EventManager = nullptr;
+        std::unique_ptr<RewindBuffer> m_Rewind = nullptr;
+        std::shared_ptr<RunAhead> m_RunAhead = nullptr;
 
         float m_GBTickTimer = 0.0f;
 
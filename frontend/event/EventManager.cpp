@@ -42,6 +42,13 @@ namespace GBE
             if (event.type != SDL_EventType::SDL_EVENT_KEY_DOWN && event.type != SDL_EventType::SDL_EVENT_KEY_UP)
                 continue;
 
+            // rewind while backspace is held
+            if (event.key.key == SDLK_BACKSPACE)
+            {
+                m_IsRewinding = event.key.down;
+                continue;
+            }
+
             JoypadEvent joypadEvent{};
             joypadEvent.Pressed = event.key.down;
             bool doQueueEvent = true;
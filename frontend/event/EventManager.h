@@ -15,9 +15,18 @@ namespace GBE
         ~EventManager() = default;
 
         void ProcessEvents();
+
+        // rewind key held down
+        inline bool IsRewinding() const
+        {
+            return m_IsRewinding;
+        }
+
     private:
         std::shared_ptr<Window> m_Window = nullptr;
         std::shared_ptr<Gameboy> m_Gameboy = nullptr;
         std::shared_ptr<GuiManager> m_GuiManager = nullptr;
+
+        bool m_IsRewinding = false;
     };
 } // namespace GBE
@@ -2,10 +2,10 @@ include(${CMAKE_CURRENT_LIST_DIR}/rendering/rendering.cmake)
 include(${CMAKE_CURRENT_LIST_DIR}/gui/gui.cmake)
 include(${CMAKE_CURRENT_LIST_DIR}/event/event.cmake)
 
-set (GBE_HEADERS ${GBE_HEADERS}
+set (GBE_FRONTEND_HEADERS ${GBE_FRONTEND_HEADERS}
     ${CMAKE_CURRENT_LIST_DIR}/Application.h
 )
 
-set(GBE_SOURCES ${GBE_SOURCES}
+set(GBE_FRONTEND_SOURCES ${GBE_FRONTEND_SOURCES}
     ${CMAKE_CURRENT_LIST_DIR}/Application.cpp
 )
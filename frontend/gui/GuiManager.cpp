@@ -15,19 +15,22 @@
 #include "menu/GuiMainMenu.h"
 
 #include "gameboy/Gameboy.h"
+#include "gameboy/RunAhead.h"
 #include "cartridge/Cartridge.h"
 #include "util/Assert.h"
 
 namespace GBE
 {
-    GuiManager::GuiManager(std::shared_ptr<Window> window, std::shared_ptr<Renderer> renderer, std::shared_ptr<Gameboy> gameboy): 
+    GuiManager::GuiManager(std::shared_ptr<Window> window, std::shared_ptr<Renderer> renderer, std::shared_ptr<Gameboy> gameboy, std::shared_ptr<RunAhead> runAhead): 
         m_Window(window), 
         m_Renderer(renderer),
-        m_Gameboy(gameboy)
+        m_Gameboy(gameboy),
+        m_RunAhead(runAhead)
     {
         GBE_ASSERT(m_Window);
         GBE_ASSERT(m_Renderer);
         GBE_ASSERT(m_Gameboy);
+        GBE_ASSERT(m_RunAhead);
 
         IMGUI_CHECKVERSION();
         ImGui::CreateContext();
@@ -57,6 +60,7 @@ namespace GBE
         ImGui::NewFrame();
 
         m_RootLayer->Render();
+        _RenderRunAhead();
 
         ImGui::Render();
 
@@ -78,4 +82,17 @@ namespace GBE
         ImGui::End();
     }
 
+    void GuiManager::_RenderRunAhead()
+    {
+        ImGui::Begin("Run Ahead");
+
+        int frames = static_cast<int>(m_RunAhead->GetFrames());
+        if (ImGui::SliderInt("Frames", &frames, 0, static_cast<int>(RunAhead::MAX_FRAMES)))
+            m_RunAhead->SetFrames(static_cast<uint32_t>(frames));
+
+        ImGui::Text("Time: %.2f ms", m_RunAhead->GetAverageTime() * 1000.0);
+        ImGui::Text("Frame budget: %.1f%%", m_RunAhead->GetFrameBudgetUsage() * 100.0);
+        ImGui::End();
+    }
+
 } // namespace GBE
@@ -12,11 +12,12 @@ namespace GBE
     class Renderer;
     class Gameboy;
     class GuiLayer;
+    class RunAhead;
 
     class GuiManager
     {
     public:
-        GuiManager(std::shared_ptr<Window> window, std::shared_ptr<Renderer> renderer, std::shared_ptr<Gameboy> gameboy);
+        GuiManager(std::shared_ptr<Window> window, std::shared_ptr<Renderer> renderer, std::shared_ptr<Gameboy> gameboy, std::shared_ptr<RunAhead> runAhead);
         ~GuiManager();
 
         void Render(float delta);
@@ -26,8 +27,11 @@ namespace GBE
         std::shared_ptr<Window> m_Window = nullptr;
         std::shared_ptr<Renderer> m_Renderer = nullptr;
         std::shared_ptr<Gameboy> m_Gameboy = nullptr;
+        std::shared_ptr<RunAhead> m_RunAhead = nullptr;
 
         std::shared_ptr<GuiLayer> m_RootLayer = nullptr;
         void _RenderFPSCounter(float delta);
+        // run ahead frames and the frame budget they use
+        void _RenderRunAhead();
     };
 } // namespace GBE
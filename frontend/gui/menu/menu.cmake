@@ -1,8 +1,8 @@
 
-set (GBE_HEADERS ${GBE_HEADERS}
+set (GBE_FRONTEND_HEADERS ${GBE_FRONTEND_HEADERS}
     ${CMAKE_CURRENT_LIST_DIR}/GuiMainMenu.h
 )
 
-set(GBE_SOURCES ${GBE_SOURCES}
+set(GBE_FRONTEND_SOURCES ${GBE_FRONTEND_SOURCES}
     ${CMAKE_CURRENT_LIST_DIR}/GuiMainMenu.cpp
 )
@@ -1,4 +1,4 @@
-set (GBE_HEADERS ${GBE_HEADERS}
+set (GBE_FRONTEND_HEADERS ${GBE_FRONTEND_HEADERS}
     ${CMAKE_CURRENT_LIST_DIR}/GuiWindow.h
     ${CMAKE_CURRENT_LIST_DIR}/GuiDebugger.h
     ${CMAKE_CURRENT_LIST_DIR}/GuiCpuState.h
@@ -6,7 +6,7 @@ set (GBE_HEADERS ${GBE_HEADERS}
     ${CMAKE_CURRENT_LIST_DIR}/GuiMemoryDump.h
 )
 
-set(GBE_SOURCES ${GBE_SOURCES}
+set(GBE_FRONTEND_SOURCES ${GBE_FRONTEND_SOURCES}
     ${CMAKE_CURRENT_LIST_DIR}/GuiWindow.cpp
     ${CMAKE_CURRENT_LIST_DIR}/GuiDebugger.cpp
     ${CMAKE_CURRENT_LIST_DIR}/GuiCpuState.cpp
@@ -9,7 +9,9 @@
 #include "util/Assert.h"
 
 #include <SDL3/SDL.h>
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 
 namespace GBE
 {
@@ -26,17 +28,24 @@ namespace GBE
         GBE_ASSERT(m_SDLRenderer);
 
         // init color palette
-        m_ColorPalette.push_back({224, 248, 208});
-        m_ColorPalette.push_back({136, 192, 112});
-        m_ColorPalette.push_back({52, 104, 86});
-        m_ColorPalette.push_back({8, 24, 32});
+        std::array<ColorRGB32, LCD_COLORS_NUMBER> colors = {
+            ColorRGB32{224, 248, 208},
+            ColorRGB32{136, 192, 112},
+            ColorRGB32{52, 104, 86},
+            ColorRGB32{8, 24, 32}
+        };
+
+        static_assert(sizeof(ColorRGB32) == sizeof(uint32_t));
+        for (size_t i = 0; i < colors.size(); i++)
+            std::memcpy(&m_ColorPalette[i], &colors[i], sizeof(uint32_t));
 
-        GBE_ASSERT(m_ColorPalette.size() == LCD_COLORS_NUMBER);
+        // nothing uploaded yet
+        m_LineVersions.fill(UINT32_MAX);
 
         // create texture
         m_SDLTexture = SDL_CreateTexture(
             m_SDLRenderer,
-            SDL_PIXELFORMAT_RGB24,
+            SDL_PIXELFORMAT_RGBA32,
             SDL_TEXTUREACCESS_STREAMING,
             LCD_SCREEN_WIDTH,
             LCD_SCREEN_HEIGHT
@@ -96,24 +105,39 @@ namespace GBE
 
     void Renderer::_UpdateTexture()
     {
-        Ppu& ppu = m_GB->GetPpu();
+        // last frame published by the ppu, no frame is drawn while the ppu is on it
+        LcdFrameBuffer& frameBuffer = m_GB->GetPpu().GetFrameBuffer();
+        frameBuffer.Acquire();
+        const auto &lcdScreen = frameBuffer.GetFrontScreen();
+
+        // same frame as the texture
+        if (lcdScreen.GetVersion() == m_ScreenVersion)
+            return;
+
+        m_ScreenVersion = lcdScreen.GetVersion();
 
-        // update texture
-        const auto &lcdScreen = ppu.GetLcdScreen();
+        // convert the changed lines
+        int firstLine = LCD_SCREEN_HEIGHT;
+        int lastLine = -1;
         for (int y = 0; y < LCD_SCREEN_HEIGHT; y++)
         {
-            for (int x = 0; x < LCD_SCREEN_WIDTH; x++)
-            {
-                uint8_t pixel = lcdScreen.GetPixel(x, y);
-                ColorRGB32 color = m_ColorPalette[pixel % m_ColorPalette.size()];
-                
-                int index = (x + y * LCD_SCREEN_WIDTH) * 3;
-                m_Pixels[index + 0] = color.Red;
-                m_Pixels[index + 1] = color.Green;
-                m_Pixels[index + 2] = color.Blue;
-            }
+            uint32_t version = lcdScreen.GetLineVersion(y);
+            if (version == m_LineVersions[y])
+                continue;
+
+            m_LineVersions[y] = version;
+            lcdScreen.ToRGBA(y, 1, m_ColorPalette, m_Pixels.data() + y * LCD_SCREEN_WIDTH);
+
+            firstLine = std::min(firstLine, y);
+            lastLine = y;
         }
 
-        SDL_UpdateTexture(m_SDLTexture, nullptr, m_Pixels.data(), LCD_SCREEN_WIDTH * 3);
+        if (lastLine < firstLine)
+            return;
+
+        // upload the range of changed lines
+        SDL_Rect rect = {0, firstLine, LCD_SCREEN_WIDTH, lastLine - firstLine + 1};
+        const uint32_t* pixels = m_Pixels.data() + firstLine * LCD_SCREEN_WIDTH;
+        SDL_UpdateTexture(m_SDLTexture, &rect, pixels, LCD_SCREEN_WIDTH * sizeof(uint32_t));
     }
 } // namespace GBE
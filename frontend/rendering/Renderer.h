@@ -18,6 +18,7 @@ namespace GBE
         uint8_t Red = 0x0;
         uint8_t Green = 0x0;
         uint8_t Blue = 0x0;
+        uint8_t Alpha = 0xFF;
     };
 
 
@@ -43,8 +44,12 @@ namespace GBE
         SDL_Renderer* m_SDLRenderer = nullptr;
         SDL_Texture * m_SDLTexture = nullptr;
 
-        std::array<uint8_t, LCD_SCREEN_WIDTH * LCD_SCREEN_HEIGHT * 3> m_Pixels;
-        std::vector<ColorRGB32> m_ColorPalette; 
+        std::array<uint32_t, LCD_SCREEN_WIDTH * LCD_SCREEN_HEIGHT> m_Pixels{};
+        LcdScreen::PaletteRGBA m_ColorPalette{};
+
+        // screen versions of the uploaded texture, only changed lines are converted and uploaded
+        uint64_t m_ScreenVersion = UINT64_MAX;
+        LcdScreen::LineVersions m_LineVersions{};
 
         void _UpdateTexture();
     };
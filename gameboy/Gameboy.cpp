@@ -19,11 +19,16 @@
 #include "cpu/instruction/InstructionResult.h"
 #include "cpu/disassembler/Disassembler.h"
 
+#include "util/Assert.h"
+#include "util/StateWriter.h"
+#include "util/StateReader.h"
+
+#include <algorithm>
 #include <print>
 
 namespace GBE
 {
-    Gameboy::Gameboy()
+    Gameboy::Gameboy(PpuRenderer renderer)
     {
         // memory interface
         m_Memory = std::make_shared<Memory>();
@@ -33,21 +38,36 @@ namespace GBE
         m_HighRam = std::make_shared<Ram>(MMAP_HRAM.GetSize());
         
         // io
+        m_Scheduler = std::make_shared<Scheduler>();
         m_InterruptManager = std::make_shared<InterruptManager>();
         m_Joypad = std::make_shared<Joypad>(m_InterruptManager);
-        m_Timer = std::make_shared<Timer>(m_InterruptManager);
+        m_Timer = std::make_shared<Timer>(m_InterruptManager, m_Scheduler);
 
         // graphics
         m_Vram = std::make_shared<Vram>();
         m_Oam = std::make_shared<ObjectAttributesMemory>();
         m_Palettes = std::make_shared<LcdPalettesMemory>();
         m_LcdControl = std::make_shared<LcdControl>(m_Oam);
-        m_Ppu = std::make_unique<Ppu>(m_Vram, m_Oam, m_Palettes, m_LcdControl, m_InterruptManager);
+        m_Ppu = std::make_unique<Ppu>(m_Vram, m_Oam, m_Palettes, m_LcdControl, m_InterruptManager, renderer);
+        m_LcdControl->SetTimingListener([this]()
+        {
+            // the write lands at the next instruction boundary
+            _SyncPpu();
+            m_Scheduler->Schedule(SchedulerEvent::PPU, m_Scheduler->GetCycles());
+            m_Scheduler->Schedule(SchedulerEvent::DMA, m_Scheduler->GetCycles());
+        });
 
         // cpu
-        m_Decoder = std::make_shared<InstructionDecoder>();
-        m_Cpu = std::make_unique<Cpu>(m_Memory, m_Decoder);
-        m_Disassembler = std::make_unique<Disassembler>(m_Memory, m_Decoder);
+        m_Cpu = std::make_unique<Cpu>(m_Memory, m_InterruptManager);
+        m_Cpu->SetHardwareStep([this](uint16_t cycles)
+        {
+            return _StepBlockInstruction(cycles);
+        });
+        m_Cpu->SetIdleLoopSkip([this](uint32_t iterationCycles)
+        {
+            return _GetIdleLoopIterations(iterationCycles);
+        });
+        m_Disassembler = std::make_unique<Disassembler>(m_Memory);
     }
 
     Gameboy::~Gameboy()
@@ -59,14 +79,55 @@ namespace GBE
         if (m_IsRunning)
             return;
 
+        _Start(cartridge);
+
+        for (uint32_t frame = 0; frame < m_ResetWarmupFrames; frame++)
+            Tick();
+
+        CaptureResetSnapshot();
+    }
+
+    void Gameboy::_Start(const std::shared_ptr<Cartridge>& cartridge)
+    {
         m_IsRunning = true;
         m_Cartridge = cartridge;
 
+        m_Scheduler->Init();
+        m_FrameStart = 0;
+        m_PpuCycles = 0;
+        m_EventCycles = 0;
+
         m_Cpu->Init();
         m_Ppu->Init(); 
 
         _InitMemoryMapping();
         m_Memory->Init();
+
+        // init leaves an oam transfer pending
+        m_Scheduler->Schedule(SchedulerEvent::PPU, 0);
+        m_Scheduler->Schedule(SchedulerEvent::DMA, 0);
+
+        // the layout only depends on the rom, an empty writer only counts the bytes
+        StateWriter writer{{}};
+        _SaveState(writer, 0);
+        m_StateSize = writer.GetSize();
+    }
+
+    void Gameboy::CaptureResetSnapshot()
+    {
+        if (!m_IsRunning)
+            return;
+
+        m_ResetState.resize(GetStateSize());
+        SaveState(m_ResetState);
+    }
+
+    void Gameboy::Reset()
+    {
+        if (!m_IsRunning || m_ResetState.empty())
+            return;
+
+        LoadState(m_ResetState);
     }
 
     uint16_t Gameboy::Tick()
@@ -75,35 +136,140 @@ namespace GBE
             return 0;
 
         CpuDebugger& debugger = m_Cpu->GetDebugger();
-        CpuRegistersSet& regs = m_Cpu->GetRegisters();
 
-        uint16_t instructionCycles = 0;
-        uint32_t dots = 0;
-        while (dots < FRAME_DOTS)
-        {
-            m_Joypad->Tick();
+        m_FrameStart = m_Scheduler->GetCycles();
 
-            uint16_t pc = regs.GetReg16(Reg16::PC);
+        // input queued since the last frame
+        if (m_Joypad->HasEvents())
+            m_Scheduler->Schedule(SchedulerEvent::INPUT, m_FrameStart);
+        _RunEvents();
 
+        while (!_IsFrameDone())
+        {
             InstructionResult result{};
             m_Cpu->Run(result);
 
-            for (uint16_t i = 0; i < result.Cycles; i++)
-                m_Timer->Tick();
+            // nothing changes while halted until an event raises an interrupt
+            if (_IsHaltedUntilEvent())
+                result.Cycles = _GetHaltedCycles();
 
-            uint32_t instructionDots = result.Cycles * 4;
-            m_Ppu->Tick(instructionDots);
-            
-            // manage oam transfer
-            m_LcdControl->Tick(*m_Memory, instructionDots);
-
-            dots += instructionDots;
-            instructionCycles += result.Cycles;
+            _StepHardware(result.Cycles);
 
             if (debugger.IsEnabled() && debugger.IsBreaked())
                 break;
         }
-        return instructionCycles;
+        return static_cast<uint16_t>(m_Scheduler->GetCycles() - m_FrameStart);
+    }
+
+    void Gameboy::_StepHardware(uint16_t cycles)
+    {
+        m_Scheduler->Advance(cycles);
+        if (m_Scheduler->HasDueEvent())
+            _RunEvents();
+    }
+
+    void Gameboy::_RunEvents()
+    {
+        while (m_Scheduler->HasDueEvent())
+        {
+            m_EventCycles = m_Scheduler->GetCycles();
+
+            switch (m_Scheduler->PopDueEvent())
+            {
+            case SchedulerEvent::TIMER:
+                m_Timer->Update();
+                break;
+            case SchedulerEvent::PPU:
+                _UpdatePpu();
+                break;
+            case SchedulerEvent::DMA:
+                _UpdateDMA();
+                break;
+            case SchedulerEvent::INPUT:
+                // input runs before an instruction, after the last one of the frame it waits for the next frame
+                if (_IsFrameDone())
+                {
+                    m_Scheduler->Schedule(SchedulerEvent::INPUT, m_Scheduler->GetCycles());
+                    return;
+                }
+                _UpdateInput();
+                break;
+            default:
+                return;
+            }
+        }
+    }
+
+    bool Gameboy::_StepBlockInstruction(uint16_t cycles)
+    {
+        // the frame ends after this instruction, let Tick step it
+        if (m_Scheduler->GetCycles() + cycles - m_FrameStart >= FRAME_CYCLES)
+            return false;
+
+        _StepHardware(cycles);
+        return true;
+    }
+
+    bool Gameboy::_IsHaltedUntilEvent() const
+    {
+        // the debugger ticks on every halted cycle
+        return m_Cpu->IsHalted() &&
+            m_InterruptManager->GetPendingInterrupts() == 0 &&
+            !m_Cpu->GetDebugger().IsEnabled();
+    }
+
+    uint16_t Gameboy::_GetHaltedCycles() const
+    {
+        // halted cycles are 1 m-cycle each, skip them up to the next event or the end of the frame
+        uint64_t cycles = m_Scheduler->GetCycles();
+        uint64_t wakeUp = std::min(m_Scheduler->GetNextDeadline(), m_FrameStart + FRAME_CYCLES);
+        return static_cast<uint16_t>(std::max(wakeUp, cycles + 1) - cycles);
+    }
+
+    uint32_t Gameboy::_GetIdleLoopIterations(uint32_t iterationCycles) const
+    {
+        // polled io only changes on events, the last iteration must have run without any
+        uint64_t cycles = m_Scheduler->GetCycles();
+        if (m_EventCycles + iterationCycles > cycles)
+            return 0;
+
+        uint64_t wakeUp = std::min(m_Scheduler->GetNextDeadline(), m_FrameStart + FRAME_CYCLES);
+        return static_cast<uint32_t>((wakeUp - cycles) / iterationCycles);
+    }
+
+    void Gameboy::_SyncPpu()
+    {
+        uint64_t cycles = m_Scheduler->GetCycles();
+        m_Ppu->Tick(static_cast<uint32_t>(cycles - m_PpuCycles) * DOT_TO_M_CYCLE);
+        m_PpuCycles = cycles;
+    }
+
+    void Gameboy::_UpdatePpu()
+    {
+        _SyncPpu();
+
+        if (!m_LcdControl->GetControlFlag(LcdControlFlag::LCD_PPU_ENABLE))
+            return;
+
+        // first instruction boundary at or after the next working dot
+        uint64_t cycles = (m_Ppu->GetIdleDots() + DOT_TO_M_CYCLE) / DOT_TO_M_CYCLE;
+        m_Scheduler->Schedule(SchedulerEvent::PPU, m_PpuCycles + cycles);
+    }
+
+    void Gameboy::_UpdateDMA()
+    {
+        // the transfer counts instruction boundaries
+        m_LcdControl->Tick(*m_Memory, 0);
+        if (m_LcdControl->IsDMATransferring())
+            m_Scheduler->Schedule(SchedulerEvent::DMA, m_Scheduler->GetCycles() + 1);
+    }
+
+    void Gameboy::_UpdateInput()
+    {
+        // one event per instruction
+        m_Joypad->Tick();
+        if (m_Joypad->HasEvents())
+            m_Scheduler->Schedule(SchedulerEvent::INPUT, m_Scheduler->GetCycles() + 1);
     }
 
     void Gameboy::Stop()
@@ -113,6 +279,121 @@ namespace GBE
         m_Memory->Reset();
     }
 
+    size_t Gameboy::GetStateSize() const
+    {
+        return m_IsRunning ? m_StateSize : 0;
+    }
+
+    size_t Gameboy::SaveState(std::span<uint8_t> buffer) const
+    {
+        size_t size = GetStateSize();
+        if (size == 0 || size > buffer.size())
+            return 0;
+
+        StateWriter writer{buffer};
+        _SaveState(writer, static_cast<uint32_t>(size));
+        GBE_ASSERT(writer.GetSize() == size);
+        return size;
+    }
+
+    bool Gameboy::LoadState(std::span<const uint8_t> buffer)
+    {
+        if (!m_IsRunning)
+            return false;
+
+        // check the header before touching anything, the layout of the state only depends on the rom
+        // so a state of the expected size can be read whole
+        StateReader reader{buffer};
+        uint32_t magic = reader.Read<uint32_t>();
+        uint32_t version = reader.Read<uint32_t>();
+        uint32_t size = reader.Read<uint32_t>();
+        if (reader.IsUnderflowed() || magic != STATE_MAGIC || version != STATE_VERSION || 
+            size > buffer.size() || size != GetStateSize())
+            return false;
+
+        m_Scheduler->LoadState(reader);
+        reader.Read(m_FrameStart);
+        reader.Read(m_PpuCycles);
+        reader.Read(m_EventCycles);
+
+        m_Cpu->LoadState(reader);
+        m_InterruptManager->LoadState(reader);
+        m_Timer->LoadState(reader);
+        m_Joypad->LoadState(reader);
+
+        m_LcdControl->LoadState(reader);
+        m_Palettes->LoadState(reader);
+        m_Vram->LoadState(reader);
+        m_Oam->LoadState(reader);
+        m_Ppu->LoadState(reader);
+
+        m_WorkRam->LoadState(reader);
+        m_HighRam->LoadState(reader);
+        m_Cartridge->LoadState(reader);
+
+        return !reader.IsUnderflowed() && reader.GetSize() == size;
+    }
+
+    std::unique_ptr<Gameboy> Gameboy::Clone() const
+    {
+        auto clone = std::make_unique<Gameboy>(m_Ppu->GetRenderer());
+        clone->CopyFrom(*this);
+        return clone;
+    }
+
+    void Gameboy::CopyFrom(const Gameboy& other)
+    {
+        GBE_ASSERT(other.m_IsRunning);
+
+        if (m_IsRunning && m_Cartridge != other.m_Cartridge)
+            Stop();
+
+        // the state is overwritten, no warmup or reset snapshot
+        if (!m_IsRunning)
+            _Start(other.m_Cartridge);
+
+        // settings aren't part of the state
+        if (m_Cpu->GetEngine() != other.m_Cpu->GetEngine())
+            m_Cpu->SetEngine(other.m_Cpu->GetEngine());
+
+        m_Ppu->SetFrameSkip(other.m_Ppu->GetFrameSkip());
+        m_Ppu->SetDrawOnRequest(other.m_Ppu->IsDrawOnRequest());
+
+        m_ResetWarmupFrames = other.m_ResetWarmupFrames;
+        m_ResetState = other.m_ResetState;
+
+        m_CopyState.resize(other.GetStateSize());
+        other.SaveState(m_CopyState);
+        LoadState(m_CopyState);
+    }
+
+    void Gameboy::_SaveState(StateWriter& writer, uint32_t size) const
+    {
+        writer.Write(STATE_MAGIC);
+        writer.Write(STATE_VERSION);
+        writer.Write(size);
+
+        m_Scheduler->SaveState(writer);
+        writer.Write(m_FrameStart);
+        writer.Write(m_PpuCycles);
+        writer.Write(m_EventCycles);
+
+        m_Cpu->SaveState(writer);
+        m_InterruptManager->SaveState(writer);
+        m_Timer->SaveState(writer);
+        m_Joypad->SaveState(writer);
+
+        m_LcdControl->SaveState(writer);
+        m_Palettes->SaveState(writer);
+        m_Vram->SaveState(writer);
+        m_Oam->SaveState(writer);
+        m_Ppu->SaveState(writer);
+
+        m_WorkRam->SaveState(writer);
+        m_HighRam->SaveState(writer);
+        m_Cartridge->SaveState(writer);
+    }
+
     void Gameboy::_InitMemoryMapping()
     {
         // ROM
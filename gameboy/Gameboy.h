@@ -1,10 +1,13 @@
 #pragma once
 
 #include <memory>
+#include <span>
+#include <vector>
 
 #include "cpu/Cpu.h"
 #include "cpu/disassembler/Disassembler.h"
 #include "io/graphics/Ppu.h"
+#include "io/scheduler/Scheduler.h"
 #include "util/Class.h"
 
 namespace GBE
@@ -19,26 +22,70 @@ namespace GBE
     class InterruptManager;
     class Ram;
     class Timer;
-    class InstructionDecoder;
     class Joypad;
 
+    class StateWriter;
+    class StateReader;
+
+    constexpr uint32_t FRAME_CYCLES = FRAME_DOTS / DOT_TO_M_CYCLE;
+
     class Gameboy
     {
     public:
         GBE_CLASS_NO_COPY_NO_MOVE(Gameboy)
         
-        Gameboy();
+        Gameboy(PpuRenderer renderer = PpuRenderer::FIFO);
         ~Gameboy();
 
         void Start(std::shared_ptr<Cartridge> cartridge);
         uint16_t Tick();
         void Stop();
 
+        // save states are little-endian: magic, version and size of the state, then every component
+        // they are taken between two ticks and only hold the mutable state, not the rom or the settings
+        static constexpr uint32_t STATE_MAGIC = 0x53454247; // "GBES"
+        static constexpr uint32_t STATE_VERSION = 2;
+
+        // bytes needed to save the current state, the same for every state of a rom
+        size_t GetStateSize() const;
+        // write the state to buffer, returns its size or 0 if the buffer is too small
+        size_t SaveState(std::span<uint8_t> buffer) const;
+        // restore a state saved with the same rom, returns false if it isn't a valid state
+        bool LoadState(std::span<const uint8_t> buffer);
+
+        // frames run without input by Start before it takes the reset snapshot
+        inline void SetResetWarmupFrames(uint32_t frames)
+        {
+            m_ResetWarmupFrames = frames;
+        }
+
+        inline uint32_t GetResetWarmupFrames() const
+        {
+            return m_ResetWarmupFrames;
+        }
+
+        // use the current state as the reset snapshot
+        void CaptureResetSnapshot();
+        // restore the reset snapshot, taken by Start after the warmup frames or by CaptureResetSnapshot
+        // unlike Stop / Start the memory mapping is kept and only the state is loaded
+        void Reset();
+
+        // copy of this running gameboy, sharing its cartridge and with the same settings and reset snapshot
+        std::unique_ptr<Gameboy> Clone() const;
+        // turn this gameboy into a copy of the running gameboy other, the renderer is kept
+        // the cartridge is shared, the state and the reset snapshot copied, nothing is allocated once it runs the cartridge of other
+        void CopyFrom(const Gameboy& other);
+
         inline bool IsRunning() const noexcept
         {
             return m_IsRunning;
         }
 
+        inline const std::shared_ptr<Cartridge>& GetCartridge() const noexcept
+        {
+            return m_Cartridge;
+        }
+
         inline Ppu& GetPpu() noexcept
         {
             return *m_Ppu;
@@ -59,6 +106,11 @@ namespace GBE
             return *m_Disassembler;
         }
 
+        inline Scheduler& GetScheduler() noexcept
+        {
+            return *m_Scheduler;
+        }
+
         inline Cpu& GetCpu() noexcept
         {
             return *m_Cpu;
@@ -75,7 +127,6 @@ namespace GBE
 
         std::unique_ptr<Cpu> m_Cpu = nullptr;
         std::unique_ptr<Disassembler> m_Disassembler = nullptr;
-        std::shared_ptr<InstructionDecoder> m_Decoder = nullptr;
 
         std::shared_ptr<Memory> m_Memory = nullptr;
 
@@ -93,7 +144,59 @@ namespace GBE
         std::shared_ptr<Joypad> m_Joypad = nullptr;
         std::shared_ptr<Timer> m_Timer = nullptr;
 
+        std::shared_ptr<Scheduler> m_Scheduler = nullptr;
+
+        // scheduler cycles at the start of the frame
+        uint64_t m_FrameStart = 0;
+        // scheduler cycles the ppu is ticked to
+        uint64_t m_PpuCycles = 0;
+        // scheduler cycles of the last event run
+        uint64_t m_EventCycles = 0;
+
+        // size of the states of the running rom
+        size_t m_StateSize = 0;
+
+        // state copied by CopyFrom
+        std::vector<uint8_t> m_CopyState{};
+
+        // state restored by Reset
+        std::vector<uint8_t> m_ResetState{};
+        uint32_t m_ResetWarmupFrames = 0;
+
+        // power on with cartridge, without the warmup frames and the reset snapshot of Start
+        void _Start(const std::shared_ptr<Cartridge>& cartridge);
         void _InitMemoryMapping();
+
+        // header and components of the state
+        void _SaveState(StateWriter& writer, uint32_t size) const;
+
+        inline bool _IsFrameDone() const
+        {
+            return m_Scheduler->GetCycles() - m_FrameStart >= FRAME_CYCLES;
+        }
+
+        // advance the clock by cycles and run the due events
+        void _StepHardware(uint16_t cycles);
+        void _RunEvents();
+
+        // halted cpu with no interrupt pending, waiting for the next event
+        bool _IsHaltedUntilEvent() const;
+        // cycles until the halted cpu can wake up
+        uint16_t _GetHaltedCycles() const;
+
+        // iterations of a busy-wait loop that end before the next event or the end of the frame
+        uint32_t _GetIdleLoopIterations(uint32_t iterationCycles) const;
+
+        // hardware step of the cpu jit blocks
+        bool _StepBlockInstruction(uint16_t cycles);
+
+        // tick the ppu to the scheduler clock
+        void _SyncPpu();
+        // sync the ppu and schedule its next work
+        void _UpdatePpu();
+        void _UpdateDMA();
+        void _UpdateInput();
+
         void _CpuTick();
     };
 } // namespace GBE
@@ -0,0 +1,409 @@
+#include "RewindBuffer.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <utility>
+
+#include "Gameboy.h"
+#include "io/joypad/Joypad.h"
+#include "util/Assert.h"
+
+namespace GBE
+{
+    namespace
+    {
+        constexpr std::array<JoypadButton, 8> REWIND_BUTTONS = {
+            JoypadButton::A,
+            JoypadButton::B,
+            JoypadButton::SELECT,
+            JoypadButton::START,
+            JoypadButton::RIGHT,
+            JoypadButton::LEFT,
+            JoypadButton::UP,
+            JoypadButton::DOWN
+        };
+
+        // shorter unchanged runs are kept inside the changed run, a new run costs its two sizes
+        constexpr size_t MIN_UNCHANGED_RUN = 8;
+
+        // bytes equal at the start of a and b, compared a word at a time
+        size_t CountEqual(const uint8_t* a, const uint8_t* b, size_t size)
+        {
+            size_t count = 0;
+            while (count + sizeof(uint64_t) <= size)
+            {
+                uint64_t wordA, wordB;
+                std::memcpy(&wordA, a + count, sizeof(uint64_t));
+                std::memcpy(&wordB, b + count, sizeof(uint64_t));
+
+                uint64_t diff = wordA ^ wordB;
+                if (diff != 0)
+                {
+                    if constexpr (std::endian::native == std::endian::little)
+                        return count + std::countr_zero(diff) / 8;
+                    else
+                        return count + std::countl_zero(diff) / 8;
+                }
+
+                count += sizeof(uint64_t);
+            }
+
+            while (count < size && a[count] == b[count])
+                count++;
+
+            return count;
+        }
+
+        inline void WriteSize(uint8_t* data, size_t& offset, size_t value)
+        {
+            while (value >= 0x80)
+            {
+                data[offset++] = static_cast<uint8_t>(value) | 0x80;
+                value >>= 7;
+            }
+            data[offset++] = static_cast<uint8_t>(value);
+        }
+
+        inline size_t ReadSize(const uint8_t* data, size_t& offset)
+        {
+            size_t value = 0;
+            uint32_t shift = 0;
+            uint8_t byte;
+            do
+            {
+                byte = data[offset++];
+                value |= static_cast<size_t>(byte & 0x7F) << shift;
+                shift += 7;
+            } while (byte & 0x80);
+
+            return value;
+        }
+    } // namespace
+
+    RewindBuffer::RewindBuffer(size_t capacity, uint32_t interval):
+        m_Interval(interval)
+    {
+        GBE_ASSERT(m_Interval > 0);
+        GBE_ASSERT(capacity <= UINT32_MAX);
+
+        m_Ring.resize(capacity);
+        // inputs of the frames since the newest snapshot plus the ones of the snapshot dropped by StepBack
+        m_PendingInputs.resize(2 * m_Interval);
+    }
+
+    void RewindBuffer::Push(Gameboy& gameboy)
+    {
+        if (!gameboy.IsRunning())
+            return;
+
+        if (gameboy.GetCartridge().get() != m_Cartridge)
+        {
+            Clear();
+            m_Cartridge = gameboy.GetCartridge().get();
+
+            // the state size only depends on the rom
+            _Resize(gameboy.GetStateSize());
+        }
+
+        m_Position++;
+        GBE_ASSERT(m_PendingCount < m_PendingInputs.size());
+        m_PendingInputs[m_PendingCount++] = _GetInputs(gameboy.GetJoypad());
+
+        if (m_Count > 0 && m_PendingCount < m_Interval)
+            return;
+
+        _PushSnapshot(gameboy);
+    }
+
+    void RewindBuffer::_PushSnapshot(const Gameboy& gameboy)
+    {
+        gameboy.SaveState(m_State);
+
+        SnapshotHeader header{
+            .Position = m_Position,
+            .InputsCount = static_cast<uint32_t>(m_PendingCount),
+            .DeltaSize = m_Count > 0 ? static_cast<uint32_t>(_EncodeDelta(m_State, m_Latest, m_Delta)) : 0
+        };
+        header.Size = sizeof(SnapshotHeader) + header.InputsCount + header.DeltaSize;
+
+        // too big for the whole ring, start over from this snapshot
+        if (header.Size > m_Ring.size())
+        {
+            m_Head = m_Tail = m_WrapEnd = m_Newest = m_Count = 0;
+            m_IsWrapped = false;
+
+            header.DeltaSize = 0;
+            header.Size = sizeof(SnapshotHeader) + header.InputsCount;
+        }
+
+        size_t offset = _Allocate(header.Size);
+        header.Previous = static_cast<uint32_t>(m_Count > 0 ? m_Newest : offset);
+        _WriteHeader(offset, header);
+
+        uint8_t* data = m_Ring.data() + offset + sizeof(SnapshotHeader);
+        std::memcpy(data, m_PendingInputs.data(), header.InputsCount);
+        std::memcpy(data + header.InputsCount, m_Delta.data(), header.DeltaSize);
+
+        m_Newest = offset;
+        m_Count++;
+
+        std::swap(m_Latest, m_State);
+        m_LatestPosition = m_Position;
+        m_PendingCount = 0;
+    }
+
+    bool RewindBuffer::StepBack(Gameboy& gameboy)
+    {
+        if (!gameboy.IsRunning() || gameboy.GetCartridge().get() != m_Cartridge || m_Count == 0)
+            return false;
+
+        // the frame before is re-emulated from an older snapshot, so the frame it draws is presented
+        const uint64_t target = m_Position - 1;
+        while (m_LatestPosition >= target)
+        {
+            if (m_Count < 2)
+                return false;
+
+            SnapshotHeader header = _ReadHeader(m_Newest);
+            const uint8_t* data = m_Ring.data() + m_Newest + sizeof(SnapshotHeader);
+
+            // inputs of the snapshot frames go before the pending ones
+            GBE_ASSERT(m_PendingCount + header.InputsCount <= m_PendingInputs.size());
+            std::memmove(m_PendingInputs.data() + header.InputsCount, m_PendingInputs.data(), m_PendingCount);
+            std::memcpy(m_PendingInputs.data(), data, header.InputsCount);
+            m_PendingCount += header.InputsCount;
+
+            _ApplyDelta(std::span(data + header.InputsCount, header.DeltaSize), m_Latest);
+            m_LatestPosition = header.Position - header.InputsCount;
+            _PopNewest();
+        }
+
+        if (!gameboy.LoadState(m_Latest))
+            return false;
+
+        Joypad& joypad = gameboy.GetJoypad();
+        m_PendingCount = target - m_LatestPosition;
+        for (size_t frame = 0; frame < m_PendingCount; frame++)
+        {
+            _SetInputs(joypad, m_PendingInputs[frame]);
+            gameboy.Tick();
+        }
+
+        m_Position = target;
+
+        // the popped snapshot is taken again, so no snapshot holds more than interval frames of inputs
+        if (m_PendingCount >= m_Interval)
+            _PushSnapshot(gameboy);
+
+        return true;
+    }
+
+    void RewindBuffer::Clear()
+    {
+        m_Head = m_Tail = m_WrapEnd = m_Newest = m_Count = 0;
+        m_IsWrapped = false;
+
+        m_Cartridge = nullptr;
+        m_Position = 0;
+        m_LatestPosition = 0;
+        m_PendingCount = 0;
+    }
+
+    uint64_t RewindBuffer::GetFramesCount() const
+    {
+        if (m_Count == 0)
+            return 0;
+
+        uint64_t oldest = _ReadHeader(m_Head).Position;
+        return m_Position > oldest ? m_Position - oldest - 1 : 0;
+    }
+
+    size_t RewindBuffer::GetUsedSize() const
+    {
+        if (m_Count == 0)
+            return 0;
+
+        if (m_IsWrapped)
+            return m_WrapEnd - m_Head + m_Tail;
+
+        return m_Tail - m_Head;
+    }
+
+    void RewindBuffer::_Resize(size_t stateSize)
+    {
+        m_Latest.resize(stateSize);
+        m_State.resize(stateSize);
+        // worst case: every changed run is followed by MIN_UNCHANGED_RUN bytes and costs two sizes of 5 bytes
+        m_Delta.resize(2 * stateSize + 32);
+    }
+
+    RewindBuffer::SnapshotHeader RewindBuffer::_ReadHeader(size_t offset) const
+    {
+        SnapshotHeader header{};
+        std::memcpy(&header, m_Ring.data() + offset, sizeof(SnapshotHeader));
+        return header;
+    }
+
+    void RewindBuffer::_WriteHeader(size_t offset, const SnapshotHeader& header)
+    {
+        std::memcpy(m_Ring.data() + offset, &header, sizeof(SnapshotHeader));
+    }
+
+    size_t RewindBuffer::_Allocate(size_t size)
+    {
+        GBE_ASSERT(size <= m_Ring.size());
+
+        while (true)
+        {
+            if (!m_IsWrapped)
+            {
+                if (m_Tail + size <= m_Ring.size())
+                    break;
+
+                // continue at the start of the ring, the end is left unused
+                m_WrapEnd = m_Tail;
+                m_Tail = 0;
+                if (m_Count == 0)
+                {
+                    m_Head = 0;
+                    continue;
+                }
+
+                m_IsWrapped = true;
+            }
+
+            if (m_Tail + size <= m_Head)
+                break;
+
+            _PopOldest();
+        }
+
+        size_t offset = m_Tail;
+        m_Tail += size;
+        return offset;
+    }
+
+    void RewindBuffer::_PopOldest()
+    {
+        m_Head += _ReadHeader(m_Head).Size;
+        m_Count--;
+
+        if (m_Count == 0)
+        {
+            m_Head = m_Tail = 0;
+            m_IsWrapped = false;
+        }
+        else if (m_IsWrapped && m_Head >= m_WrapEnd)
+        {
+            m_Head = 0;
+            m_IsWrapped = false;
+        }
+    }
+
+    void RewindBuffer::_PopNewest()
+    {
+        m_Tail = m_Newest;
+        m_Newest = _ReadHeader(m_Newest).Previous;
+        m_Count--;
+
+        if (m_Count == 0)
+        {
+            m_Head = m_Tail = 0;
+            m_IsWrapped = false;
+        }
+        else if (m_IsWrapped && m_Tail == 0)
+        {
+            // no snapshot left at the start of the ring
+            m_Tail = m_WrapEnd;
+            m_IsWrapped = false;
+        }
+    }
+
+    size_t RewindBuffer::_EncodeDelta(std::span<const uint8_t> state, std::span<const uint8_t> previous, std::span<uint8_t> delta)
+    {
+        GBE_ASSERT(state.size() == previous.size());
+
+        const uint8_t* a = state.data();
+        const uint8_t* b = previous.data();
+        const size_t size = state.size();
+
+        size_t position = 0;
+        size_t deltaSize = 0;
+        while (position < size)
+        {
+            size_t unchanged = CountEqual(a + position, b + position, size - position);
+            if (position + unchanged == size)
+                break;
+
+            // the changed run ends on a long enough unchanged run or at the end of the state
+            size_t start = position + unchanged;
+            size_t end = start;
+            while (end < size)
+            {
+                if (a[end] != b[end])
+                {
+                    end++;
+                    continue;
+                }
+
+                size_t equal = CountEqual(a + end, b + end, size - end);
+                if (equal >= MIN_UNCHANGED_RUN || end + equal == size)
+                    break;
+
+                end += equal;
+            }
+
+            GBE_ASSERT(deltaSize + 10 + end - start <= delta.size());
+            WriteSize(delta.data(), deltaSize, unchanged);
+            WriteSize(delta.data(), deltaSize, end - start);
+            for (size_t i = start; i < end; i++)
+                delta[deltaSize++] = a[i] ^ b[i];
+
+            position = end;
+        }
+
+        return deltaSize;
+    }
+
+    void RewindBuffer::_ApplyDelta(std::span<const uint8_t> delta, std::span<uint8_t> state)
+    {
+        size_t offset = 0;
+        size_t position = 0;
+        while (offset < delta.size())
+        {
+            position += ReadSize(delta.data(), offset);
+            size_t changed = ReadSize(delta.data(), offset);
+            GBE_ASSERT(position + changed <= state.size());
+
+            for (size_t i = 0; i < changed; i++)
+                state[position + i] ^= delta[offset + i];
+
+            offset += changed;
+            position += changed;
+        }
+    }
+
+    uint8_t RewindBuffer::_GetInputs(const Joypad& joypad)
+    {
+        uint8_t inputs = 0;
+        for (size_t i = 0; i < REWIND_BUTTONS.size(); i++)
+        {
+            if (joypad.IsPressed(REWIND_BUTTONS[i]))
+                inputs |= 1 << i;
+        }
+
+        return inputs;
+    }
+
+    void RewindBuffer::_SetInputs(Joypad& joypad, uint8_t inputs)
+    {
+        for (size_t i = 0; i < REWIND_BUTTONS.size(); i++)
+        {
+            bool isPressed = (inputs >> i) & 1;
+            if (joypad.IsPressed(REWIND_BUTTONS[i]) != isPressed)
+                joypad.QueueJoypadEvent(JoypadEvent{.Button = REWIND_BUTTONS[i], .Pressed = isPressed});
+        }
+    }
+} // namespace GBE
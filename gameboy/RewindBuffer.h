@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "util/Class.h"
+
+namespace GBE
+{
+    class Gameboy;
+    class Cartridge;
+    class Joypad;
+
+    // rewind history of a running gameboy in a fixed size ring
+    // a snapshot is taken every interval frames and stored as the xor with the previous one, run length encoded,
+    // the newest snapshot is kept whole so stepping back applies the deltas from the newest to the oldest
+    // frames between two snapshots are re-emulated with the recorded joypad state
+    class RewindBuffer
+    {
+    public:
+        GBE_CLASS_NO_COPY_NO_MOVE(RewindBuffer)
+
+        RewindBuffer(size_t capacity, uint32_t interval = 1);
+        ~RewindBuffer() = default;
+
+        // record the frame just ticked, called after every Gameboy::Tick
+        // the history is cleared if the gameboy runs another rom
+        void Push(Gameboy& gameboy);
+
+        // go back one frame, false if there is no older frame
+        bool StepBack(Gameboy& gameboy);
+
+        void Clear();
+
+        // frames StepBack can go back
+        uint64_t GetFramesCount() const;
+
+        inline size_t GetSnapshotsCount() const
+        {
+            return m_Count;
+        }
+
+        // bytes of the ring used by the snapshots
+        size_t GetUsedSize() const;
+
+        inline size_t GetCapacity() const
+        {
+            return m_Ring.size();
+        }
+
+        inline uint32_t GetInterval() const
+        {
+            return m_Interval;
+        }
+
+    private:
+        // stored before the inputs and the delta of every snapshot
+        struct SnapshotHeader
+        {
+            uint32_t Size = 0;
+            uint32_t Previous = 0;
+            uint64_t Position = 0;
+            uint32_t InputsCount = 0;
+            uint32_t DeltaSize = 0;
+        };
+
+        uint32_t m_Interval = 1;
+
+        // snapshots from m_Head to m_Tail, when wrapped from m_Head to m_WrapEnd then from 0 to m_Tail
+        std::vector<uint8_t> m_Ring{};
+        size_t m_Head = 0;
+        size_t m_Tail = 0;
+        size_t m_WrapEnd = 0;
+        bool m_IsWrapped = false;
+        size_t m_Newest = 0;
+        size_t m_Count = 0;
+
+        const Cartridge* m_Cartridge = nullptr;
+
+        // frame the gameboy is at and frame of the newest snapshot
+        uint64_t m_Position = 0;
+        uint64_t m_LatestPosition = 0;
+
+        // whole state of the newest snapshot
+        std::vector<uint8_t> m_Latest{};
+        std::vector<uint8_t> m_State{};
+        std::vector<uint8_t> m_Delta{};
+
+        // joypad state of the frames after the newest snapshot
+        std::vector<uint8_t> m_PendingInputs{};
+        size_t m_PendingCount = 0;
+
+        void _Resize(size_t stateSize);
+
+        // snapshot of the current state with the pending inputs
+        void _PushSnapshot(const Gameboy& gameboy);
+
+        SnapshotHeader _ReadHeader(size_t offset) const;
+        void _WriteHeader(size_t offset, const SnapshotHeader& header);
+
+        // offset of size free bytes, drops the oldest snapshots to make room
+        size_t _Allocate(size_t size);
+        void _PopOldest();
+        void _PopNewest();
+
+        // xor of state and previous, as pairs of unchanged / changed runs, returns the encoded size
+        static size_t _EncodeDelta(std::span<const uint8_t> state, std::span<const uint8_t> previous, std::span<uint8_t> delta);
+        static void _ApplyDelta(std::span<const uint8_t> delta, std::span<uint8_t> state);
+
+        // one bit per button
+        static uint8_t _GetInputs(const Joypad& joypad);
+        static void _SetInputs(Joypad& joypad, uint8_t inputs);
+    };
+} // namespace GBE
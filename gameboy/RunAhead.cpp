@@ -0,0 +1,64 @@
+#include "RunAhead.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "Gameboy.h"
+
+namespace GBE
+{
+    // weight of the last time in the moving average, about half a second of frames
+    constexpr double AVERAGE_WEIGHT = 1.0 / 30.0;
+
+    RunAhead::RunAhead(uint32_t frames)
+    {
+        SetFrames(frames);
+    }
+
+    void RunAhead::SetFrames(uint32_t frames)
+    {
+        m_Frames = std::min(frames, MAX_FRAMES);
+        m_LastTime = 0.0;
+        m_AverageTime = 0.0;
+    }
+
+    uint16_t RunAhead::Tick(Gameboy& gameboy)
+    {
+        uint16_t cycles = gameboy.Tick();
+        if (m_Frames == 0 || !gameboy.IsRunning())
+            return cycles;
+
+        const auto startTime = std::chrono::steady_clock::now();
+
+        if (gameboy.SaveState(m_State) == 0)
+        {
+            m_State.resize(gameboy.GetStateSize());
+            gameboy.SaveState(m_State);
+        }
+
+        // the last frame ahead publishes the frame starting in it or in the frame before, only these two are drawn
+        Ppu& ppu = gameboy.GetPpu();
+        const bool isDrawOnRequest = ppu.IsDrawOnRequest();
+        ppu.SetDrawOnRequest(true);
+
+        for (uint32_t frame = 1; frame <= m_Frames; frame++)
+        {
+            if (frame + 1 >= m_Frames)
+                ppu.RequestFrame();
+
+            gameboy.Tick();
+        }
+
+        ppu.SetDrawOnRequest(isDrawOnRequest);
+        gameboy.LoadState(m_State);
+
+        const auto endTime = std::chrono::steady_clock::now();
+        m_LastTime = std::chrono::duration<double>(endTime - startTime).count();
+        if (m_AverageTime == 0.0)
+            m_AverageTime = m_LastTime;
+        else
+            m_AverageTime += (m_LastTime - m_AverageTime) * AVERAGE_WEIGHT;
+
+        return cycles;
+    }
+} // namespace GBE
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "util/Class.h"
+
+namespace GBE
+{
+    class Gameboy;
+
+    // hides the input lag of the games by showing frames ahead of the emulation
+    // every frame the gameboy runs its frame, saves its state, runs frames ahead with the same input and restores the state,
+    // only the last frames ahead are drawn and the screen keeps the last one published
+    class RunAhead
+    {
+    public:
+        GBE_CLASS_NO_COPY_NO_MOVE(RunAhead)
+
+        static constexpr uint32_t MAX_FRAMES = 3;
+        // duration of a gameboy frame
+        static constexpr double FRAME_TIME = 16.74e-3; // seconds
+
+        RunAhead(uint32_t frames = 1);
+        ~RunAhead() = default;
+
+        // frames run ahead, 0 disables run ahead
+        void SetFrames(uint32_t frames);
+
+        inline uint32_t GetFrames() const
+        {
+            return m_Frames;
+        }
+
+        // run the frame of gameboy then the frames ahead, returns the cycles of the frame like Gameboy::Tick
+        uint16_t Tick(Gameboy& gameboy);
+
+        // time spent saving, running ahead and restoring, in seconds
+        inline double GetLastTime() const
+        {
+            return m_LastTime;
+        }
+
+        // moving average of the time spent
+        inline double GetAverageTime() const
+        {
+            return m_AverageTime;
+        }
+
+        // share of a frame duration spent running ahead
+        inline double GetFrameBudgetUsage() const
+        {
+            return m_AverageTime / FRAME_TIME;
+        }
+
+    private:
+        uint32_t m_Frames = 1;
+
+        // state restored after running ahead, only reallocated when the state size grows
+        std::vector<uint8_t> m_State{};
+
+        double m_LastTime = 0.0;
+        double m_AverageTime = 0.0;
+    };
+} // namespace GBE
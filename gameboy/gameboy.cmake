@@ -1,7 +1,11 @@
 set (GBE_HEADERS ${GBE_HEADERS}
     ${CMAKE_CURRENT_LIST_DIR}/Gameboy.h
+    ${CMAKE_CURRENT_LIST_DIR}/RewindBuffer.h
+    ${CMAKE_CURRENT_LIST_DIR}/RunAhead.h
 )
 
 set(GBE_SOURCES ${GBE_SOURCES}
     ${CMAKE_CURRENT_LIST_DIR}/Gameboy.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/RewindBuffer.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/RunAhead.cpp
 )
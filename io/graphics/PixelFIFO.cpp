@@ -1,5 +1,8 @@
 #include "PixelFIFO.h"
 
+#include "util/StateWriter.h"
+#include "util/StateReader.h"
+
 #include <cassert>
 
 namespace GBE
@@ -9,6 +12,22 @@ namespace GBE
         Clear();
     }
 
+    void PixelFIFO::SaveState(StateWriter& writer) const
+    {
+        writer.WriteBytes(m_Pixels.data(), m_Pixels.size());
+        writer.Write(m_PopIndex);
+        writer.Write(m_PushIndex);
+        writer.Write(m_CurrentSize);
+    }
+
+    void PixelFIFO::LoadState(StateReader& reader)
+    {
+        reader.ReadBytes(m_Pixels.data(), m_Pixels.size());
+        reader.Read(m_PopIndex);
+        reader.Read(m_PushIndex);
+        reader.Read(m_CurrentSize);
+    }
+
     void PixelFIFO::PushBack(uint8_t pixel)
     {
         assert(m_CurrentSize < PIXEL_FIFO_SIZE);
@@ -7,6 +7,9 @@
 
 namespace GBE
 {
+    class StateWriter;
+    class StateReader;
+
     constexpr uint8_t PIXEL_FIFO_SIZE = TILE_SIZE * 2;
 
     class PixelFIFO
@@ -17,6 +20,9 @@ namespace GBE
 
         void Init();
 
+        void SaveState(StateWriter& writer) const;
+        void LoadState(StateReader& reader);
+
         void PushBack(uint8_t pixel);
         
         uint8_t PopFront();
@@ -1,5 +1,6 @@
 #include "Ppu.h"
 
+#include <algorithm>
 #include <iostream>
 #include <magic_enum.hpp>
 
@@ -8,8 +9,12 @@
 #include "lcd/LcdControl.h"
 #include "lcd/LcdPalettesMemory.h"
 #include "vram/Vram.h"
+#include "vram/TileDecoder.h"
 #include "oam/ObjectAttributesMemory.h"
 
+#include "util/StateWriter.h"
+#include "util/StateReader.h"
+
 namespace GBE
 {
     Ppu::Ppu(
@@ -17,8 +22,10 @@ namespace GBE
         const std::shared_ptr<ObjectAttributesMemory> &oam, 
         const std::shared_ptr<LcdPalettesMemory> &palettes, 
         const std::shared_ptr<LcdControl> &lcdControl, 
-        const std::shared_ptr<InterruptManager> &interruptManager
+        const std::shared_ptr<InterruptManager> &interruptManager,
+        PpuRenderer renderer
     ):
+        m_Renderer(renderer),
         m_Vram(vram),
         m_Oam(oam),
         m_Palettes(palettes),
@@ -39,22 +46,100 @@ namespace GBE
         m_QueuePpuMode = PpuMode::OAM_SCAN;
         m_PpuMode = PpuMode::H_BLANK;
 
+        m_SkippedFrames = 0;
+        m_IsFrameRequested = false;
+        m_IsDrawingFrame = true;
+
         m_ObjectFIFO.Init();
         m_BackgroundFIFO.Init();
     }
 
+    void Ppu::SaveState(StateWriter& writer) const
+    {
+        writer.Write(m_FrameCounter);
+        writer.Write(m_DotsCounter);
+        writer.Write(m_LineDotsCounter);
+        writer.Write(m_WaitDots);
+        writer.Write(m_HBlankWaitDots);
+        writer.Write(m_PpuMode);
+        writer.Write(m_QueuePpuMode);
+
+        m_Screen->SaveState(writer);
+        writer.Write(m_LcdX);
+        writer.Write(m_LcdY);
+        writer.Write(m_IsRendering);
+        writer.Write(m_SkippedFrames);
+        writer.Write(m_IsFrameRequested);
+        writer.Write(m_IsDrawingFrame);
+
+        m_ObjectFIFO.SaveState(writer);
+        m_BackgroundFIFO.SaveState(writer);
+        writer.Write(m_TileY);
+        writer.Write(m_TileX);
+        writer.Write(m_TileOffsetY);
+        writer.Write(m_TileOffsetX);
+        writer.Write(m_WindowInternalY);
+        writer.Write(m_IsOnWindow);
+        writer.Write(m_VBlankInterrupt);
+
+        writer.WriteBytes(m_LineObjects.IDs.data(), m_LineObjects.IDs.size());
+        writer.Write(m_LineObjects.Count);
+        writer.Write(m_NextLineObject);
+    }
+
+    void Ppu::LoadState(StateReader& reader)
+    {
+        reader.Read(m_FrameCounter);
+        reader.Read(m_DotsCounter);
+        reader.Read(m_LineDotsCounter);
+        reader.Read(m_WaitDots);
+        reader.Read(m_HBlankWaitDots);
+        reader.Read(m_PpuMode);
+        reader.Read(m_QueuePpuMode);
+
+        m_Screen->LoadState(reader);
+        reader.Read(m_LcdX);
+        reader.Read(m_LcdY);
+        reader.Read(m_IsRendering);
+        reader.Read(m_SkippedFrames);
+        reader.Read(m_IsFrameRequested);
+        reader.Read(m_IsDrawingFrame);
+
+        m_ObjectFIFO.LoadState(reader);
+        m_BackgroundFIFO.LoadState(reader);
+        reader.Read(m_TileY);
+        reader.Read(m_TileX);
+        reader.Read(m_TileOffsetY);
+        reader.Read(m_TileOffsetX);
+        reader.Read(m_WindowInternalY);
+        reader.Read(m_IsOnWindow);
+        reader.Read(m_VBlankInterrupt);
+
+        reader.ReadBytes(m_LineObjects.IDs.data(), m_LineObjects.IDs.size());
+        reader.Read(m_LineObjects.Count);
+        reader.Read(m_NextLineObject);
+    }
+
     void Ppu::Tick(uint32_t dots)
     {
         if (!m_LcdControl->GetControlFlag(LcdControlFlag::LCD_PPU_ENABLE))
             return;
-        for (uint32_t i = 0; i < dots; i++)
+        uint32_t dot = 0;
+        while (dot < dots)
         {
-            m_LineDotsCounter++;
-            if (m_WaitDots > 0)
-                m_WaitDots--;
-
-            if (m_WaitDots > 0)
+            // dots waiting for the current mode only advance the counters
+            if (m_WaitDots > 1)
+            {
+                uint32_t idleDots = std::min(m_WaitDots - 1, dots - dot);
+                m_LineDotsCounter += idleDots;
+                m_WaitDots -= idleDots;
+                dot += idleDots;
                 continue;
+            }
+
+            dot++;
+            m_LineDotsCounter++;
+            m_WaitDots = 0;
             
             _Render();
             
@@ -116,20 +201,13 @@ namespace GBE
         m_Oam->SetReadWriteFlags(false);
         m_Vram->SetReadWriteFlags(true);
         
-        // fetch objects
-        m_LineObjects.clear();
-        for (uint8_t objectID = 0; objectID < OBJECT_COUNT; objectID++)
-        {
-            const auto& obj = m_Oam->GetObject(objectID);
-            uint8_t objY = obj.GetYPosition();
-            uint8_t objSize = TILE_SIZE * m_LcdControl->GetObjectSize();
-            const uint8_t maxObjSize = 2 * TILE_SIZE;
+        // pick if the frame is drawn on its first line
+        if (m_LcdY == 0)
+            m_IsDrawingFrame = _IsFrameDrawn();
 
-            if (m_LcdY + maxObjSize >= objY && m_LcdY + maxObjSize < objY + objSize)
-            {
-                m_LineObjects.push_back(objectID);
-            }
-        }
+        // fetch objects
+        m_LineObjects = m_Oam->GetLineObjects(m_LcdY, m_LcdControl->GetObjectSize());
+        m_NextLineObject = 0;
 
         // queue next mode
         m_WaitDots = OAM_SCAN_DOTS;
@@ -139,6 +217,18 @@ namespace GBE
 
     void Ppu::_DrawingPixels()
     {
+        if (!m_IsDrawingFrame)
+        {
+            _SkipLine();
+            return;
+        }
+
+        if (m_Renderer == PpuRenderer::SCANLINE)
+        {
+            _DrawLine();
+            return;
+        }
+
         m_Vram->SetReadWriteFlags(false);
         m_Palettes->SetReadWriteFlags(false);
         m_Oam->SetReadWriteFlags(false);
@@ -178,6 +268,25 @@ namespace GBE
         }
     }
 
+    bool Ppu::_IsFrameDrawn()
+    {
+        if (m_IsDrawOnRequest)
+        {
+            bool isRequested = m_IsFrameRequested;
+            m_IsFrameRequested = false;
+            return isRequested;
+        }
+
+        if (m_SkippedFrames < m_FrameSkip)
+        {
+            m_SkippedFrames++;
+            return false;
+        }
+
+        m_SkippedFrames = 0;
+        return true;
+    }
+
     void Ppu::_HorizontalBlank()
     {
         m_Vram->SetReadWriteFlags(true);
@@ -193,6 +302,12 @@ namespace GBE
 
         if (m_LcdY >= LCD_SCREEN_HEIGHT)
         {
+            if (m_IsDrawingFrame)
+            {
+                m_FrameBuffer.Publish();
+                m_Screen = &m_FrameBuffer.GetBackScreen();
+            }
+
             m_QueuePpuMode = PpuMode::V_BLANK;
             m_VBlankInterrupt = true;
             m_LineDotsCounter = 0;
@@ -258,7 +373,7 @@ namespace GBE
         if (objectColor)
             color = objectColor;
 
-        m_Screen.SetPixel(m_LcdX, m_LcdY, color);
+        m_Screen->SetPixel(m_LcdX, m_LcdY, color);
         m_LcdX++;
         m_WaitDots += 1;
     }
@@ -278,19 +393,13 @@ namespace GBE
         uint8_t tileID = bgMap.Get(tileIndex);
 
         bool addressMode = m_LcdControl->GetControlFlag(LcdControlFlag::BG_WINDOW_TILES);
-        const auto &tile = m_Vram->GetTileBGWin(tileID, addressMode);
-
-        uint8_t y = m_TileOffsetY;
-        for (uint8_t x = 0; x < TILE_SIZE; x++)
-        {
-            uint8_t colorIndex = tile.GetPixel(x, y);
-
-            // apply color pallette
-            const auto &bgPalette = m_Palettes->GetBackgroundPalette();
-            uint8_t color = static_cast<uint8_t>(bgPalette.GetColor(colorIndex));
+        const TileRow& row = m_Vram->GetTilePixelsBGWin(tileID, addressMode).GetRow(m_TileOffsetY, false);
 
+        // apply color pallette
+        std::array<uint8_t, TILE_SIZE> colors{};
+        TileDecoder::MapColors(row.data(), TILE_SIZE, m_Palettes->GetBackgroundPalette().Get(), colors.data());
+        for (uint8_t color: colors)
             m_BackgroundFIFO.PushBack(color);
-        }
 
         m_TileX++;
     }
@@ -302,16 +411,22 @@ namespace GBE
             return;
         }
 
-        for (auto objectID: m_LineObjects)
+        // objects are sorted by x, fetch the ones starting at this pixel
+        const uint8_t objSize = m_LcdControl->GetObjectSize() * TILE_SIZE;
+        while (m_NextLineObject < m_LineObjects.Count)
         {
-            // check obj pos
-            const auto& obj = m_Oam->GetObject(objectID);
-            if (obj.GetXPosition() != m_LcdX + TILE_SIZE)
+            const auto& obj = m_Oam->GetObject(m_LineObjects.IDs[m_NextLineObject]);
+            uint8_t objX = obj.GetXPosition();
+            if (objX > m_LcdX + TILE_SIZE)
+                return;
+
+            m_NextLineObject++;
+
+            // hidden, or already passed when objects were disabled
+            if (objX == 0 || (m_LcdX > 0 && objX < m_LcdX + TILE_SIZE))
                 continue;
 
             // get obj y info
-            const uint8_t objSize = m_LcdControl->GetObjectSize() * TILE_SIZE;
-
             uint8_t y = (m_LcdY + (2 * TILE_SIZE) - obj.GetYPosition());
             if (obj.GetYFlip())
                 y = objSize - 1 - y;
@@ -328,33 +443,198 @@ namespace GBE
                 objTileID++;
 
             //
-            const auto& tile = m_Vram->GetObject(objTileID);
-            uint8_t paletteID = obj.GetDMGPalette();
+            const TileRow& row = m_Vram->GetObjectPixels(objTileID).GetRow(y % TILE_SIZE, obj.GetXFlip());
 
-            // copy obj to object fifo
+            // apply color pallette
+            std::array<uint8_t, TILE_SIZE> colors{};
+            TileDecoder::MapColors(row.data(), TILE_SIZE, m_Palettes->GetObjectPalette(obj.GetDMGPalette()).Get(), colors.data());
+
+            // copy obj to object fifo, objects left of the screen lose their first pixels
             m_ObjectFIFO.Resize(TILE_SIZE, 0);
 
-            for (uint8_t x = 0; x < TILE_SIZE; x++)
+            uint8_t offset = m_LcdX + TILE_SIZE - objX;
+            for (uint8_t x = offset; x < TILE_SIZE; x++)
             {
-                if (m_ObjectFIFO.Get(x) != 0)
-                    continue;
-                
-                uint8_t localX = x;
-                if (obj.GetXFlip())
-                    localX = TILE_SIZE - localX - 1;
-                
-                uint8_t localY = y % TILE_SIZE;
-                // apply color pallette
-                uint8_t colorIndex = tile.GetPixel(localX, localY);
-
-                const auto &objPalette = m_Palettes->GetObjectPalette(paletteID);
-                uint8_t color = static_cast<uint8_t>(objPalette.GetColor(colorIndex));
-
-                m_ObjectFIFO.Set(x, color);
+                if (m_ObjectFIFO.Get(x - offset) == 0)
+                    m_ObjectFIFO.Set(x - offset, colors[x]);
             }
 
             m_WaitDots += 6;
-            return;
         }
     }
+
+    void Ppu::_DrawLine()
+    {
+        m_Vram->SetReadWriteFlags(false);
+        m_Palettes->SetReadWriteFlags(false);
+        m_Oam->SetReadWriteFlags(false);
+
+        LineSteps waitDots{};
+        uint32_t windowStartX = _GetLineSteps(waitDots);
+        m_IsOnWindow = windowStartX < LCD_SCREEN_WIDTH;
+
+        std::array<uint8_t, LCD_SCREEN_WIDTH + TILE_SIZE> objects{};
+        bool isObjectEnabled = m_LcdControl->GetControlFlag(LcdControlFlag::OBJ_ENABLE);
+        if (isObjectEnabled)
+            _FetchLineObjects(objects);
+
+        // background and window
+        bool isBackgroundEnabled = m_LcdControl->GetControlFlag(LcdControlFlag::BG_WINDOW_ENABLE);
+        uint8_t viewportX = m_LcdControl->GetViewportX();
+        uint8_t backgroundY = m_LcdY + m_LcdControl->GetViewportY();
+
+        std::array<uint8_t, TILE_SIZE> tileColors{};
+        for (uint32_t x = 0; x < LCD_SCREEN_WIDTH; x++)
+        {
+            uint8_t color = 0;
+            if (isBackgroundEnabled)
+            {
+                bool isWindow = x >= windowStartX;
+
+                // the fine scroll is dropped from the window when it starts on the first pixel
+                uint8_t mapX = viewportX + x;
+                if (isWindow)
+                    mapX = x - windowStartX + (windowStartX == 0 ? viewportX % TILE_SIZE : 0);
+
+                if (x == 0 || x == windowStartX || mapX % TILE_SIZE == 0)
+                {
+                    if (isWindow)
+                        _FetchTileRow(m_LcdControl->GetWindowTileMapID(), mapX / TILE_SIZE, m_WindowInternalY, tileColors);
+                    else
+                        _FetchTileRow(m_LcdControl->GetBackgroundTileMapID(), mapX / TILE_SIZE, backgroundY, tileColors);
+                }
+
+                color = tileColors[mapX % TILE_SIZE];
+            }
+
+            if (isObjectEnabled && objects[x])
+                color = objects[x];
+
+            m_Screen->SetPixel(x, m_LcdY, color);
+        }
+
+        _WaitLineSteps(waitDots);
+    }
+
+    void Ppu::_SkipLine()
+    {
+        m_Vram->SetReadWriteFlags(false);
+        m_Palettes->SetReadWriteFlags(false);
+        m_Oam->SetReadWriteFlags(false);
+
+        LineSteps waitDots{};
+        m_IsOnWindow = _GetLineSteps(waitDots) < LCD_SCREEN_WIDTH;
+
+        // no pixels are left for the next line
+        m_ObjectFIFO.Clear();
+
+        _WaitLineSteps(waitDots);
+    }
+
+    uint32_t Ppu::_GetLineSteps(LineSteps& waitDots) const
+    {
+        // dots of each fifo step, one per pixel plus the window and object fetches
+        waitDots.fill(1);
+
+        // the fifo switches to the window on the first pixel with x + 7 >= WX
+        uint32_t windowStartX = LCD_SCREEN_WIDTH;
+        if (m_LcdControl->GetControlFlag(LcdControlFlag::WINDOW_ENABLE) && m_LcdY >= m_LcdControl->GetWindowY())
+        {
+            uint32_t windowX = m_LcdControl->GetWindowX();
+            windowStartX = windowX > 7 ? windowX - 7 : 0;
+        }
+
+        if (windowStartX < LCD_SCREEN_WIDTH)
+            waitDots[windowStartX] += 6;
+
+        if (!m_LcdControl->GetControlFlag(LcdControlFlag::OBJ_ENABLE))
+            return windowStartX;
+
+        // objects are fetched in x order at X = x + 8, or on the first pixel if X < 8
+        for (auto objectID: m_LineObjects)
+        {
+            uint32_t objX = m_Oam->GetObject(objectID).GetXPosition();
+            if (objX == 0 || objX >= LCD_SCREEN_WIDTH + TILE_SIZE)
+                continue;
+
+            waitDots[objX > TILE_SIZE ? objX - TILE_SIZE : 0] += 6;
+        }
+
+        return windowStartX;
+    }
+
+    void Ppu::_WaitLineSteps(const LineSteps& waitDots)
+    {
+        m_LcdX = LCD_SCREEN_WIDTH;
+
+        // hblank is timed from the start of the last step, as in the fifo
+        uint32_t drawDots = 0;
+        for (uint32_t dots: waitDots)
+            drawDots += dots;
+
+        m_WaitDots = drawDots;
+        m_HBlankWaitDots = RENDER_LINE_DOTS - (m_LineDotsCounter + drawDots - waitDots.back());
+        m_QueuePpuMode = PpuMode::H_BLANK;
+    }
+
+    void Ppu::_FetchTileRow(uint8_t tileMapID, uint8_t tileX, uint8_t y, std::array<uint8_t, TILE_SIZE>& colors) const
+    {
+        const TileMap &map = m_Vram->GetTileMap(tileMapID);
+        uint32_t tileIndex = (tileX % TILE_MAP_SIZE + (y / TILE_SIZE) * TILE_MAP_SIZE) % TILE_MAP_VRAM_SIZE;
+
+        bool addressMode = m_LcdControl->GetControlFlag(LcdControlFlag::BG_WINDOW_TILES);
+        const TileRow& row = m_Vram->GetTilePixelsBGWin(map.Get(tileIndex), addressMode).GetRow(y % TILE_SIZE, false);
+        TileDecoder::MapColors(row.data(), TILE_SIZE, m_Palettes->GetBackgroundPalette().Get(), colors.data());
+    }
+
+    void Ppu::_FetchLineObjects(std::array<uint8_t, LCD_SCREEN_WIDTH + TILE_SIZE>& objects)
+    {
+        // pixels left in the object fifo by the previous line
+        uint32_t objectsEnd = m_ObjectFIFO.GetCurrentSize();
+        for (uint32_t x = 0; x < objectsEnd; x++)
+            objects[x] = m_ObjectFIFO.Get(x);
+
+        // objects are fetched in x order at X = x + 8, or on the first pixel if X < 8
+        const uint8_t objSize = m_LcdControl->GetObjectSize() * TILE_SIZE;
+        for (auto objectID: m_LineObjects)
+        {
+            const auto& obj = m_Oam->GetObject(objectID);
+            uint32_t objX = obj.GetXPosition();
+            if (objX == 0 || objX >= LCD_SCREEN_WIDTH + TILE_SIZE)
+                continue;
+
+            uint32_t lcdX = objX > TILE_SIZE ? objX - TILE_SIZE : 0;
+            uint32_t offset = lcdX + TILE_SIZE - objX;
+
+            uint8_t y = (m_LcdY + (2 * TILE_SIZE) - obj.GetYPosition());
+            if (obj.GetYFlip())
+                y = objSize - 1 - y;
+
+            uint8_t objTileID = obj.GetTileIndex();
+            if (objSize > TILE_SIZE)
+                objTileID &= ~1;
+
+            if (y >= TILE_SIZE)
+                objTileID++;
+
+            const TileRow& row = m_Vram->GetObjectPixels(objTileID).GetRow(y % TILE_SIZE, obj.GetXFlip());
+
+            std::array<uint8_t, TILE_SIZE> colors{};
+            TileDecoder::MapColors(row.data(), TILE_SIZE, m_Palettes->GetObjectPalette(obj.GetDMGPalette()).Get(), colors.data());
+
+            // earlier objects keep their pixels
+            for (uint32_t x = offset; x < TILE_SIZE; x++)
+            {
+                if (objects[lcdX + x - offset] == 0)
+                    objects[lcdX + x - offset] = colors[x];
+            }
+
+            objectsEnd = std::max(objectsEnd, lcdX + TILE_SIZE - offset);
+        }
+
+        // pixels past the line stay in the fifo for the next one
+        m_ObjectFIFO.Clear();
+        for (uint32_t x = LCD_SCREEN_WIDTH; x < objectsEnd; x++)
+            m_ObjectFIFO.PushBack(objects[x]);
+    }
 } // namespace GBE
@@ -7,7 +7,10 @@
 #include <coroutine>
 
 #include "lcd/LcdScreen.h"
+#include "lcd/LcdFrameBuffer.h"
+#include "oam/ObjectAttributesMemory.h"
 #include "PixelFIFO.h"
+#include "PpuRenderer.h"
 
 #include "util/Class.h"
 
@@ -19,6 +22,8 @@ namespace GBE
     class ObjectAttributesMemory;
     class LcdControl;
     class LcdPalettesMemory;
+    class StateWriter;
+    class StateReader;
 
     enum class PpuMode
     {
@@ -47,20 +52,37 @@ namespace GBE
             const std::shared_ptr<ObjectAttributesMemory>& oam,
             const std::shared_ptr<LcdPalettesMemory>& palettes,
             const std::shared_ptr<LcdControl>& lcdControl,
-            const std::shared_ptr<InterruptManager>& interruptManager
+            const std::shared_ptr<InterruptManager>& interruptManager,
+            PpuRenderer renderer = PpuRenderer::FIFO
         );
         ~Ppu();
 
         // init 
         void Init();
 
+        // counters, fifos and the screen being drawn, the renderer and frame skip settings aren't saved
+        void SaveState(StateWriter& writer) const;
+        void LoadState(StateReader& reader);
+
         // tick ppu n dots
         void Tick(uint32_t dots);
 
-        // get screen
+        // dots to tick before the ppu does any work
+        inline uint32_t GetIdleDots() const
+        {
+            return m_WaitDots > 1 ? m_WaitDots - 1 : 0;
+        }
+
+        // screen being drawn
         inline const LcdScreen& GetLcdScreen() const
         {
-            return m_Screen;
+            return *m_Screen;
+        }
+
+        // completed frames, published at vblank
+        inline LcdFrameBuffer& GetFrameBuffer()
+        {
+            return m_FrameBuffer;
         }
 
         inline uint32_t GetDotsCounter() const
@@ -73,7 +95,50 @@ namespace GBE
             return m_PpuMode;
         }
 
+        inline PpuRenderer GetRenderer() const
+        {
+            return m_Renderer;
+        }
+
+        // frames not drawn after each drawn frame, skipped frames keep the same timing and interrupts
+        // but leave the screen untouched
+        inline void SetFrameSkip(uint32_t frameSkip)
+        {
+            m_FrameSkip = frameSkip;
+            m_SkippedFrames = 0;
+        }
+
+        inline uint32_t GetFrameSkip() const
+        {
+            return m_FrameSkip;
+        }
+
+        // only draw the frames asked with RequestFrame
+        inline void SetDrawOnRequest(bool isDrawOnRequest)
+        {
+            m_IsDrawOnRequest = isDrawOnRequest;
+        }
+
+        inline bool IsDrawOnRequest() const
+        {
+            return m_IsDrawOnRequest;
+        }
+
+        // draw the next frame starting, in draw on request mode
+        inline void RequestFrame()
+        {
+            m_IsFrameRequested = true;
+        }
+
+        // the current frame writes to the screen
+        inline bool IsDrawingFrame() const
+        {
+            return m_IsDrawingFrame;
+        }
+
     private:
+        PpuRenderer m_Renderer = PpuRenderer::FIFO;
+
         // dot counter
         uint32_t m_FrameCounter = 0;
         uint32_t m_DotsCounter = 0;
@@ -93,11 +158,20 @@ namespace GBE
         PpuMode m_QueuePpuMode;
 
         // output screen
-        LcdScreen m_Screen{};
+        LcdFrameBuffer m_FrameBuffer{};
+        // back screen of the frame buffer
+        LcdScreen* m_Screen = &m_FrameBuffer.GetBackScreen();
         uint32_t m_LcdX = 0;
         uint32_t m_LcdY = 0;
         bool m_IsRendering = true;
 
+        // frame skip
+        uint32_t m_FrameSkip = 0;
+        uint32_t m_SkippedFrames = 0;
+        bool m_IsDrawOnRequest = false;
+        bool m_IsFrameRequested = false;
+        bool m_IsDrawingFrame = true;
+
         PixelFIFO m_ObjectFIFO{};
         PixelFIFO m_BackgroundFIFO{};
 
@@ -115,8 +189,9 @@ namespace GBE
         // queue interrupt
         bool m_VBlankInterrupt = false;
 
-        // objects
-        std::vector<uint8_t> m_LineObjects{};
+        // objects selected by the oam scan, and the next one to fetch
+        LineObjects m_LineObjects{};
+        uint8_t m_NextLineObject = 0;
 
         void _Render();
         void _OAMScan();
@@ -127,5 +202,24 @@ namespace GBE
 
         void _FetchBackgroundFIFO();
         void _FetchObjectsFIFO();
+
+        // next frame is drawn or skipped
+        bool _IsFrameDrawn();
+
+        // dots of each drawing step of a line
+        using LineSteps = std::array<uint32_t, LCD_SCREEN_WIDTH>;
+
+        // scanline renderer, draws the line and waits the dots the fifo would have taken
+        void _DrawLine();
+        // skipped frame, only waits the dots of the line
+        void _SkipLine();
+        // steps the fifo takes for the line, returns the window start x (LCD_SCREEN_WIDTH if none)
+        uint32_t _GetLineSteps(LineSteps& waitDots) const;
+        // queue hblank after the line steps
+        void _WaitLineSteps(const LineSteps& waitDots);
+        // colors of the tile row at the bg/window map position
+        void _FetchTileRow(uint8_t tileMapID, uint8_t tileX, uint8_t y, std::array<uint8_t, TILE_SIZE>& colors) const;
+        // object colors of the line
+        void _FetchLineObjects(std::array<uint8_t, LCD_SCREEN_WIDTH + TILE_SIZE>& objects);
     };
 } // namespace GBE
@@ -0,0 +1,13 @@
+#pragma once
+
+namespace GBE
+{
+    // how the ppu draws a line in mode 3
+    enum class PpuRenderer
+    {
+        // pixel fifo stepped on every dot, registers changed mid line are seen
+        FIFO = 0,
+        // whole line drawn at the start of mode 3 with the fifo timing, no mid line raster effects
+        SCANLINE
+    };
+} // namespace GBE
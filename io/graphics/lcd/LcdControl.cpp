@@ -5,6 +5,8 @@
 
 #include "memory/Memory.h"
 #include "util/Binary.h"
+#include "util/StateWriter.h"
+#include "util/StateReader.h"
 
 #include <memory>
 
@@ -52,6 +54,40 @@ namespace GBE
         SetReadWriteFlags(true);
     }
 
+    void LcdControl::SaveState(StateWriter& writer) const
+    {
+        MemoryArea::SaveState(writer);
+
+        writer.Write(m_Control);
+        writer.Write(m_Status);
+        writer.Write(m_ViewportX);
+        writer.Write(m_ViewportY);
+        writer.Write(m_WindowX);
+        writer.Write(m_WindowY);
+        writer.Write(m_LcdYCoordinate);
+        writer.Write(m_LcdYCompare);
+        writer.Write(m_DMA);
+        writer.Write(m_StartDMATransfer);
+        writer.Write(m_DMADots);
+    }
+
+    void LcdControl::LoadState(StateReader& reader)
+    {
+        MemoryArea::LoadState(reader);
+
+        reader.Read(m_Control);
+        reader.Read(m_Status);
+        reader.Read(m_ViewportX);
+        reader.Read(m_ViewportY);
+        reader.Read(m_WindowX);
+        reader.Read(m_WindowY);
+        reader.Read(m_LcdYCoordinate);
+        reader.Read(m_LcdYCompare);
+        reader.Read(m_DMA);
+        reader.Read(m_StartDMATransfer);
+        reader.Read(m_DMADots);
+    }
+
     bool LcdControl::GetControlFlag(LcdControlFlag flag) const
     {
         return Binary::TestBit(m_Control, static_cast<uint8_t>(flag));
@@ -143,7 +179,11 @@ namespace GBE
 
     void LcdControl::_SetImp(uint16_t address, uint8_t value)
     {
-        switch (static_cast<LcdAddress>(address))
+        LcdAddress lcdAddress = static_cast<LcdAddress>(address);
+        if (m_TimingListener && (lcdAddress == LcdAddress::LCDC || lcdAddress == LcdAddress::DMA))
+            m_TimingListener();
+
+        switch (lcdAddress)
         {
         case LcdAddress::LCDC:
             m_Control = value;
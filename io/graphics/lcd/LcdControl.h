@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <array>
 #include <memory>
+#include <functional>
 
 #include "LcdPalette.h"
 
@@ -44,11 +45,17 @@ namespace GBE
     class LcdControl : public MemoryArea
     {
     public:
+        // called before a write changing the ppu or dma timing (LCDC, DMA)
+        using TimingListener = std::function<void()>;
+
         LcdControl(const std::shared_ptr<ObjectAttributesMemory>& oam);
         ~LcdControl() = default;
 
         void Init() override;
 
+        void SaveState(StateWriter& writer) const override;
+        void LoadState(StateReader& reader) override;
+
         bool GetControlFlag(LcdControlFlag flag) const;
 
         uint8_t GetBackgroundTileMapID() const;
@@ -103,8 +110,19 @@ namespace GBE
 
         // do the transfer of DMA from memory to oam memory
         void Tick(const Memory& memory, uint32_t dots);
+
+        inline bool IsDMATransferring() const
+        {
+            return m_StartDMATransfer;
+        }
+
+        inline void SetTimingListener(const TimingListener& listener)
+        {
+            m_TimingListener = listener;
+        }
     private:
         std::shared_ptr<ObjectAttributesMemory> m_Oam = nullptr;
+        TimingListener m_TimingListener = nullptr;
 
         uint8_t m_Control = 0x91;
         uint8_t m_Status = 0;
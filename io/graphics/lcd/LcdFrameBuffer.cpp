@@ -0,0 +1,38 @@
+#include "LcdFrameBuffer.h"
+
+namespace GBE
+{
+    void LcdFrameBuffer::Publish()
+    {
+        uint64_t sequence = m_Sequence.load(std::memory_order_relaxed) + 1;
+        m_Sequences[m_Back] = sequence;
+
+        uint8_t published = m_Back;
+        m_Back = m_Ready.exchange(published | NEW_FRAME_FLAG, std::memory_order_acq_rel) & SCREEN_INDEX_MASK;
+
+        // the consumer only reads the published screen, the copy can run next to it
+        m_Screens[m_Back].CopyFrom(m_Screens[published]);
+
+        m_Sequence.store(sequence, std::memory_order_release);
+        m_Sequence.notify_all();
+    }
+
+    bool LcdFrameBuffer::Acquire()
+    {
+        if (!(m_Ready.load(std::memory_order_relaxed) & NEW_FRAME_FLAG))
+            return false;
+
+        m_Front = m_Ready.exchange(m_Front, std::memory_order_acq_rel) & SCREEN_INDEX_MASK;
+        return true;
+    }
+
+    void LcdFrameBuffer::Wait(uint64_t sequence) const
+    {
+        uint64_t current = m_Sequence.load(std::memory_order_acquire);
+        while (current <= sequence)
+        {
+            m_Sequence.wait(current, std::memory_order_acquire);
+            current = m_Sequence.load(std::memory_order_acquire);
+        }
+    }
+} // namespace GBE
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <array>
+#include <atomic>
+
+#include "LcdScreen.h"
+
+#include "util/Class.h"
+
+namespace GBE
+{
+    // triple buffered lcd screens
+    // the ppu draws in the back screen and publishes it at vblank, the consumer reads the front screen
+    // publishing and acquiring are lock free, one producer thread and one consumer thread can use them at the same time
+    class LcdFrameBuffer
+    {
+    public:
+        GBE_CLASS_NO_COPY_NO_MOVE(LcdFrameBuffer)
+
+        LcdFrameBuffer() = default;
+        ~LcdFrameBuffer() = default;
+
+        // producer
+
+        // screen being drawn
+        inline LcdScreen& GetBackScreen()
+        {
+            return m_Screens[m_Back];
+        }
+
+        inline const LcdScreen& GetBackScreen() const
+        {
+            return m_Screens[m_Back];
+        }
+
+        // publish the back screen as the latest frame, the next back screen starts as a copy of it
+        void Publish();
+
+        // consumer
+
+        // sequence number of the last published frame, 0 if none
+        inline uint64_t GetSequence() const
+        {
+            return m_Sequence.load(std::memory_order_acquire);
+        }
+
+        // take the latest published frame as the front screen, false if there is no newer frame
+        bool Acquire();
+
+        // frame taken by the last acquire, stays valid until the next one
+        inline const LcdScreen& GetFrontScreen() const
+        {
+            return m_Screens[m_Front];
+        }
+
+        inline uint64_t GetFrontSequence() const
+        {
+            return m_Sequences[m_Front];
+        }
+
+        // block until a frame newer than sequence is published
+        void Wait(uint64_t sequence) const;
+
+    private:
+        static constexpr uint8_t SCREEN_INDEX_MASK = 0x3;
+        // set in m_Ready when the ready screen wasn't acquired yet
+        static constexpr uint8_t NEW_FRAME_FLAG = 0x4;
+
+        std::array<LcdScreen, 3> m_Screens{};
+        std::array<uint64_t, 3> m_Sequences{};
+
+        // owned by the producer
+        uint8_t m_Back = 0;
+        // last published screen, swapped by both sides
+        std::atomic<uint8_t> m_Ready = 1;
+        // owned by the consumer
+        uint8_t m_Front = 2;
+
+        std::atomic<uint64_t> m_Sequence = 0;
+    };
+} // namespace GBE
@@ -30,7 +30,7 @@ namespace GBE
 
         inline LcdColor GetColor(uint8_t colorIndex) const
         {
-            return m_Colors.at(colorIndex);
+            return m_Colors[colorIndex];
         };
     private:
         uint8_t m_Byte = 0x0;
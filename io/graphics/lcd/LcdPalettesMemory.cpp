@@ -1,5 +1,8 @@
 #include "LcdPalettesMemory.h"
 
+#include "util/StateWriter.h"
+#include "util/StateReader.h"
+
 namespace GBE
 {
     enum class LcdPaletteAddress
@@ -18,6 +21,22 @@ namespace GBE
         SetReadWriteFlags(false);
     }
 
+    void LcdPalettesMemory::SaveState(StateWriter& writer) const
+    {
+        MemoryArea::SaveState(writer);
+
+        for (uint16_t address = 0; address < MMAP_LCD_PALETTES.GetSize(); address++)
+            writer.Write(_GetImp(address));
+    }
+
+    void LcdPalettesMemory::LoadState(StateReader& reader)
+    {
+        MemoryArea::LoadState(reader);
+
+        for (uint16_t address = 0; address < MMAP_LCD_PALETTES.GetSize(); address++)
+            _SetImp(address, reader.Read<uint8_t>());
+    }
+
     void LcdPalettesMemory::_SetImp(uint16_t address, uint8_t value)
     {
         switch (static_cast<LcdPaletteAddress>(address))
@@ -21,6 +21,9 @@ namespace GBE
 
         void Init() override;
 
+        void SaveState(StateWriter& writer) const override;
+        void LoadState(StateReader& reader) override;
+
         inline const LcdPalette &GetBackgroundPalette() const
         {
             return m_BackgroundPalette;
@@ -0,0 +1,83 @@
+#include "LcdScreen.h"
+
+#include "util/StateWriter.h"
+#include "util/StateReader.h"
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace GBE
+{
+    void LcdScreen::SaveState(StateWriter& writer) const
+    {
+        writer.WriteBytes(m_Pixels.data(), m_Pixels.size());
+    }
+
+    void LcdScreen::LoadState(StateReader& reader)
+    {
+        const uint8_t* pixels = reader.ReadData(m_Pixels.size());
+        if (!pixels)
+            return;
+
+        for (uint8_t y = 0; y < LCD_SCREEN_HEIGHT; y++)
+        {
+            uint8_t* line = m_Pixels.data() + y * LCD_SCREEN_WIDTH;
+            const uint8_t* stateLine = pixels + y * LCD_SCREEN_WIDTH;
+            if (std::memcmp(line, stateLine, LCD_SCREEN_WIDTH) == 0)
+                continue;
+
+            std::memcpy(line, stateLine, LCD_SCREEN_WIDTH);
+            m_LineVersions[y]++;
+            m_Version++;
+        }
+    }
+
+    void LcdScreen::ToRGBA(uint8_t firstLine, uint8_t lines, const PaletteRGBA& palette, uint32_t* rgba) const
+    {
+#if defined(__SSE2__)
+        const uint8_t* pixels = m_Pixels.data() + firstLine * LCD_SCREEN_WIDTH;
+        const size_t count = static_cast<size_t>(lines) * LCD_SCREEN_WIDTH;
+        static_assert(LCD_SCREEN_WIDTH % 16 == 0, "lines are converted 16 pixels at a time");
+
+        __m128i colors[4]{};
+        for (uint8_t i = 0; i < 4; i++)
+            colors[i] = _mm_set1_epi32(static_cast<int>(palette[i]));
+
+        for (size_t i = 0; i < count; i += 16)
+        {
+            __m128i indices = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i)), _mm_set1_epi8(3));
+
+            // widen the 16 byte masks of each color to 4 x 4 pixels masks
+            __m128i out[4]{};
+            for (uint8_t color = 0; color < 4; color++)
+            {
+                __m128i mask = _mm_cmpeq_epi8(indices, _mm_set1_epi8(static_cast<char>(color)));
+                __m128i mask16Low = _mm_unpacklo_epi8(mask, mask);
+                __m128i mask16High = _mm_unpackhi_epi8(mask, mask);
+
+                out[0] = _mm_or_si128(out[0], _mm_and_si128(_mm_unpacklo_epi16(mask16Low, mask16Low), colors[color]));
+                out[1] = _mm_or_si128(out[1], _mm_and_si128(_mm_unpackhi_epi16(mask16Low, mask16Low), colors[color]));
+                out[2] = _mm_or_si128(out[2], _mm_and_si128(_mm_unpacklo_epi16(mask16High, mask16High), colors[color]));
+                out[3] = _mm_or_si128(out[3], _mm_and_si128(_mm_unpackhi_epi16(mask16High, mask16High), colors[color]));
+            }
+
+            for (uint8_t j = 0; j < 4; j++)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + i + j * 4), out[j]);
+        }
+#else
+        ToRGBAScalar(firstLine, lines, palette, rgba);
+#endif
+    }
+
+    void LcdScreen::ToRGBAScalar(uint8_t firstLine, uint8_t lines, const PaletteRGBA& palette, uint32_t* rgba) const
+    {
+        const uint8_t* pixels = m_Pixels.data() + firstLine * LCD_SCREEN_WIDTH;
+        const size_t count = static_cast<size_t>(lines) * LCD_SCREEN_WIDTH;
+
+        for (size_t i = 0; i < count; i++)
+            rgba[i] = palette[pixels[i] & 3];
+    }
+} // namespace GBE
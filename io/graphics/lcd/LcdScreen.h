@@ -1,12 +1,16 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include <array>
 
 #include "util/Class.h"
 
 namespace GBE
 {
+    class StateWriter;
+    class StateReader;
+
     constexpr uint8_t LCD_SCREEN_WIDTH = 160;
     constexpr uint8_t LCD_SCREEN_HEIGHT = 144;
 
@@ -17,13 +21,23 @@ namespace GBE
         GBE_CLASS_NO_COPY_NO_MOVE(LcdScreen)
 
         using Pixels = std::array<uint8_t, LCD_SCREEN_WIDTH * LCD_SCREEN_HEIGHT>;
+        using LineVersions = std::array<uint32_t, LCD_SCREEN_HEIGHT>;
+        // rgba color of each lcd color, as stored in memory
+        using PaletteRGBA = std::array<uint32_t, 4>;
 
         LcdScreen() = default;  
         ~LcdScreen() = default;
 
         inline void SetPixel(uint8_t x, uint8_t y, uint8_t value)
         {
-            m_Pixels[y * LCD_SCREEN_WIDTH + x] = value;
+            uint8_t& pixel = m_Pixels[y * LCD_SCREEN_WIDTH + x];
+
+            // bump the versions only when the pixel changes
+            uint32_t isChanged = pixel != value;
+            m_LineVersions[y] += isChanged;
+            m_Version += isChanged;
+
+            pixel = value;
         }
 
         inline const Pixels& GetPixels() const
@@ -35,7 +49,50 @@ namespace GBE
         {
             return m_Pixels[x + y * LCD_SCREEN_WIDTH];
         }
+
+        // copy the pixels and versions of other
+        inline void CopyFrom(const LcdScreen& other)
+        {
+            m_Pixels = other.m_Pixels;
+            m_LineVersions = other.m_LineVersions;
+            m_Version = other.m_Version;
+        }
+
+        // pixels in a save state, loading bumps the versions of the changed lines
+        void SaveState(StateWriter& writer) const;
+        void LoadState(StateReader& reader);
+
+        // changes whenever a pixel of the screen changes
+        inline uint64_t GetVersion() const
+        {
+            return m_Version;
+        }
+
+        // changes whenever a pixel of line y changes
+        inline uint32_t GetLineVersion(uint8_t y) const
+        {
+            return m_LineVersions[y];
+        }
+
+        // convert lines [firstLine, firstLine + lines) to rgba, rgba must hold LCD_SCREEN_WIDTH pixels per line
+        void ToRGBA(uint8_t firstLine, uint8_t lines, const PaletteRGBA& palette, uint32_t* rgba) const;
+        // reference version of ToRGBA
+        void ToRGBAScalar(uint8_t firstLine, uint8_t lines, const PaletteRGBA& palette, uint32_t* rgba) const;
+
+        // FNV-1a hash of the pixels, used to compare frames
+        inline uint64_t GetHash() const
+        {
+            uint64_t hash = 0xcbf29ce484222325;
+            for (uint8_t pixel: m_Pixels)
+            {
+                hash ^= pixel;
+                hash *= 0x100000001b3;
+            }
+            return hash;
+        }
     private:
         Pixels m_Pixels{};
+        LineVersions m_LineVersions{};
+        uint64_t m_Version = 0;
     };
 } // namespace GBE
@@ -1,5 +1,13 @@
 #include "ObjectAttributesMemory.h"
 
+#include <algorithm>
+#include <bit>
+
+#include "io/graphics/vram/TileData.h"
+
+#include "util/StateWriter.h"
+#include "util/StateReader.h"
+
 namespace GBE
 {
     ObjectAttributesMemory::ObjectAttributesMemory()
@@ -16,13 +24,53 @@ namespace GBE
         SetReadWriteFlags(false);
     }
 
+    void ObjectAttributesMemory::SaveState(StateWriter& writer) const
+    {
+        MemoryArea::SaveState(writer);
+
+        for (uint16_t address = 0; address < OAM_SIZE; address++)
+            writer.Write(_GetImp(address));
+    }
+
+    void ObjectAttributesMemory::LoadState(StateReader& reader)
+    {
+        MemoryArea::LoadState(reader);
+
+        const uint8_t* data = reader.ReadData(OAM_SIZE);
+        if (!data)
+            return;
+
+        // changed bytes go through the handler to keep the line objects up to date
+        for (uint16_t address = 0; address < OAM_SIZE; address++)
+        {
+            if (_GetImp(address) != data[address])
+                _SetImp(address, data[address]);
+        }
+    }
+
     void ObjectAttributesMemory::_SetImp(uint16_t address, uint8_t value)
     {
         uint16_t objectIndex = address / OBJECT_ATTRIBUTE_SIZE;
         uint16_t objectLocalAddress = address % OBJECT_ATTRIBUTE_SIZE;
 
         ObjectAttribute &object = m_Objects.at(objectIndex);
-        object.Set(objectLocalAddress, value);
+
+        // only y and x change the objects of the lines
+        switch (objectLocalAddress)
+        {
+        case 0:
+            _UpdateLineMasks(objectIndex, false);
+            object.Set(objectLocalAddress, value);
+            _UpdateLineMasks(objectIndex, true);
+            break;
+        case 1:
+            object.Set(objectLocalAddress, value);
+            _SetLinesDirty(objectIndex);
+            break;
+        default:
+            object.Set(objectLocalAddress, value);
+            break;
+        }
     }
 
     uint8_t ObjectAttributesMemory::_GetImp(uint16_t address) const
@@ -33,4 +81,68 @@ namespace GBE
         const ObjectAttribute &object = m_Objects.at(objectIndex);
         return object.Get(objectLocalAddress);
     }
+
+    const LineObjects& ObjectAttributesMemory::GetLineObjects(uint8_t y, uint8_t objectSize)
+    {
+        uint8_t sizeIndex = objectSize - 1;
+        LineObjects& line = m_Lines[sizeIndex][y];
+        if (!m_IsLineDirty[sizeIndex][y])
+            return line;
+
+        // first objects in oam order
+        line.Count = 0;
+        uint64_t mask = m_LineMasks[sizeIndex][y];
+        while (mask && line.Count < LINE_OBJECT_MAX)
+        {
+            line.IDs[line.Count++] = std::countr_zero(mask);
+            mask &= mask - 1;
+        }
+
+        // x priority, ties keep the oam order
+        std::stable_sort(line.IDs.begin(), line.IDs.begin() + line.Count, [this](uint8_t a, uint8_t b)
+        {
+            return m_Objects[a].GetXPosition() < m_Objects[b].GetXPosition();
+        });
+
+        m_IsLineDirty[sizeIndex][y] = false;
+        return line;
+    }
+
+    void ObjectAttributesMemory::_UpdateLineMasks(uint8_t objectID, bool isCovering)
+    {
+        uint64_t objectMask = uint64_t(1) << objectID;
+        for (uint8_t sizeIndex = 0; sizeIndex < 2; sizeIndex++)
+        {
+            auto [begin, end] = _GetObjectLines(objectID, sizeIndex + 1);
+            for (int32_t y = begin; y < end; y++)
+            {
+                if (isCovering)
+                    m_LineMasks[sizeIndex][y] |= objectMask;
+                else
+                    m_LineMasks[sizeIndex][y] &= ~objectMask;
+
+                m_IsLineDirty[sizeIndex][y] = true;
+            }
+        }
+    }
+
+    void ObjectAttributesMemory::_SetLinesDirty(uint8_t objectID)
+    {
+        for (uint8_t sizeIndex = 0; sizeIndex < 2; sizeIndex++)
+        {
+            auto [begin, end] = _GetObjectLines(objectID, sizeIndex + 1);
+            for (int32_t y = begin; y < end; y++)
+                m_IsLineDirty[sizeIndex][y] = true;
+        }
+    }
+
+    std::pair<int32_t, int32_t> ObjectAttributesMemory::_GetObjectLines(uint8_t objectID, uint8_t objectSize) const
+    {
+        // line y is covered if y + 16 is in [Y, Y + size)
+        int32_t firstLine = static_cast<int32_t>(m_Objects[objectID].GetYPosition()) - 2 * TILE_SIZE;
+        int32_t begin = std::max(firstLine, 0);
+        int32_t end = std::min(firstLine + objectSize * TILE_SIZE, static_cast<int32_t>(LCD_SCREEN_HEIGHT));
+
+        return {begin, end};
+    }
 } // namespace GBE
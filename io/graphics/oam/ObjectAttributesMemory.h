@@ -1,10 +1,14 @@
 #pragma once
 
 #include <vector>
+#include <array>
 #include <cstdint>
+#include <utility>
 
 #include "ObjectAttribute.h"
 
+#include "io/graphics/lcd/LcdScreen.h"
+
 #include "memory/MemoryMap.h"
 #include "memory/MemoryArea.h"
 
@@ -12,6 +16,25 @@ namespace GBE
 {
     constexpr uint16_t OBJECT_COUNT = 40;
     constexpr uint16_t OAM_SIZE = OBJECT_ATTRIBUTE_SIZE * OBJECT_COUNT;
+    // objects selected by the oam scan of a line
+    constexpr uint8_t LINE_OBJECT_MAX = 10;
+
+    // objects of a line, sorted by x then by oam index
+    struct LineObjects
+    {
+        std::array<uint8_t, LINE_OBJECT_MAX> IDs{};
+        uint8_t Count = 0;
+
+        inline const uint8_t* begin() const
+        {
+            return IDs.data();
+        }
+
+        inline const uint8_t* end() const
+        {
+            return IDs.data() + Count;
+        }
+    };
 
     // OAM memory map
     static constexpr MemoryMap MMAP_OAM(0xFE00, 0xFE9F);
@@ -24,17 +47,36 @@ namespace GBE
 
         void Init() override;
 
+        void SaveState(StateWriter& writer) const override;
+        void LoadState(StateReader& reader) override;
+
         inline const ObjectAttribute& GetObject(uint8_t objectID) const
         {
             return m_Objects.at(objectID);
         }
 
-        
+        // first 10 objects of line y in oam order, sorted by x
+        // objectSize is 1 for 8x8 objects and 2 for 8x16 objects
+        const LineObjects& GetLineObjects(uint8_t y, uint8_t objectSize);
+
     private:
         void _SetImp(uint16_t address, uint8_t value) override;
         uint8_t _GetImp(uint16_t address) const override;
 
         std::vector<ObjectAttribute> m_Objects{};
+
+        // per object size, mask of the objects covering each line, updated on y writes
+        std::array<std::array<uint64_t, LCD_SCREEN_HEIGHT>, 2> m_LineMasks{};
+        // per object size, objects of each line, rebuilt from the mask when dirty
+        std::array<std::array<LineObjects, LCD_SCREEN_HEIGHT>, 2> m_Lines{};
+        std::array<std::array<bool, LCD_SCREEN_HEIGHT>, 2> m_IsLineDirty{};
+
+        // add or remove object from the lines it covers
+        void _UpdateLineMasks(uint8_t objectID, bool isCovering);
+        // mark the lines covered by object as dirty
+        void _SetLinesDirty(uint8_t objectID);
+        // screen lines [begin, end) covered by object
+        std::pair<int32_t, int32_t> _GetObjectLines(uint8_t objectID, uint8_t objectSize) const;
     };
 
 } // namespace GBE
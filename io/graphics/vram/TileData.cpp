@@ -2,6 +2,8 @@
 
 #include <cassert>
 
+#include "TileDecoder.h"
+
 #include "util/Binary.h"
 
 namespace GBE
@@ -24,4 +26,11 @@ namespace GBE
         return color;
     }
 
+    void TileData::DecodeRow(uint8_t y, TilePixels& pixels) const
+    {
+        const uint8_t* row = m_Data.data() + y * 2;
+        TileDecoder::DecodeRows(row, 1, false, pixels.Rows[y].data());
+        TileDecoder::DecodeRows(row, 1, true, pixels.FlippedRows[y].data());
+    }
+
 } // namespace GBE
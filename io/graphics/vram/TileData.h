@@ -11,6 +11,21 @@ namespace GBE
     constexpr uint8_t TILE_SIZE = 8;
     constexpr uint8_t TILE_VRAM_SIZE = TILE_SIZE * 2;
 
+    // row of a tile as color indices, one byte per pixel
+    using TileRow = std::array<uint8_t, TILE_SIZE>;
+
+    // tile decoded to color indices, with its x flipped rows
+    struct TilePixels
+    {
+        std::array<TileRow, TILE_SIZE> Rows{};
+        std::array<TileRow, TILE_SIZE> FlippedRows{};
+
+        inline const TileRow& GetRow(uint8_t y, bool xFlip) const
+        {
+            return xFlip ? FlippedRows[y] : Rows[y];
+        }
+    };
+
     // 8x8 tile data
     class TileData
     {
@@ -19,6 +34,9 @@ namespace GBE
         ~TileData() = default;
 
         uint8_t GetPixel(uint8_t x, uint8_t y) const;
+
+        // decode row y to pixels
+        void DecodeRow(uint8_t y, TilePixels& pixels) const;
         
         inline void Set(uint16_t address, uint8_t value)
         {
@@ -29,6 +47,16 @@ namespace GBE
         {
             return m_Data.at(address);
         }
+
+        inline uint8_t* GetData()
+        {
+            return m_Data.data();
+        }
+
+        inline const uint8_t* GetData() const
+        {
+            return m_Data.data();
+        }
     private:
 
         std::array<uint8_t, TILE_VRAM_SIZE> m_Data{};
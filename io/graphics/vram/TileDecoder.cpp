@@ -0,0 +1,195 @@
+#include "TileDecoder.h"
+
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace GBE
+{
+    namespace
+    {
+        constexpr size_t ROW_PIXELS = 8;
+
+        inline uint8_t DecodePixel(uint8_t low, uint8_t high, uint8_t bit)
+        {
+            return (((high >> bit) & 1) << 1) | ((low >> bit) & 1);
+        }
+
+        inline uint8_t MapColor(uint8_t index, uint8_t palette)
+        {
+            return (palette >> (index * 2)) & 3;
+        }
+
+#if defined(__SSE2__)
+        // bit of each pixel, left pixel is bit 7
+        inline __m128i PixelBits(bool xFlip)
+        {
+            if (xFlip)
+                return _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+
+            return _mm_setr_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+        }
+
+        // 2 rows (4 bytes) to 16 color indices
+        inline __m128i DecodeTwoRows(const uint8_t* data, __m128i bits)
+        {
+            uint32_t planes = 0;
+            std::memcpy(&planes, data, sizeof(planes));
+
+            // l0 h0 l1 h1 -> l0 x8 l1 x8 / h0 x8 h1 x8
+            __m128i bytes = _mm_cvtsi32_si128(static_cast<int>(planes));
+            bytes = _mm_unpacklo_epi8(bytes, bytes);
+            bytes = _mm_unpacklo_epi16(bytes, bytes);
+            __m128i row0 = _mm_unpacklo_epi32(bytes, bytes);
+            __m128i row1 = _mm_unpackhi_epi32(bytes, bytes);
+            __m128i low = _mm_unpacklo_epi64(row0, row1);
+            __m128i high = _mm_unpackhi_epi64(row0, row1);
+
+            __m128i lowBits = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(low, bits), bits), _mm_set1_epi8(1));
+            __m128i highBits = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(high, bits), bits), _mm_set1_epi8(2));
+            return _mm_or_si128(lowBits, highBits);
+        }
+
+        // colors of 4 palette entries, selected by comparing the indices
+        struct PaletteColors
+        {
+            __m128i Colors[4];
+
+            explicit PaletteColors(uint8_t palette)
+            {
+                for (uint8_t i = 0; i < 4; i++)
+                    Colors[i] = _mm_set1_epi8(static_cast<char>(MapColor(i, palette)));
+            }
+
+            inline __m128i Map(__m128i indices) const
+            {
+                __m128i colors = _mm_setzero_si128();
+                for (uint8_t i = 1; i < 4; i++)
+                    colors = _mm_or_si128(colors, _mm_and_si128(_mm_cmpeq_epi8(indices, _mm_set1_epi8(i)), Colors[i]));
+
+                return _mm_or_si128(colors, _mm_and_si128(_mm_cmpeq_epi8(indices, _mm_setzero_si128()), Colors[0]));
+            }
+        };
+#endif
+
+#if defined(__AVX2__)
+        // 4 rows (8 bytes) to 32 color indices, the 128 bit lanes hold rows 0-1 and 2-3
+        inline __m256i DecodeFourRows(const uint8_t* data, __m256i bits)
+        {
+            uint32_t planes[2]{};
+            std::memcpy(planes, data, sizeof(planes));
+
+            __m256i bytes = _mm256_set_m128i(_mm_cvtsi32_si128(static_cast<int>(planes[1])), _mm_cvtsi32_si128(static_cast<int>(planes[0])));
+            bytes = _mm256_unpacklo_epi8(bytes, bytes);
+            bytes = _mm256_unpacklo_epi16(bytes, bytes);
+            __m256i row0 = _mm256_unpacklo_epi32(bytes, bytes);
+            __m256i row1 = _mm256_unpackhi_epi32(bytes, bytes);
+            __m256i low = _mm256_unpacklo_epi64(row0, row1);
+            __m256i high = _mm256_unpackhi_epi64(row0, row1);
+
+            __m256i lowBits = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(low, bits), bits), _mm256_set1_epi8(1));
+            __m256i highBits = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(high, bits), bits), _mm256_set1_epi8(2));
+            return _mm256_or_si256(lowBits, highBits);
+        }
+#endif
+    } // namespace
+
+    const char* TileDecoder::GetKernelName()
+    {
+#if defined(__AVX2__)
+        return "avx2";
+#elif defined(__SSE2__)
+        return "sse2";
+#else
+        return "scalar";
+#endif
+    }
+
+    void TileDecoder::DecodeRows(const uint8_t* data, size_t rows, bool xFlip, uint8_t* indices)
+    {
+        size_t row = 0;
+
+#if defined(__AVX2__)
+        __m256i bits256 = _mm256_broadcastsi128_si256(PixelBits(xFlip));
+        for (; row + 4 <= rows; row += 4)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(indices + row * ROW_PIXELS), DecodeFourRows(data + row * 2, bits256));
+#endif
+
+#if defined(__SSE2__)
+        __m128i bits = PixelBits(xFlip);
+        for (; row + 2 <= rows; row += 2)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(indices + row * ROW_PIXELS), DecodeTwoRows(data + row * 2, bits));
+#endif
+
+        DecodeRowsScalar(data + row * 2, rows - row, xFlip, indices + row * ROW_PIXELS);
+    }
+
+    void TileDecoder::MapColors(const uint8_t* indices, size_t count, uint8_t palette, uint8_t* colors)
+    {
+        size_t i = 0;
+
+#if defined(__SSE2__)
+        PaletteColors paletteColors{palette};
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(colors + i), paletteColors.Map(pixels));
+        }
+
+        // a single tile row
+        if (i + ROW_PIXELS <= count)
+        {
+            __m128i pixels = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(indices + i));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(colors + i), paletteColors.Map(pixels));
+            i += ROW_PIXELS;
+        }
+#endif
+
+        MapColorsScalar(indices + i, count - i, palette, colors + i);
+    }
+
+    void TileDecoder::DecodeRowsColors(const uint8_t* data, size_t rows, uint8_t palette, uint8_t* colors)
+    {
+        size_t row = 0;
+
+#if defined(__SSE2__)
+        __m128i bits = PixelBits(false);
+        PaletteColors paletteColors{palette};
+        for (; row + 2 <= rows; row += 2)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(colors + row * ROW_PIXELS), paletteColors.Map(DecodeTwoRows(data + row * 2, bits)));
+#endif
+
+        DecodeRowsColorsScalar(data + row * 2, rows - row, palette, colors + row * ROW_PIXELS);
+    }
+
+    void TileDecoder::DecodeRowsScalar(const uint8_t* data, size_t rows, bool xFlip, uint8_t* indices)
+    {
+        for (size_t row = 0; row < rows; row++)
+        {
+            uint8_t low = data[row * 2];
+            uint8_t high = data[row * 2 + 1];
+
+            for (uint8_t x = 0; x < ROW_PIXELS; x++)
+            {
+                uint8_t bit = xFlip ? x : ROW_PIXELS - x - 1;
+                indices[row * ROW_PIXELS + x] = DecodePixel(low, high, bit);
+            }
+        }
+    }
+
+    void TileDecoder::MapColorsScalar(const uint8_t* indices, size_t count, uint8_t palette, uint8_t* colors)
+    {
+        for (size_t i = 0; i < count; i++)
+            colors[i] = MapColor(indices[i], palette);
+    }
+
+    void TileDecoder::DecodeRowsColorsScalar(const uint8_t* data, size_t rows, uint8_t palette, uint8_t* colors)
+    {
+        DecodeRowsScalar(data, rows, false, colors);
+        MapColorsScalar(colors, rows * ROW_PIXELS, palette, colors);
+    }
+} // namespace GBE
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace GBE
+{
+    // kernels turning 2bpp tile rows into color indices and palette colors
+    // use avx2 / sse2 when the build targets them, scalar code otherwise
+    // rows are 2 bytes (low bitplane, high bitplane) and decode to 8 bytes, left pixel first
+    class TileDecoder
+    {
+    public:
+        // instruction set of the kernels ("avx2", "sse2" or "scalar")
+        static const char* GetKernelName();
+
+        // decode rows to color indices, mirrored if xFlip
+        static void DecodeRows(const uint8_t* data, size_t rows, bool xFlip, uint8_t* indices);
+
+        // map color indices to the colors of a palette byte (BGP / OBP)
+        static void MapColors(const uint8_t* indices, size_t count, uint8_t palette, uint8_t* colors);
+
+        // decode rows straight to palette colors
+        static void DecodeRowsColors(const uint8_t* data, size_t rows, uint8_t palette, uint8_t* colors);
+
+        // reference versions, used for the remainders and by tests / benchmarks
+        static void DecodeRowsScalar(const uint8_t* data, size_t rows, bool xFlip, uint8_t* indices);
+        static void MapColorsScalar(const uint8_t* indices, size_t count, uint8_t palette, uint8_t* colors);
+        static void DecodeRowsColorsScalar(const uint8_t* data, size_t rows, uint8_t palette, uint8_t* colors);
+    };
+} // namespace GBE
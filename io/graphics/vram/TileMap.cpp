@@ -17,6 +17,22 @@ namespace GBE
         return m_Data[x + y * TILE_MAP_SIZE];
     }
     
+    const uint8_t* TileMap::GetReadData(uint16_t address, uint16_t size) const
+    {
+        if (address + size > m_Data.size())
+            return nullptr;
+
+        return m_Data.data() + address;
+    }
+
+    uint8_t* TileMap::GetWriteData(uint16_t address, uint16_t size)
+    {
+        if (address + size > m_Data.size())
+            return nullptr;
+
+        return m_Data.data() + address;
+    }
+
     void TileMap::_SetImp(uint16_t address, uint8_t value)
     {
         m_Data[address] = value;
@@ -19,6 +19,9 @@ namespace GBE
         void Init() override;
 
         uint8_t GetTile(uint8_t x, uint8_t y) const;
+
+        const uint8_t* GetReadData(uint16_t address, uint16_t size) const override;
+        uint8_t* GetWriteData(uint16_t address, uint16_t size) override;
     private:
         void _SetImp(uint16_t address, uint8_t value) override;
         uint8_t _GetImp(uint16_t address) const override;
@@ -1,5 +1,8 @@
 #include "Vram.h"
 
+#include "util/StateWriter.h"
+#include "util/StateReader.h"
+
 #include <iostream>
 
 namespace GBE
@@ -9,6 +12,7 @@ namespace GBE
         // create vram with 
         m_Maps.resize(TILE_MAP_COUNT);
         m_Tiles.resize(TILE_COUNT);
+        m_TilesPixels.resize(TILE_COUNT);
     }
 
     void Vram::Init()
@@ -18,6 +22,45 @@ namespace GBE
             map.Init();
     }
 
+    void Vram::SaveState(StateWriter& writer) const
+    {
+        MemoryArea::SaveState(writer);
+
+        writer.WriteBytes(m_Tiles.front().GetData(), TILE_MAP_VRAM_ADDRESS);
+        for (const auto& map: m_Maps)
+            writer.WriteBytes(map.GetReadData(0, TILE_MAP_VRAM_SIZE), TILE_MAP_VRAM_SIZE);
+    }
+
+    void Vram::LoadState(StateReader& reader)
+    {
+        MemoryArea::LoadState(reader);
+
+        const uint8_t* tilesData = reader.ReadData(TILE_MAP_VRAM_ADDRESS);
+        if (!tilesData)
+            return;
+
+        // only decode the rows that changed
+        for (uint16_t tileIndex = 0; tileIndex < TILE_COUNT; tileIndex++)
+        {
+            TileData& tile = m_Tiles[tileIndex];
+            const uint8_t* tileData = tilesData + tileIndex * TILE_VRAM_SIZE;
+
+            for (uint8_t y = 0; y < TILE_SIZE; y++)
+            {
+                uint8_t* row = tile.GetData() + y * 2;
+                if (row[0] == tileData[y * 2] && row[1] == tileData[y * 2 + 1])
+                    continue;
+
+                row[0] = tileData[y * 2];
+                row[1] = tileData[y * 2 + 1];
+                tile.DecodeRow(y, m_TilesPixels[tileIndex]);
+            }
+        }
+
+        for (auto& map: m_Maps)
+            reader.ReadBytes(map.GetWriteData(0, TILE_MAP_VRAM_SIZE), TILE_MAP_VRAM_SIZE);
+    }
+
     void Vram::_SetImp(uint16_t address, uint8_t value)
     {
         // 0x1800-0x1FFF
@@ -38,6 +81,7 @@ namespace GBE
 
         TileData &tile = m_Tiles.at(tileIndex);
         tile.Set(tileLocalAddress, value);
+        tile.DecodeRow(tileLocalAddress / 2, m_TilesPixels[tileIndex]);
     }
 
     uint8_t Vram::_GetImp(uint16_t address) const
@@ -61,12 +105,42 @@ namespace GBE
         return tile.Get(tileLocalAddress);
     }
 
-    const TileData &Vram::GetTileBGWin(uint8_t tileID, bool objetAddressMode) const
+    const uint8_t* Vram::GetReadData(uint16_t address, uint16_t size) const
+    {
+        // 0x1800-0x1FFF
+        if (address >= TILE_MAP_VRAM_ADDRESS)
+        {
+            uint16_t mapIndex = (address - TILE_MAP_VRAM_ADDRESS) / TILE_MAP_VRAM_SIZE;
+            uint16_t mapLocalAddress = (address - TILE_MAP_VRAM_ADDRESS) % TILE_MAP_VRAM_SIZE;
+            if (mapIndex >= m_Maps.size())
+                return nullptr;
+
+            return m_Maps[mapIndex].GetReadData(mapLocalAddress, size);
+        }
+
+        // $0000–17FF, the tiles are separate objects, reads go through _GetImp
+        return nullptr;
+    }
+
+    uint8_t* Vram::GetWriteData(uint16_t address, uint16_t size)
     {
-        if (objetAddressMode)
-            return m_Tiles.at(tileID);
+        // 0x1800-0x1FFF
+        if (address >= TILE_MAP_VRAM_ADDRESS)
+        {
+            uint16_t mapIndex = (address - TILE_MAP_VRAM_ADDRESS) / TILE_MAP_VRAM_SIZE;
+            uint16_t mapLocalAddress = (address - TILE_MAP_VRAM_ADDRESS) % TILE_MAP_VRAM_SIZE;
+            if (mapIndex >= m_Maps.size())
+                return nullptr;
+
+            return m_Maps[mapIndex].GetWriteData(mapLocalAddress, size);
+        }
+
+        // $0000–17FF, writes go through _SetImp to decode the tile
+        return nullptr;
+    }
 
-        int8_t signedTileID = tileID;
-        return m_Tiles.at((2 * TILE_BLOCK_COUNT) + static_cast<int16_t>(signedTileID));
+    const TileData &Vram::GetTileBGWin(uint8_t tileID, bool objetAddressMode) const
+    {
+        return m_Tiles.at(_GetTileBGWinIndex(tileID, objetAddressMode));
     }
 } // namespace GBE
@@ -32,6 +32,9 @@ namespace GBE
 
         void Init() override;
 
+        void SaveState(StateWriter& writer) const override;
+        void LoadState(StateReader& reader) override;
+
         // Get tile map
         inline const TileMap& GetTileMap(uint8_t tileMapID) const  
         {
@@ -48,6 +51,22 @@ namespace GBE
         // if object address mode is set to true => start from block 0
         // else start from block 1
         const TileData& GetTileBGWin(uint8_t tileID, bool objetAddressMode) const;
+
+        // decoded pixels of the tiles, kept up to date on writes
+        inline const TilePixels& GetObjectPixels(uint8_t objectID) const
+        {
+            return m_TilesPixels[objectID];
+        }
+
+        inline const TilePixels& GetTilePixelsBGWin(uint8_t tileID, bool objetAddressMode) const
+        {
+            return m_TilesPixels[_GetTileBGWinIndex(tileID, objetAddressMode)];
+        }
+
+        // tile data and tile maps are both contiguous, a range can be accessed directly if it doesn't cross them
+        // tile data is only writable through Set so the decoded pixels follow it
+        const uint8_t* GetReadData(uint16_t address, uint16_t size) const override;
+        uint8_t* GetWriteData(uint16_t address, uint16_t size) override;
     private:
         // set byte at vrame
         void _SetImp(uint16_t address, uint8_t value) override;
@@ -56,7 +75,18 @@ namespace GBE
         uint8_t _GetImp(uint16_t address) const override;
 
         std::vector<TileData> m_Tiles{};
+        std::vector<TilePixels> m_TilesPixels{};
         std::vector<TileMap> m_Maps{};
-        
+
+        // index in the tiles of a background / window tile id
+        static inline uint16_t _GetTileBGWinIndex(uint8_t tileID, bool objetAddressMode)
+        {
+            if (objetAddressMode)
+                return tileID;
+
+            int8_t signedTileID = tileID;
+            return (2 * TILE_BLOCK_COUNT) + static_cast<int16_t>(signedTileID);
+        }
+
     };
 } // namespace GBE
@@ -1,5 +1,8 @@
 #include "InterruptManager.h"
 
+#include "util/StateWriter.h"
+#include "util/StateReader.h"
+
 #include <cassert>
     #include <iostream>
 
@@ -22,9 +25,31 @@ namespace GBE
         SetInterruptEnabled(0x00);
     }
 
+    void InterruptManager::SaveState(StateWriter& writer) const
+    {
+        MemoryArea::SaveState(writer);
+
+        writer.Write(m_InterruptFlag);
+        writer.Write(m_InterruptEnabled);
+    }
+
+    void InterruptManager::LoadState(StateReader& reader)
+    {
+        MemoryArea::LoadState(reader);
+
+        reader.Read(m_InterruptFlag);
+        reader.Read(m_InterruptEnabled);
+        _UpdatePendingInterrupts();
+    }
+
     void InterruptManager::QueueInterrupt(InterruptFlag interrupt)
     {
-        m_InterruptFlag |= 1 << static_cast<uint8_t>(interrupt);
+        SetInterruptFlag(m_InterruptFlag | (1 << static_cast<uint8_t>(interrupt)));
+    }
+
+    void InterruptManager::AcknowledgeInterrupt(InterruptFlag interrupt)
+    {
+        SetInterruptFlag(m_InterruptFlag & ~(1 << static_cast<uint8_t>(interrupt)));
     }
 
     uint16_t InterruptManager::GetHandler(InterruptFlag flag)
@@ -36,16 +61,15 @@ namespace GBE
 
     void InterruptManager::_SetImp(uint16_t address, uint8_t value)
     {
-        constexpr uint8_t interruptMask = 0b00011111;
-        value &= interruptMask;
+        value &= INTERRUPTS_MASK;
         
         if (address == 0)
         {
-            m_InterruptFlag = value;
+            SetInterruptFlag(value);
         }
         else
         {
-            m_InterruptEnabled = value;
+            SetInterruptEnabled(value);
         }
     }
     
@@ -16,10 +16,16 @@ namespace GBE
     class InterruptManager: public MemoryArea
     {
     public:
+        // bits of the 5 interrupts in IE / IF
+        static constexpr uint8_t INTERRUPTS_MASK = 0b00011111;
+
         InterruptManager();
         ~InterruptManager();
 
         void Init() override;
+
+        void SaveState(StateWriter& writer) const override;
+        void LoadState(StateReader& reader) override;
         
         inline uint8_t GetInterruptFlag() const
         {
@@ -29,6 +35,7 @@ namespace GBE
         inline void SetInterruptFlag(uint8_t interruptFlag)
         {
             m_InterruptFlag = interruptFlag;
+            _UpdatePendingInterrupts();
         }
 
         inline uint8_t GetInterruptEnabled() const
@@ -39,17 +46,33 @@ namespace GBE
         inline void SetInterruptEnabled(uint8_t interruptEnabled)
         {
             m_InterruptEnabled = interruptEnabled;
+            _UpdatePendingInterrupts();
+        }
+
+        // interrupts both requested and enabled (IE & IF), bit 0 has the highest priority
+        inline uint8_t GetPendingInterrupts() const
+        {
+            return m_PendingInterrupts;
         }
 
         // queue interrupt to be executed
         void QueueInterrupt(InterruptFlag interrupt);
 
+        // clear the request of an interrupt being serviced
+        void AcknowledgeInterrupt(InterruptFlag interrupt);
+
         // get interrupt handler address
         static uint16_t GetHandler(InterruptFlag flag);
         
     private:
         uint8_t m_InterruptFlag = 0;
         uint8_t m_InterruptEnabled = 0;
+        uint8_t m_PendingInterrupts = 0;
+
+        inline void _UpdatePendingInterrupts()
+        {
+            m_PendingInterrupts = m_InterruptFlag & m_InterruptEnabled & INTERRUPTS_MASK;
+        }
 
         void _SetImp(uint16_t address, uint8_t value) override;
         uint8_t _GetImp(uint16_t address) const override;
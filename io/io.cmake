@@ -1,6 +1,7 @@
 include(${CMAKE_CURRENT_LIST_DIR}/graphics/graphics.cmake)
 include(${CMAKE_CURRENT_LIST_DIR}/interrupts/interrupts.cmake)
 include(${CMAKE_CURRENT_LIST_DIR}/joypad/joypad.cmake)
+include(${CMAKE_CURRENT_LIST_DIR}/scheduler/scheduler.cmake)
 include(${CMAKE_CURRENT_LIST_DIR}/timer/timer.cmake)
 
 set (GBE_HEADERS ${GBE_HEADERS}
@@ -1,6 +1,10 @@
 #include "Joypad.h"
 
+#include <algorithm>
+
 #include "util/Binary.h"
+#include "util/StateWriter.h"
+#include "util/StateReader.h"
 
 
 namespace GBE
@@ -70,17 +74,53 @@ namespace GBE
         Set(0, 0xCF);
     }
 
+    void Joypad::SaveState(StateWriter& writer) const
+    {
+        MemoryArea::SaveState(writer);
+
+        writer.Write(m_JoypadFlags);
+        for (JoypadButtonType type: JOYPAD_BUTTON_TYPES)
+            writer.Write(m_JoypadMatrix.at(type));
+
+        // events queued and not handled yet, the free slots too so the size is fixed
+        writer.Write(m_EventsCount);
+        for (const JoypadEvent& event: m_Events)
+        {
+            writer.Write(event.Button);
+            writer.Write(event.Pressed);
+        }
+    }
+
+    void Joypad::LoadState(StateReader& reader)
+    {
+        MemoryArea::LoadState(reader);
+
+        reader.Read(m_JoypadFlags);
+        for (JoypadButtonType type: JOYPAD_BUTTON_TYPES)
+            m_JoypadMatrix[type] = reader.Read<uint8_t>();
+
+        m_EventsCount = std::min(reader.Read<uint32_t>(), MAX_EVENTS);
+        for (JoypadEvent& event: m_Events)
+        {
+            reader.Read(event.Button);
+            reader.Read(event.Pressed);
+        }
+    }
+
     void Joypad::QueueJoypadEvent(JoypadEvent event)
     {
-        m_Events.push_back(event);
+        if (m_EventsCount == MAX_EVENTS)
+            return;
+
+        m_Events[m_EventsCount++] = event;
     }
 
     void Joypad::Tick()
     {
-        if (m_Events.empty())
+        if (m_EventsCount == 0)
             return;
 
-        JoypadEvent &top = m_Events.back();
+        const JoypadEvent top = m_Events[m_EventsCount - 1];
         const JoypadButtonInfo& info = m_JoypadInfos.at(top.Button);
         
         // get current state
@@ -100,7 +140,15 @@ namespace GBE
             flags = Binary::SetBit(flags, static_cast<uint8_t>(info.Flag));
 
         m_JoypadMatrix[info.Type] = flags;
-        m_Events.pop_back();
+
+        // free slots stay empty so equal queues save equal states
+        m_Events[--m_EventsCount] = JoypadEvent{};
+    }
+
+    bool Joypad::IsPressed(JoypadButton button) const
+    {
+        const JoypadButtonInfo& info = m_JoypadInfos.at(button);
+        return !Binary::TestBit(m_JoypadMatrix.at(info.Type), static_cast<uint8_t>(info.Flag));
     }
 
     void Joypad::_SetImp(uint16_t address, uint8_t value)
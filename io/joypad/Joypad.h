@@ -11,6 +11,7 @@
 #include <flat_map>
 #include <memory>
 #include <vector>
+#include <array>
 
 namespace GBE
 {
@@ -47,9 +48,23 @@ namespace GBE
 
         void Init() override;
 
+        void SaveState(StateWriter& writer) const override;
+        void LoadState(StateReader& reader) override;
+
+        // events waiting to be handled, more are dropped
+        static constexpr uint32_t MAX_EVENTS = 32;
+
         void QueueJoypadEvent(JoypadEvent event);
         void Tick();
 
+        inline bool HasEvents() const
+        {
+            return m_EventsCount > 0;
+        }
+
+        // state of button after the events handled so far
+        bool IsPressed(JoypadButton button) const;
+
     private:
         enum class JoypadButtonType
         {
@@ -58,6 +73,12 @@ namespace GBE
             SELECT_BUTTONS = 5
         };
 
+        static constexpr std::array<JoypadButtonType, 3> JOYPAD_BUTTON_TYPES = {
+            JoypadButtonType::NONE, 
+            JoypadButtonType::SELECT_DPAD, 
+            JoypadButtonType::SELECT_BUTTONS
+        };
+
         enum class JoypadButtonFlag
         {
             A_RIGHT = 0,
@@ -75,7 +96,8 @@ namespace GBE
 
         uint8_t m_JoypadFlags = 0x0;
 
-        std::vector<JoypadEvent> m_Events{};
+        std::array<JoypadEvent, MAX_EVENTS> m_Events{};
+        uint32_t m_EventsCount = 0;
         std::flat_map<JoypadButtonType, uint8_t> m_JoypadMatrix{};
         std::flat_map<JoypadButton, JoypadButtonInfo> m_JoypadInfos{};
 
@@ -0,0 +1,72 @@
+#include "Scheduler.h"
+
+#include "util/StateWriter.h"
+#include "util/StateReader.h"
+
+#include <algorithm>
+
+namespace GBE
+{
+    Scheduler::Scheduler()
+    {
+        Init();
+    }
+
+    void Scheduler::Init()
+    {
+        m_Cycles = 0;
+        m_Deadlines.fill(NEVER);
+        m_NextDeadline = NEVER;
+    }
+
+    void Scheduler::SaveState(StateWriter& writer) const
+    {
+        writer.Write(m_Cycles);
+        for (uint64_t deadline: m_Deadlines)
+            writer.Write(deadline);
+    }
+
+    void Scheduler::LoadState(StateReader& reader)
+    {
+        reader.Read(m_Cycles);
+        for (uint64_t& deadline: m_Deadlines)
+            reader.Read(deadline);
+
+        _UpdateNextDeadline();
+    }
+
+    void Scheduler::Schedule(SchedulerEvent event, uint64_t cycles)
+    {
+        uint64_t& deadline = m_Deadlines[static_cast<size_t>(event)];
+        bool wasNext = deadline == m_NextDeadline;
+        deadline = cycles;
+
+        if (cycles <= m_NextDeadline)
+            m_NextDeadline = cycles;
+        else if (wasNext)
+            _UpdateNextDeadline();
+    }
+
+    SchedulerEvent Scheduler::PopDueEvent()
+    {
+        if (!HasDueEvent())
+            return SchedulerEvent::COUNT;
+
+        for (size_t i = 0; i < EVENT_COUNT; i++)
+        {
+            if (m_Cycles < m_Deadlines[i])
+                continue;
+
+            SchedulerEvent event = static_cast<SchedulerEvent>(i);
+            Cancel(event);
+            return event;
+        }
+
+        return SchedulerEvent::COUNT;
+    }
+
+    void Scheduler::_UpdateNextDeadline()
+    {
+        m_NextDeadline = *std::min_element(m_Deadlines.begin(), m_Deadlines.end());
+    }
+} // namespace GBE
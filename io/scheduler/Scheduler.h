@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <array>
+
+#include "util/Class.h"
+
+namespace GBE
+{
+    class StateWriter;
+    class StateReader;
+
+    // hardware events, when several are due they run in this order
+    enum class SchedulerEvent : uint8_t
+    {
+        TIMER = 0,  // tima overflow
+        PPU,        // end of the dots the ppu is waiting for
+        DMA,        // oam dma transfer
+        INPUT,      // joypad event, before the next instruction
+        COUNT
+    };
+
+    // global m-cycle clock and the deadline of every hardware event
+    // the cpu runs freely until the next deadline, hardware only works when its event is due
+    // there are only a few events so deadlines are a fixed array with a cached minimum
+    class Scheduler
+    {
+    public:
+        GBE_CLASS_NO_COPY_NO_MOVE(Scheduler)
+
+        static constexpr uint64_t NEVER = UINT64_MAX;
+
+        Scheduler();
+        ~Scheduler() = default;
+
+        // reset clock and cancel all events
+        void Init();
+
+        // clock and deadlines
+        void SaveState(StateWriter& writer) const;
+        void LoadState(StateReader& reader);
+
+        // m-cycles since init
+        inline uint64_t GetCycles() const
+        {
+            return m_Cycles;
+        }
+
+        inline void Advance(uint32_t cycles)
+        {
+            m_Cycles += cycles;
+        }
+
+        // run event at the absolute cycle, replaces its previous deadline
+        void Schedule(SchedulerEvent event, uint64_t cycles);
+
+        inline void Cancel(SchedulerEvent event)
+        {
+            Schedule(event, NEVER);
+        }
+
+        inline uint64_t GetDeadline(SchedulerEvent event) const
+        {
+            return m_Deadlines[static_cast<size_t>(event)];
+        }
+
+        inline uint64_t GetNextDeadline() const
+        {
+            return m_NextDeadline;
+        }
+
+        inline bool IsDue(SchedulerEvent event) const
+        {
+            return m_Cycles >= GetDeadline(event);
+        }
+
+        inline bool HasDueEvent() const
+        {
+            return m_Cycles >= m_NextDeadline;
+        }
+
+        // cancel and return the first due event, COUNT if none
+        SchedulerEvent PopDueEvent();
+
+    private:
+        static constexpr size_t EVENT_COUNT = static_cast<size_t>(SchedulerEvent::COUNT);
+
+        uint64_t m_Cycles = 0;
+        uint64_t m_NextDeadline = NEVER;
+        std::array<uint64_t, EVENT_COUNT> m_Deadlines{};
+
+        void _UpdateNextDeadline();
+    };
+} // namespace GBE
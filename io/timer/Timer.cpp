@@ -1,13 +1,19 @@
 #include "Timer.h"
 #include "util/Binary.h"
+#include "util/StateWriter.h"
+#include "util/StateReader.h"
 
 
 namespace GBE
 {
+    // DIV is the upper byte of the system counter
+    constexpr uint8_t DIV_SHIFT = 6;
+    constexpr uint64_t TIMA_OVERFLOW = 0x100;
 
-    Timer::Timer(const std::shared_ptr<InterruptManager> &interruptManager)
+    Timer::Timer(const std::shared_ptr<InterruptManager> &interruptManager, const std::shared_ptr<Scheduler>& scheduler)
     {
         m_InterruptManager = interruptManager;
+        m_Scheduler = scheduler;
     }
 
     Timer::~Timer()
@@ -17,50 +23,52 @@ namespace GBE
     void Timer::Init()
     {
         SetReadWriteFlags(true);
-        
-        m_DIVClock = 0;
-        m_Clock = 0;
 
-        _SetRegister(TimerRegister::DIV, 0x18);
+        m_Counter = static_cast<uint64_t>(0x18) << DIV_SHIFT;
+        m_Cycles = m_Scheduler->GetCycles();
+
         _SetRegister(TimerRegister::TIMA, 0x00);
         _SetRegister(TimerRegister::TMA, 0x00);
         _SetRegister(TimerRegister::TAC, 0xF8);
+
+        _ScheduleOverflow();
     }
 
-    void Timer::Tick()
+    void Timer::SaveState(StateWriter& writer) const
     {
-        m_DIVClock++;
-        if (m_DIVClock == 64)
-        {
-            m_DIVClock = 0;
-            uint8_t div = _GetRegister(TimerRegister::DIV);
-            div++;
-            _SetRegister(TimerRegister::DIV, div);
-        }
-        
-        if (_IsTimerControlEnabled())
-        {
-            m_Clock++;
-            if (m_Clock == _GetClockCycles())
-            {
-                m_Clock = 0;
-                uint16_t tima = static_cast<uint16_t>(_GetRegister(TimerRegister::TIMA));
-                tima++;
-                if (tima > 0xFF)
-                {
-                    uint16_t tma = static_cast<uint16_t>(_GetRegister(TimerRegister::TMA));
-                    tima = tma;
-                    m_InterruptManager->QueueInterrupt(InterruptFlag::TIMER);
-                }
-                _SetRegister(TimerRegister::TIMA, static_cast<uint8_t>(tima & 0xFF));
-                
-            }
-        }
+        MemoryArea::SaveState(writer);
+
+        writer.WriteBytes(m_Data.data(), m_Data.size());
+        writer.Write(m_Counter);
+        writer.Write(m_Cycles);
+    }
+
+    void Timer::LoadState(StateReader& reader)
+    {
+        MemoryArea::LoadState(reader);
+
+        // the overflow deadline is restored with the scheduler
+        reader.ReadBytes(m_Data.data(), m_Data.size());
+        reader.Read(m_Counter);
+        reader.Read(m_Cycles);
+    }
+
+    void Timer::Update()
+    {
+        _Sync();
+        _ScheduleOverflow();
     }
 
     void Timer::ResetDIV()
     {
-        _SetRegister(TimerRegister::DIV, 0);
+        _Sync();
+
+        // the selected bit falls if it was set
+        if (_GetTimerSignal(m_Counter))
+            _Increment(1);
+
+        m_Counter = 0;
+        _ScheduleOverflow();
     }
 
     void Timer::_SetImp(uint16_t address, uint8_t value)
@@ -72,37 +80,128 @@ namespace GBE
             return;
         }
 
+        _Sync();
+
         if (reg == TimerRegister::TAC)
         {
+            // disabling the timer or selecting a cleared bit is a falling edge too
+            bool signal = _GetTimerSignal(m_Counter);
             uint8_t mask = 0b0111;
             _SetRegister(reg, value & mask);
-            return;
+
+            if (signal && !_GetTimerSignal(m_Counter))
+                _Increment(1);
+        }
+        else
+        {
+            _SetRegister(reg, value);
         }
 
-        _SetRegister(reg, value);
+        _ScheduleOverflow();
     }
 
     uint8_t Timer::_GetImp(uint16_t address) const
     {
         TimerRegister reg = static_cast<TimerRegister>(address);
+        uint64_t counter = _GetCounter();
+
+        if (reg == TimerRegister::DIV)
+            return static_cast<uint8_t>(counter >> DIV_SHIFT);
+
+        if (reg == TimerRegister::TIMA)
+        {
+            uint8_t tima = _GetRegister(TimerRegister::TIMA);
+            _IncrementTIMA(_GetIncrements(m_Counter, counter), tima);
+            return tima;
+        }
+
         return _GetRegister(reg);
     }
 
-    uint16_t Timer::_GetClockCycles() const
+    bool Timer::_GetTimerSignal(uint64_t counter) const
+    {
+        return _IsTimerControlEnabled() && Binary::TestBit<uint64_t>(counter, _GetClockShift() - 1);
+    }
+
+    uint64_t Timer::_GetIncrements(uint64_t from, uint64_t to) const
+    {
+        if (!_IsTimerControlEnabled())
+            return 0;
+
+        uint8_t shift = _GetClockShift();
+        return (to >> shift) - (from >> shift);
+    }
+
+    uint64_t Timer::_IncrementTIMA(uint64_t increments, uint8_t& tima) const
+    {
+        uint64_t toOverflow = TIMA_OVERFLOW - tima;
+        if (increments < toOverflow)
+        {
+            tima += increments;
+            return 0;
+        }
+
+        // reloaded with TMA on every overflow
+        uint64_t tma = _GetRegister(TimerRegister::TMA);
+        uint64_t reloadPeriod = TIMA_OVERFLOW - tma;
+        increments -= toOverflow;
+
+        tima = static_cast<uint8_t>(tma + increments % reloadPeriod);
+        return 1 + increments / reloadPeriod;
+    }
+
+    void Timer::_Sync()
+    {
+        uint64_t counter = _GetCounter();
+        uint64_t increments = _GetIncrements(m_Counter, counter);
+
+        m_Counter = counter;
+        m_Cycles = m_Scheduler->GetCycles();
+
+        _Increment(increments);
+    }
+
+    void Timer::_Increment(uint64_t increments)
+    {
+        uint8_t tima = _GetRegister(TimerRegister::TIMA);
+        if (_IncrementTIMA(increments, tima) > 0)
+            m_InterruptManager->QueueInterrupt(InterruptFlag::TIMER);
+
+        _SetRegister(TimerRegister::TIMA, tima);
+    }
+
+    void Timer::_ScheduleOverflow()
+    {
+        if (!_IsTimerControlEnabled())
+        {
+            m_Scheduler->Cancel(SchedulerEvent::TIMER);
+            return;
+        }
+
+        // counter of the falling edge overflowing TIMA
+        uint8_t shift = _GetClockShift();
+        uint64_t increments = TIMA_OVERFLOW - _GetRegister(TimerRegister::TIMA);
+        uint64_t overflowCounter = ((m_Counter >> shift) + increments) << shift;
+
+        m_Scheduler->Schedule(SchedulerEvent::TIMER, m_Cycles + (overflowCounter - m_Counter));
+    }
+
+    uint8_t Timer::_GetClockShift() const
     {
         uint8_t mask = 0b0011;
         uint8_t clockSelect = _GetRegister(TimerRegister::TAC) & mask;
 
+        // periods of 256, 4, 16 and 64 m-cycles
         switch (clockSelect)
         {
         case 0:
-            return 256;
+            return 8;
         case 1:
-            return 4;
+            return 2;
         case 2:
-            return 16;
+            return 4;
         case 3:
-            return 64;
+            return 6;
         default:
             return 0;
         }
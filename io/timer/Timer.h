@@ -4,6 +4,7 @@
 #include "memory/MemoryArea.h"
 
 #include "io/interrupts/InterruptManager.h"
+#include "io/scheduler/Scheduler.h"
 
 #include <memory>
 #include <cstdint>
@@ -21,30 +22,58 @@ namespace GBE
         TAC = 0x3,  // Timer control
     };
 
+    // DIV and TIMA are derived from the m-cycles system counter, DIV is its bits 6-13
+    // TIMA increments on the falling edges of the counter bit selected by TAC
+    // the timer only works when read, written or on the scheduled overflow
     class Timer: public MemoryArea
     {
     public:
-        Timer(const std::shared_ptr<InterruptManager>& interruptManager);
+        Timer(const std::shared_ptr<InterruptManager>& interruptManager, const std::shared_ptr<Scheduler>& scheduler);
         ~Timer();
 
         void Init() override;
 
-        // tick for one m-cycle
-        void Tick();
+        void SaveState(StateWriter& writer) const override;
+        void LoadState(StateReader& reader) override;
 
-        // 
+        // catch up with the scheduler clock and schedule the next overflow
+        // called when the timer event is due
+        void Update();
+
+        // reset the system counter
         void ResetDIV();
     private:
         std::shared_ptr<InterruptManager> m_InterruptManager = nullptr;
+        std::shared_ptr<Scheduler> m_Scheduler = nullptr;
         std::array<uint8_t, MMAP_TIMER.GetSize()> m_Data{};
 
-        uint16_t m_DIVClock = 0;
-        uint16_t m_Clock = 0;
+        // system counter at the scheduler cycles m_Cycles, never wraps
+        uint64_t m_Counter = 0;
+        uint64_t m_Cycles = 0;
 
         void _SetImp(uint16_t address, uint8_t value) override;
         uint8_t _GetImp(uint16_t address) const override;
-    
-        uint16_t _GetClockCycles() const;
+
+        inline uint64_t _GetCounter() const
+        {
+            return m_Counter + (m_Scheduler->GetCycles() - m_Cycles);
+        }
+
+        // counter bit clocking TIMA is at 1 and the timer is enabled
+        bool _GetTimerSignal(uint64_t counter) const;
+        // falling edges of the timer signal between two counter values
+        uint64_t _GetIncrements(uint64_t from, uint64_t to) const;
+        // TIMA after increments, returns the number of overflows
+        uint64_t _IncrementTIMA(uint64_t increments, uint8_t& tima) const;
+
+        // apply the increments up to the scheduler clock
+        void _Sync();
+        void _Increment(uint64_t increments);
+        // schedule the timer event on the next tima overflow
+        void _ScheduleOverflow();
+
+        // log2 of the counter period clocking TIMA
+        uint8_t _GetClockShift() const;
         bool _IsTimerControlEnabled() const;
 
         inline uint8_t _GetRegister(TimerRegister reg) const
@@ -55,7 +84,7 @@ namespace GBE
         inline void _SetRegister(TimerRegister reg, uint8_t value)
         {
             if (reg == TimerRegister::TAC)
-                value = 0xF8 | value & 0x7;
+                value = 0xF8 | (value & 0x7);
 
             m_Data[static_cast<size_t>(reg)] = value;
         }
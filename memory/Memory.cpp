@@ -10,73 +10,118 @@ namespace GBE
             orderedMMaps.insert(mmap);
 
         m_MemoryAreas[area] = std::move(orderedMMaps);
-    }
-
-    void Memory::Set(uint16_t address, uint8_t value)
-    {
-        MemoryArea* marea = nullptr;
-        uint16_t localAddress = _FindMemoryArea(address, marea);
-
-        if (marea)
-            marea->Set(localAddress, value);
-    }
-
-    uint8_t Memory::Get(uint16_t address) const
-    {
-        MemoryArea* marea = nullptr;
-        uint16_t localAddress = _FindMemoryArea(address, marea);
-
-        if (!marea)
-            return 0xFF;
 
-        return marea->Get(localAddress);
+        _BuildPages();
     }
 
-    uint16_t Memory::_FindMemoryArea(uint16_t address, MemoryArea*& oMemoryArea) const
+    void Memory::_BuildPages()
     {
-        AddressCache& cache = m_AddressCache[address];
-        if (cache.Area)
-        {
-            oMemoryArea = cache.Area.get();
-            return cache.LocalAddress;
-        }
+        m_Pages.fill(MemoryPage{});
+        for (auto& slots: m_PagesSlots)
+            slots.reset();
 
         for (const auto& [marea, mmaps]: m_MemoryAreas)
         {
+            MemoryArea* area = marea.get();
+
+            // local addresses follow the order of the memory maps
             uint16_t localAddress = 0;
             for (const auto& mmap: mmaps)
             {
-                if (mmap.In(address))
+                uint32_t address = mmap.GetStart();
+                while (address <= mmap.GetEnd())
                 {
-                    oMemoryArea = marea.get();
-                    localAddress += address - mmap.GetStart();
-                    
-                    // cache area
-                    cache.Area = marea;
-                    cache.LocalAddress = localAddress;
-                    
-                    return localAddress;
+                    uint16_t pageIndex = address >> MEMORY_PAGE_SHIFT;
+                    uint16_t offset = address & MEMORY_PAGE_MASK;
+                    uint16_t local = localAddress + (address - mmap.GetStart());
+
+                    // whole page owned by the area
+                    if (offset == 0 && address + MEMORY_PAGE_MASK <= mmap.GetEnd())
+                    {
+                        MemoryPage& page = m_Pages[pageIndex];
+                        page.Area = area;
+                        page.LocalAddress = local;
+                        page.ReadData = area->GetReadData(local, MEMORY_PAGE_SIZE);
+                        page.WriteData = area->GetWriteData(local, MEMORY_PAGE_SIZE);
+
+                        address += MEMORY_PAGE_SIZE;
+                        continue;
+                    }
+
+                    // page shared with other areas
+                    auto& slots = m_PagesSlots[pageIndex];
+                    if (!slots)
+                    {
+                        slots = std::make_unique<MemorySlots>();
+                        m_Pages[pageIndex].Slots = slots.get();
+                    }
+
+                    MemorySlot& slot = (*slots)[offset];
+                    slot.Area = area;
+                    slot.LocalAddress = local;
+                    slot.ReadData = area->GetReadData(local, 1);
+                    slot.WriteData = area->GetWriteData(local, 1);
+
+                    address++;
                 }
+
                 localAddress += mmap.GetSize();
             }
         }
-
-        oMemoryArea = nullptr;
-        return 0;
     }
 
-    void Memory::Set16(uint16_t address, uint16_t value)
+    void Memory::_SetSlow(uint16_t address, uint8_t value)
     {
-        Set(address, value & 0xff);
-        Set(address + 1, value >> 8);
+        const MemoryPage& page = m_Pages[address >> MEMORY_PAGE_SHIFT];
+        uint16_t offset = address & MEMORY_PAGE_MASK;
+
+        if (page.Area)
+        {
+            page.Area->Set(page.LocalAddress + offset, value);
+            return;
+        }
+
+        if (!page.Slots)
+            return;
+
+        const MemorySlot& slot = (*page.Slots)[offset];
+        if (!slot.Area)
+            return;
+
+        if (slot.WriteData && slot.Area->GetWriteFlag())
+        {
+            *slot.WriteData = value;
+            return;
+        }
+
+        slot.Area->Set(slot.LocalAddress, value);
     }
 
-    uint16_t Memory::Get16(uint16_t address) const
+    uint8_t Memory::_GetSlow(uint16_t address) const
     {
-        uint16_t little = Get(address);
-        uint16_t big = Get(address + 1);
+        const MemoryPage& page = m_Pages[address >> MEMORY_PAGE_SHIFT];
+        uint16_t offset = address & MEMORY_PAGE_MASK;
+
+        if (page.Area)
+            return page.Area->Get(page.LocalAddress + offset);
+
+        if (!page.Slots)
+            return 0xFF;
+
+        const MemorySlot& slot = (*page.Slots)[offset];
+        if (!slot.Area)
+            return 0xFF;
+
+        if (slot.ReadData && slot.Area->GetReadFlag())
+            return *slot.ReadData;
+
+        return slot.Area->Get(slot.LocalAddress);
+    }
 
-        return little + (big << 8);
+    void Memory::Set16(uint16_t address, uint16_t value)
+    {
+        Set(address, value & 0xff);
+        Set(address + 1, value >> 8);
     }
 
     void Memory::CopyBuffer(uint16_t address, const void *data, uint16_t size)
@@ -91,15 +136,27 @@ namespace GBE
     {
         for (auto& [memoryArea, memoryMaps]: m_MemoryAreas)
             memoryArea->Init();
+
+        // areas may allocate their data on init
+        _BuildPages();
     }
 
     void Memory::Reset()
     {
-        m_AddressCache.fill(AddressCache{
-            .LocalAddress = 0, 
-            .Area = nullptr
-        });
         m_MemoryAreas.clear();
+        _BuildPages();
+    }
+
+    void Memory::WatchPage(uint16_t address, bool isWatched)
+    {
+        m_WatchedPages[address >> MEMORY_PAGE_SHIFT] = isWatched && m_WriteWatcher;
+    }
+
+    void Memory::SetWriteWatcher(WriteWatcher watcher)
+    {
+        m_WriteWatcher = std::move(watcher);
+        if (!m_WriteWatcher)
+            m_WatchedPages.fill(false);
     }
 
 } // namespace GBE
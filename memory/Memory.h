@@ -7,8 +7,8 @@
 
 #include <memory>
 #include <cstdint>
+#include <functional>
 #include <vector>
-#include <unordered_map>
 #include <set>
 #include <map>
 #include <array>
@@ -43,17 +43,52 @@ namespace GBE
             _MapMemoryArea(vectorOfMaps, area);
         }
 
+        // called before a write to a watched page
+        using WriteWatcher = std::function<void(uint16_t address)>;
+
         // set value at adress
-       void Set(uint16_t address, uint8_t value);
+        inline void Set(uint16_t address, uint8_t value)
+        {
+            uint16_t pageIndex = address >> MEMORY_PAGE_SHIFT;
+            if (m_WatchedPages[pageIndex]) [[unlikely]]
+                m_WriteWatcher(address);
+
+            const MemoryPage& page = m_Pages[pageIndex];
+            if (page.WriteData && page.Area->GetWriteFlag())
+            {
+                page.WriteData[address & MEMORY_PAGE_MASK] = value;
+                return;
+            }
+
+            _SetSlow(address, value);
+        }
 
         // get value from adress
-        uint8_t Get(uint16_t address) const;
+        inline uint8_t Get(uint16_t address) const
+        {
+            const MemoryPage& page = m_Pages[address >> MEMORY_PAGE_SHIFT];
+            if (page.ReadData && page.Area->GetReadFlag())
+                return page.ReadData[address & MEMORY_PAGE_MASK];
+
+            return _GetSlow(address);
+        }
 
         // set value at adress
         void Set16(uint16_t address, uint16_t value);
 
         // get value from adress
-        uint16_t Get16(uint16_t address) const;
+        inline uint16_t Get16(uint16_t address) const
+        {
+            const MemoryPage& page = m_Pages[address >> MEMORY_PAGE_SHIFT];
+            uint8_t offset = address & MEMORY_PAGE_MASK;
+            if (page.ReadData && offset != MEMORY_PAGE_MASK && page.Area->GetReadFlag())
+                return page.ReadData[offset] | (page.ReadData[offset + 1] << 8);
+
+            uint16_t little = Get(address);
+            uint16_t big = Get(address + 1);
+
+            return little + (big << 8);
+        }
 
         // copy buffer to memory
         void CopyBuffer(uint16_t address, const void *data, uint16_t size);
@@ -61,20 +96,61 @@ namespace GBE
         void Init();
         void Reset();
 
+        // notify watcher of the writes to the page containing address
+        void WatchPage(uint16_t address, bool isWatched);
+
+        // set the watcher of the watched pages, unwatch all pages when reset
+        void SetWriteWatcher(WriteWatcher watcher);
+
+        // compiled code accesses the fields directly
+        friend class CpuJit;
+
     private:
-        uint16_t _FindMemoryArea(uint16_t address, MemoryArea*& oMemoryArea) const;
-        
-        struct AddressCache
+        static constexpr uint16_t MEMORY_PAGE_SHIFT = 8;
+        static constexpr uint16_t MEMORY_PAGE_SIZE = 1 << MEMORY_PAGE_SHIFT;
+        static constexpr uint16_t MEMORY_PAGE_MASK = MEMORY_PAGE_SIZE - 1;
+        static constexpr uint16_t MEMORY_PAGE_COUNT = (UINT16_MAX + 1) / MEMORY_PAGE_SIZE;
+
+        // one address of a page shared by several memory areas
+        struct MemorySlot
+        {
+            MemoryArea* Area = nullptr;
+            uint16_t LocalAddress = 0;
+            const uint8_t* ReadData = nullptr;
+            uint8_t* WriteData = nullptr;
+        };
+
+        using MemorySlots = std::array<MemorySlot, MEMORY_PAGE_SIZE>;
+
+        // 256 bytes of the address space, indexed by the high byte of the address
+        struct MemoryPage
         {
+            // direct access to the page bytes, null when the area has to go through its handler
+            const uint8_t* ReadData = nullptr;
+            uint8_t* WriteData = nullptr;
+
+            // area mapping the whole page
+            MemoryArea* Area = nullptr;
             uint16_t LocalAddress = 0;
-            std::shared_ptr<MemoryArea> Area{nullptr};
+
+            // per address mapping of a page shared by several areas (io / hram)
+            const MemorySlots* Slots = nullptr;
         };
 
-        mutable std::array<AddressCache, UINT16_MAX + 1> m_AddressCache{}; // cache should be modifiable even when const
+        std::array<MemoryPage, MEMORY_PAGE_COUNT> m_Pages{};
+        std::array<std::unique_ptr<MemorySlots>, MEMORY_PAGE_COUNT> m_PagesSlots{};
         std::map<std::shared_ptr<MemoryArea>, std::set<MemoryMap>> m_MemoryAreas{};
-        const std::shared_ptr<MemoryArea> m_MemoryAreaNotFound = nullptr;
+
+        std::array<bool, MEMORY_PAGE_COUNT> m_WatchedPages{};
+        WriteWatcher m_WriteWatcher = nullptr;
 
         // map memory area
         void _MapMemoryArea(const std::vector<MemoryMap> &mmaps, std::shared_ptr<MemoryArea> area);
+        // rebuild the page table from the mapped memory areas
+        void _BuildPages();
+
+        // handlers, slots and unmapped addresses
+        void _SetSlow(uint16_t address, uint8_t value);
+        uint8_t _GetSlow(uint16_t address) const;
     };
 } // namespace GBE
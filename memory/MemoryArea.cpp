@@ -1,4 +1,8 @@
 #include "MemoryArea.h"
+
+#include "util/StateWriter.h"
+#include "util/StateReader.h"
+
 #include <unordered_map>
 
 namespace GBE
@@ -25,4 +29,16 @@ namespace GBE
 
         return _GetImp(address);
     }
+
+    void MemoryArea::SaveState(StateWriter& writer) const
+    {
+        writer.Write(m_ReadFlag);
+        writer.Write(m_WriteFlag);
+    }
+
+    void MemoryArea::LoadState(StateReader& reader)
+    {
+        reader.Read(m_ReadFlag);
+        reader.Read(m_WriteFlag);
+    }
 } // namespace GBE
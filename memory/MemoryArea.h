@@ -4,6 +4,8 @@
 
 namespace GBE
 {
+    class StateWriter;
+    class StateReader;
 
     // base class for any memory area 
     // memory area has read and write privileges
@@ -43,12 +45,31 @@ namespace GBE
         // get byte from address
         uint8_t Get(uint16_t address) const;
 
+        // direct access to the bytes [address, address + size), nullptr if they have to go through Get / Set
+        // the pointer must stay valid for the lifetime of the memory area
+        virtual const uint8_t* GetReadData(uint16_t, uint16_t) const
+        {
+            return nullptr;
+        }
+
+        virtual uint8_t* GetWriteData(uint16_t, uint16_t)
+        {
+            return nullptr;
+        }
+
         // init memory area
         virtual void Init() = 0;
+
+        // save / load the area in a save state, overrides write their data after the flags
+        virtual void SaveState(StateWriter& writer) const;
+        virtual void LoadState(StateReader& reader);
     protected:
         virtual void _SetImp(uint16_t address, uint8_t value) = 0;
         virtual uint8_t _GetImp(uint16_t address) const = 0;
         
+        // compiled code accesses the fields directly
+        friend class CpuJit;
+
     private:
         bool m_ReadFlag = false;
         bool m_WriteFlag = false;
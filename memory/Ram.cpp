@@ -1,5 +1,8 @@
 #include "Ram.h"
 
+#include "util/StateWriter.h"
+#include "util/StateReader.h"
+
 namespace GBE
 {
 
@@ -13,6 +16,34 @@ namespace GBE
         SetReadWriteFlags(true);
     }
 
+    void Ram::SaveState(StateWriter& writer) const
+    {
+        MemoryArea::SaveState(writer);
+        writer.WriteBytes(m_Data.data(), m_Data.size());
+    }
+
+    void Ram::LoadState(StateReader& reader)
+    {
+        MemoryArea::LoadState(reader);
+        reader.ReadBytes(m_Data.data(), m_Data.size());
+    }
+
+    const uint8_t* Ram::GetReadData(uint16_t address, uint16_t size) const
+    {
+        if (address + size > m_Data.size())
+            return nullptr;
+
+        return m_Data.data() + address;
+    }
+
+    uint8_t* Ram::GetWriteData(uint16_t address, uint16_t size)
+    {
+        if (address + size > m_Data.size())
+            return nullptr;
+
+        return m_Data.data() + address;
+    }
+
     uint8_t Ram::_GetImp(uint16_t address) const
     {
         return m_Data.at(address);
@@ -31,6 +31,12 @@ namespace GBE
         ~Ram() = default;
 
         void Init() override;
+
+        void SaveState(StateWriter& writer) const override;
+        void LoadState(StateReader& reader) override;
+
+        const uint8_t* GetReadData(uint16_t address, uint16_t size) const override;
+        uint8_t* GetWriteData(uint16_t address, uint16_t size) override;
     private:
         std::vector<uint8_t> m_Data{};
 
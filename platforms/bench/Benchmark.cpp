@@ -0,0 +1,241 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <format>
+#include <new>
+
+namespace
+{
+    std::atomic<uint64_t> s_AllocationsCount = 0;
+
+    void* CountedAllocate(std::size_t size)
+    {
+        s_AllocationsCount.fetch_add(1, std::memory_order_relaxed);
+        if (void* ptr = std::malloc(size == 0 ? 1 : size))
+            return ptr;
+
+        throw std::bad_alloc();
+    }
+
+    double Percentile(const std::vector<double>& sortedValues, double percentile)
+    {
+        if (sortedValues.empty())
+            return 0.0;
+
+        // nearest rank
+        size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sortedValues.size()));
+        rank = std::clamp<size_t>(rank, 1, sortedValues.size());
+        return sortedValues[rank - 1];
+    }
+
+    std::string JsonString(std::string_view text)
+    {
+        std::string result = "\"";
+        for (char c: text)
+        {
+            switch (c)
+            {
+            case '"':
+                result += "\\\"";
+                break;
+            case '\\':
+                result += "\\\\";
+                break;
+            case '\n':
+                result += "\\n";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    result += std::format("\\u{:04x}", static_cast<int>(c));
+                else
+                    result += c;
+            }
+        }
+        result += "\"";
+        return result;
+    }
+
+    double PerSecond(uint64_t count, double seconds)
+    {
+        return seconds > 0.0 ? static_cast<double>(count) / seconds : 0.0;
+    }
+
+    double Ratio(uint64_t count, uint64_t total)
+    {
+        return total > 0 ? static_cast<double>(count) / static_cast<double>(total) : 0.0;
+    }
+
+    std::vector<GBEBench::BenchmarkEntry>& GetBenchmarksRegistry()
+    {
+        static std::vector<GBEBench::BenchmarkEntry> benchmarks{};
+        return benchmarks;
+    }
+} // namespace
+
+// count every heap allocation of the process
+void* operator new(std::size_t size)
+{
+    return CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return CountedAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace GBEBench
+{
+    bool RegisterBenchmark(BenchmarkEntry entry)
+    {
+        auto& benchmarks = GetBenchmarksRegistry();
+        for (const auto& benchmark: benchmarks)
+        {
+            if (benchmark.Name == entry.Name)
+                return false;
+        }
+
+        benchmarks.push_back(std::move(entry));
+        return true;
+    }
+
+    const std::vector<BenchmarkEntry>& GetBenchmarks()
+    {
+        return GetBenchmarksRegistry();
+    }
+
+    uint64_t GetAllocationsCount()
+    {
+        return s_AllocationsCount.load(std::memory_order_relaxed);
+    }
+
+    BenchmarkReport RunBenchmark(const BenchmarkEntry& entry, const BenchmarkOptions& options)
+    {
+        BenchmarkReport report{};
+        report.Name = entry.Name;
+        report.Unit = entry.Unit;
+        report.Repetitions = options.Repetitions;
+
+        std::unique_ptr<BenchmarkFixture> fixture = entry.CreateFixture();
+
+        // warmup
+        for (uint32_t i = 0; i < options.Warmup; i++)
+        {
+            BenchmarkCounters counters{};
+            fixture->SetUp();
+            fixture->Run(counters);
+        }
+
+        std::vector<double> nanosecondsPerOperation{};
+        nanosecondsPerOperation.reserve(options.Repetitions);
+
+        for (uint32_t i = 0; i < options.Repetitions; i++)
+        {
+            BenchmarkCounters counters{};
+            fixture->SetUp();
+
+            const uint64_t allocationsStart = GetAllocationsCount();
+            const auto startTime = std::chrono::steady_clock::now();
+
+            fixture->Run(counters);
+
+            const auto endTime = std::chrono::steady_clock::now();
+            const uint64_t allocationsEnd = GetAllocationsCount();
+
+            double nanoseconds = std::chrono::duration<double, std::nano>(endTime - startTime).count();
+            nanosecondsPerOperation.push_back(nanoseconds / static_cast<double>(std::max<uint64_t>(counters.Operations, 1)));
+
+            report.Seconds += nanoseconds * 1e-9;
+            report.Allocations += allocationsEnd - allocationsStart;
+            report.Totals.Operations += counters.Operations;
+            report.Totals.Instructions += counters.Instructions;
+            report.Totals.Dots += counters.Dots;
+            report.Totals.Frames += counters.Frames;
+        }
+
+        std::sort(nanosecondsPerOperation.begin(), nanosecondsPerOperation.end());
+
+        BenchmarkPercentiles& percentiles = report.NanosecondsPerOperation;
+        if (!nanosecondsPerOperation.empty())
+        {
+            double sum = 0.0;
+            for (double value: nanosecondsPerOperation)
+                sum += value;
+
+            percentiles.Mean = sum / static_cast<double>(nanosecondsPerOperation.size());
+            percentiles.Min = nanosecondsPerOperation.front();
+            percentiles.Max = nanosecondsPerOperation.back();
+        }
+        percentiles.P50 = Percentile(nanosecondsPerOperation, 50.0);
+        percentiles.P90 = Percentile(nanosecondsPerOperation, 90.0);
+        percentiles.P99 = Percentile(nanosecondsPerOperation, 99.0);
+
+        return report;
+    }
+
+    std::string ToJson(const std::vector<BenchmarkReport>& reports, const BenchmarkOptions& options)
+    {
+        std::string json = "{\n";
+        json += "  \"version\": 1,\n";
+    #ifdef NDEBUG
+        json += "  \"build\": \"release\",\n";
+    #else
+        json += "  \"build\": \"debug\",\n";
+    #endif
+        json += std::format("  \"warmup\": {},\n", options.Warmup);
+        json += std::format("  \"repetitions\": {},\n", options.Repetitions);
+        json += "  \"benchmarks\": [";
+
+        for (size_t i = 0; i < reports.size(); i++)
+        {
+            const BenchmarkReport& report = reports[i];
+            const BenchmarkPercentiles& percentiles = report.NanosecondsPerOperation;
+
+            json += i == 0 ? "\n" : ",\n";
+            json += "    {\n";
+            json += std::format("      \"name\": {},\n", JsonString(report.Name));
+            json += std::format("      \"unit\": {},\n", JsonString(report.Unit));
+            json += std::format("      \"repetitions\": {},\n", report.Repetitions);
+            json += std::format("      \"operations\": {},\n", report.Totals.Operations);
+            json += std::format("      \"seconds\": {:.6f},\n", report.Seconds);
+            json += std::format(
+                "      \"ns_per_op\": {{\"mean\": {:.3f}, \"min\": {:.3f}, \"p50\": {:.3f}, \"p90\": {:.3f}, \"p99\": {:.3f}, \"max\": {:.3f}}},\n",
+                percentiles.Mean, percentiles.Min, percentiles.P50, percentiles.P90, percentiles.P99, percentiles.Max
+            );
+            json += std::format("      \"instructions_per_second\": {:.1f},\n", PerSecond(report.Totals.Instructions, report.Seconds));
+            json += std::format("      \"dots_per_second\": {:.1f},\n", PerSecond(report.Totals.Dots, report.Seconds));
+            json += std::format("      \"frames_per_second\": {:.3f},\n", PerSecond(report.Totals.Frames, report.Seconds));
+            json += std::format("      \"allocations\": {},\n", report.Allocations);
+            json += std::format("      \"allocations_per_op\": {:.6f},\n", Ratio(report.Allocations, report.Totals.Operations));
+            json += std::format("      \"allocations_per_frame\": {:.3f}\n", Ratio(report.Allocations, report.Totals.Frames));
+            json += "    }";
+        }
+
+        json += reports.empty() ? "]\n" : "\n  ]\n";
+        json += "}\n";
+        return json;
+    }
+} // namespace GBEBench
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace GBEBench
+{
+    // counters filled by one timed repetition
+    struct BenchmarkCounters
+    {
+        // number of operations the ns/op is computed from
+        uint64_t Operations = 0;
+        uint64_t Instructions = 0;
+        uint64_t Dots = 0;
+        uint64_t Frames = 0;
+    };
+
+    // a benchmark fixture is created once, SetUp runs untimed before every repetition and Run is timed
+    class BenchmarkFixture
+    {
+    public:
+        virtual ~BenchmarkFixture() = default;
+
+        virtual void SetUp() {}
+        virtual void Run(BenchmarkCounters& counters) = 0;
+    };
+
+    struct BenchmarkEntry
+    {
+        std::string Name = "";
+        // unit of one operation (frame, instruction, dot, access...)
+        std::string Unit = "";
+        std::function<std::unique_ptr<BenchmarkFixture>()> CreateFixture{};
+    };
+
+    struct BenchmarkOptions
+    {
+        uint32_t Warmup = 2;
+        uint32_t Repetitions = 10;
+        std::string Filter = "";
+        std::string RomsDirectory = "./test_roms";
+    };
+
+    struct BenchmarkPercentiles
+    {
+        double Mean = 0.0;
+        double Min = 0.0;
+        double P50 = 0.0;
+        double P90 = 0.0;
+        double P99 = 0.0;
+        double Max = 0.0;
+    };
+
+    struct BenchmarkReport
+    {
+        std::string Name = "";
+        std::string Unit = "";
+        uint32_t Repetitions = 0;
+        BenchmarkCounters Totals{};
+        uint64_t Allocations = 0;
+        double Seconds = 0.0;
+        // ns/op over the repetitions
+        BenchmarkPercentiles NanosecondsPerOperation{};
+    };
+
+    // register a benchmark, returns false if the name is already taken
+    bool RegisterBenchmark(BenchmarkEntry entry);
+    const std::vector<BenchmarkEntry>& GetBenchmarks();
+
+    // number of heap allocations since the start of the process (counted by the global operator new)
+    uint64_t GetAllocationsCount();
+
+    // run one benchmark with warmup and repetitions
+    BenchmarkReport RunBenchmark(const BenchmarkEntry& entry, const BenchmarkOptions& options);
+
+    // serialize reports as a json document
+    std::string ToJson(const std::vector<BenchmarkReport>& reports, const BenchmarkOptions& options);
+} // namespace GBEBench
@@ -0,0 +1,617 @@
+#include "Benchmarks.h"
+
+#include "gameboy/Gameboy.h"
+#include "gameboy/RewindBuffer.h"
+#include "gameboy/RunAhead.h"
+#include "cartridge/Cartridge.h"
+#include "memory/Memory.h"
+#include "io/timer/Timer.h"
+#include "io/interrupts/InterruptManager.h"
+#include "io/graphics/vram/Vram.h"
+#include "io/graphics/vram/TileDecoder.h"
+#include "cpu/instruction/InstructionResult.h"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <print>
+#include <span>
+
+namespace GBEBench
+{
+    namespace
+    {
+        constexpr uint32_t TICK_FRAMES = 60;
+        constexpr uint32_t CPU_INSTRUCTIONS = 1000000;
+        constexpr uint32_t PPU_FRAMES = 10;
+        constexpr uint32_t MEMORY_ACCESSES = 1 << 20;
+        constexpr uint32_t TIMER_TICKS = 1 << 22;
+        constexpr uint32_t TILE_DECODE_PASSES = 256;
+        constexpr uint32_t STATE_ROUND_TRIPS = 1000;
+        constexpr uint32_t RESETS = 1000;
+        constexpr size_t REWIND_CAPACITY = 16 * 1024 * 1024;
+
+        constexpr size_t SYNTHETIC_ROM_SIZE = 0x8000;
+        constexpr uint16_t SYNTHETIC_ENTRY = 0x0100;
+
+        using RomData = std::vector<uint8_t>;
+
+        // small programs looping forever at the rom entry point
+        // alu: INC A; ADD A,B; XOR C; DEC B; JR NZ,-6; JP 0x0100
+        constexpr std::array<uint8_t, 9> SYNTHETIC_ALU_LOOP = {
+            0x3C, 0x80, 0xA9, 0x05, 0x20, 0xFA, 0xC3, 0x00, 0x01
+        };
+
+        // memory: LD HL,0xC000; LD B,0; LD (HL+),A; INC A; LD A,(HL+); DEC B; JR NZ,-6; JP 0x0100
+        constexpr std::array<uint8_t, 14> SYNTHETIC_MEMORY_LOOP = {
+            0x21, 0x00, 0xC0, 0x06, 0x00, 0x22, 0x3C, 0x2A, 0x05, 0x20, 0xFA, 0xC3, 0x00, 0x01
+        };
+
+        // stack: CALL 0x0110; PUSH BC; POP BC; JR -7 ... 0x0110: INC A; RET
+        constexpr std::array<uint8_t, 18> SYNTHETIC_STACK_LOOP = {
+            0xCD, 0x10, 0x01, 0xC5, 0xC1, 0x18, 0xF9, 0x00,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            0x3C, 0xC9
+        };
+
+        template<size_t Size>
+        RomData MakeSyntheticRom(const std::array<uint8_t, Size>& program)
+        {
+            RomData rom(SYNTHETIC_ROM_SIZE, 0x00);
+            std::copy(program.begin(), program.end(), rom.begin() + SYNTHETIC_ENTRY);
+            return rom;
+        }
+
+        bool ReadRom(const std::filesystem::path& path, RomData& rom)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open())
+                return false;
+
+            rom.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            return !rom.empty();
+        }
+
+        // fresh gameboy running a rom
+        class GameboyInstance
+        {
+        public:
+            GameboyInstance(std::span<const uint8_t> rom, GBE::CpuEngine engine = GBE::CpuEngine::INTERPRETER)
+            {
+                m_Cartridge = std::make_shared<GBE::Cartridge>();
+                m_Cartridge->LoadFromData(rom);
+
+                m_Gameboy = std::make_unique<GBE::Gameboy>();
+                m_Gameboy->GetCpu().SetEngine(engine);
+                m_Gameboy->Start(m_Cartridge);
+            }
+
+            ~GameboyInstance()
+            {
+                m_Gameboy->Stop();
+            }
+
+            inline GBE::Gameboy& Get()
+            {
+                return *m_Gameboy;
+            }
+
+            void RunFrames(uint32_t frames)
+            {
+                for (uint32_t i = 0; i < frames; i++)
+                    m_Gameboy->Tick();
+            }
+
+        private:
+            std::shared_ptr<GBE::Cartridge> m_Cartridge = nullptr;
+            std::unique_ptr<GBE::Gameboy> m_Gameboy = nullptr;
+        };
+
+        // Gameboy::Tick, restarted from power on every repetition
+        class GameboyTickFixture: public BenchmarkFixture
+        {
+        public:
+            GameboyTickFixture(RomData rom): m_Rom(std::move(rom))
+            {
+            }
+
+            void SetUp() override
+            {
+                m_Instance.reset();
+                m_Instance = std::make_unique<GameboyInstance>(m_Rom);
+            }
+
+            void Run(BenchmarkCounters& counters) override
+            {
+                GBE::Gameboy& gameboy = m_Instance->Get();
+                const uint64_t instructionsStart = gameboy.GetCpu().GetInstructionsCounter();
+
+                for (uint32_t i = 0; i < TICK_FRAMES; i++)
+                    counters.Dots += gameboy.Tick() * GBE::DOT_TO_M_CYCLE;
+
+                counters.Frames = TICK_FRAMES;
+                counters.Operations = TICK_FRAMES;
+                counters.Instructions = gameboy.GetCpu().GetInstructionsCounter() - instructionsStart;
+            }
+
+        private:
+            RomData m_Rom{};
+            std::unique_ptr<GameboyInstance> m_Instance = nullptr;
+        };
+
+        // Cpu::Run alone, without timer / ppu / dma
+        class CpuRunFixture: public BenchmarkFixture
+        {
+        public:
+            CpuRunFixture(RomData rom, GBE::CpuEngine engine = GBE::CpuEngine::INTERPRETER): 
+                m_Rom(std::move(rom)), 
+                m_Instance(m_Rom, engine)
+            {
+                // cpu alone, jit blocks don't step the rest of the hardware
+                m_Instance.Get().GetCpu().SetHardwareStep(nullptr);
+            }
+
+            void Run(BenchmarkCounters& counters) override
+            {
+                GBE::Cpu& cpu = m_Instance.Get().GetCpu();
+                uint64_t startCounter = cpu.GetInstructionsCounter();
+                for (uint32_t i = 0; i < CPU_INSTRUCTIONS; i++)
+                {
+                    GBE::InstructionResult result{};
+                    cpu.Run(result);
+                }
+
+                // a jit run can execute a whole block
+                uint64_t instructions = cpu.GetInstructionsCounter() - startCounter;
+                counters.Operations = instructions;
+                counters.Instructions = instructions;
+            }
+
+        private:
+            RomData m_Rom{};
+            GameboyInstance m_Instance;
+        };
+
+        // Ppu::Tick alone, on the vram / oam state of a rom after a few frames
+        class PpuTickFixture: public BenchmarkFixture
+        {
+        public:
+            PpuTickFixture(RomData rom): m_Rom(std::move(rom)), m_Instance(m_Rom)
+            {
+                m_Instance.RunFrames(TICK_FRAMES);
+            }
+
+            void Run(BenchmarkCounters& counters) override
+            {
+                GBE::Ppu& ppu = m_Instance.Get().GetPpu();
+
+                constexpr uint32_t ticks = PPU_FRAMES * GBE::FRAME_DOTS / GBE::DOT_TO_M_CYCLE;
+                for (uint32_t i = 0; i < ticks; i++)
+                    ppu.Tick(GBE::DOT_TO_M_CYCLE);
+
+                counters.Frames = PPU_FRAMES;
+                counters.Dots = PPU_FRAMES * GBE::FRAME_DOTS;
+                counters.Operations = counters.Dots;
+            }
+
+        private:
+            RomData m_Rom{};
+            GameboyInstance m_Instance;
+        };
+
+        // Gameboy::SaveState followed by Gameboy::LoadState, on the state of a rom after a few frames
+        class StateFixture: public BenchmarkFixture
+        {
+        public:
+            StateFixture(RomData rom): m_Rom(std::move(rom)), m_Instance(m_Rom)
+            {
+                m_Instance.RunFrames(TICK_FRAMES);
+                m_State.resize(m_Instance.Get().GetStateSize());
+            }
+
+            void Run(BenchmarkCounters& counters) override
+            {
+                GBE::Gameboy& gameboy = m_Instance.Get();
+
+                for (uint32_t i = 0; i < STATE_ROUND_TRIPS; i++)
+                {
+                    gameboy.SaveState(m_State);
+                    gameboy.LoadState(m_State);
+                }
+
+                counters.Operations = STATE_ROUND_TRIPS;
+            }
+
+        private:
+            RomData m_Rom{};
+            GameboyInstance m_Instance;
+            std::vector<uint8_t> m_State{};
+        };
+
+        enum class ResetMode
+        {
+            RESET,      // Gameboy::Reset to the snapshot
+            RESTART     // Gameboy::Stop then Gameboy::Start
+        };
+
+        // restart a rom after a few frames
+        class ResetFixture: public BenchmarkFixture
+        {
+        public:
+            ResetFixture(RomData rom, ResetMode mode): m_Rom(std::move(rom)), m_Mode(mode)
+            {
+                m_Cartridge = std::make_shared<GBE::Cartridge>();
+                m_Cartridge->LoadFromData(m_Rom);
+                m_Gameboy.Start(m_Cartridge);
+
+                for (uint32_t i = 0; i < TICK_FRAMES; i++)
+                    m_Gameboy.Tick();
+            }
+
+            void Run(BenchmarkCounters& counters) override
+            {
+                for (uint32_t i = 0; i < RESETS; i++)
+                {
+                    if (m_Mode == ResetMode::RESET)
+                    {
+                        m_Gameboy.Reset();
+                        continue;
+                    }
+
+                    m_Gameboy.Stop();
+                    m_Gameboy.Start(m_Cartridge);
+                }
+
+                counters.Operations = RESETS;
+            }
+
+        private:
+            RomData m_Rom{};
+            ResetMode m_Mode;
+            std::shared_ptr<GBE::Cartridge> m_Cartridge = nullptr;
+            GBE::Gameboy m_Gameboy{};
+        };
+
+        enum class RewindMode
+        {
+            PUSH,       // Gameboy::Tick then RewindBuffer::Push, a snapshot every frame
+            STEP_BACK   // RewindBuffer::StepBack, re-emulating one frame
+        };
+
+        // rewind history of a rom, restarted from power on every repetition
+        class RewindFixture: public BenchmarkFixture
+        {
+        public:
+            RewindFixture(RomData rom, RewindMode mode): m_Rom(std::move(rom)), m_Mode(mode)
+            {
+                m_Rewind = std::make_unique<GBE::RewindBuffer>(REWIND_CAPACITY);
+            }
+
+            void SetUp() override
+            {
+                m_Instance.reset();
+                m_Instance = std::make_unique<GameboyInstance>(m_Rom);
+                m_Rewind->Clear();
+
+                // history to step back through
+                if (m_Mode == RewindMode::STEP_BACK)
+                    _PushFrames(TICK_FRAMES + 1);
+            }
+
+            void Run(BenchmarkCounters& counters) override
+            {
+                if (m_Mode == RewindMode::PUSH)
+                    _PushFrames(TICK_FRAMES);
+                else
+                {
+                    for (uint32_t i = 0; i < TICK_FRAMES; i++)
+                        m_Rewind->StepBack(m_Instance->Get());
+                }
+
+                counters.Frames = TICK_FRAMES;
+                counters.Operations = TICK_FRAMES;
+            }
+
+        private:
+            RomData m_Rom{};
+            RewindMode m_Mode;
+            std::unique_ptr<GameboyInstance> m_Instance = nullptr;
+            std::unique_ptr<GBE::RewindBuffer> m_Rewind = nullptr;
+
+            void _PushFrames(uint32_t frames)
+            {
+                GBE::Gameboy& gameboy = m_Instance->Get();
+                for (uint32_t i = 0; i < frames; i++)
+                {
+                    gameboy.Tick();
+                    m_Rewind->Push(gameboy);
+                }
+            }
+        };
+
+        // RunAhead::Tick, restarted from power on every repetition
+        class RunAheadFixture: public BenchmarkFixture
+        {
+        public:
+            RunAheadFixture(RomData rom, uint32_t frames): m_Rom(std::move(rom)), m_RunAhead(frames)
+            {
+            }
+
+            void SetUp() override
+            {
+                m_Instance.reset();
+                m_Instance = std::make_unique<GameboyInstance>(m_Rom);
+            }
+
+            void Run(BenchmarkCounters& counters) override
+            {
+                GBE::Gameboy& gameboy = m_Instance->Get();
+                for (uint32_t i = 0; i < TICK_FRAMES; i++)
+                    m_RunAhead.Tick(gameboy);
+
+                counters.Frames = TICK_FRAMES;
+                counters.Operations = TICK_FRAMES;
+            }
+
+        private:
+            RomData m_Rom{};
+            std::unique_ptr<GameboyInstance> m_Instance = nullptr;
+            GBE::RunAhead m_RunAhead;
+        };
+
+        enum class MemoryAccess
+        {
+            GET,
+            GET_16,
+            SET
+        };
+
+        // Memory::Get / Get16 / Set over a fixed list of addresses
+        class MemoryFixture: public BenchmarkFixture
+        {
+        public:
+            MemoryFixture(MemoryAccess access, std::vector<uint16_t> addresses):
+                m_Access(access),
+                m_Addresses(std::move(addresses)),
+                m_Rom(MakeSyntheticRom(SYNTHETIC_ALU_LOOP)),
+                m_Instance(m_Rom)
+            {
+            }
+
+            void Run(BenchmarkCounters& counters) override
+            {
+                GBE::Memory& memory = m_Instance.Get().GetMemory();
+                const size_t mask = m_Addresses.size() - 1;
+
+                uint32_t sum = 0;
+                for (uint32_t i = 0; i < MEMORY_ACCESSES; i++)
+                {
+                    uint16_t address = m_Addresses[i & mask];
+                    switch (m_Access)
+                    {
+                    case MemoryAccess::GET:
+                        sum += memory.Get(address);
+                        break;
+                    case MemoryAccess::GET_16:
+                        sum += memory.Get16(address);
+                        break;
+                    case MemoryAccess::SET:
+                        memory.Set(address, static_cast<uint8_t>(i));
+                        break;
+                    }
+                }
+
+                m_Sink = sum;
+                counters.Operations = MEMORY_ACCESSES;
+            }
+
+        private:
+            MemoryAccess m_Access;
+            std::vector<uint16_t> m_Addresses{};
+            RomData m_Rom{};
+            GameboyInstance m_Instance;
+            volatile uint32_t m_Sink = 0;
+        };
+
+        // pseudo random addresses in [begin, end], count must be a power of 2
+        std::vector<uint16_t> MakeAddresses(std::initializer_list<std::pair<uint16_t, uint16_t>> ranges, size_t count = 4096)
+        {
+            std::vector<uint16_t> addresses{};
+            addresses.reserve(count);
+
+            uint32_t seed = 0x12345678;
+            while (addresses.size() < count)
+            {
+                for (const auto& [begin, end]: ranges)
+                {
+                    seed = seed * 1664525 + 1013904223;
+                    addresses.push_back(static_cast<uint16_t>(begin + (seed >> 8) % (end - begin + 1)));
+                    if (addresses.size() == count)
+                        break;
+                }
+            }
+
+            return addresses;
+        }
+
+        // timer driven by the scheduler with the fastest timer clock enabled
+        class TimerTickFixture: public BenchmarkFixture
+        {
+        public:
+            TimerTickFixture():
+                m_InterruptManager(std::make_shared<GBE::InterruptManager>()),
+                m_Scheduler(std::make_shared<GBE::Scheduler>()),
+                m_Timer(m_InterruptManager, m_Scheduler)
+            {
+                m_InterruptManager->Init();
+                m_Timer.Init();
+                m_Timer.Set(static_cast<uint16_t>(GBE::TimerRegister::TAC), 0x05);
+            }
+
+            void Run(BenchmarkCounters& counters) override
+            {
+                for (uint32_t i = 0; i < TIMER_TICKS; i++)
+                {
+                    m_Scheduler->Advance(1);
+                    if (m_Scheduler->IsDue(GBE::SchedulerEvent::TIMER))
+                        m_Timer.Update();
+                }
+
+                counters.Operations = TIMER_TICKS;
+            }
+
+        private:
+            std::shared_ptr<GBE::InterruptManager> m_InterruptManager = nullptr;
+            std::shared_ptr<GBE::Scheduler> m_Scheduler = nullptr;
+            GBE::Timer m_Timer;
+        };
+
+        enum class TileKernel
+        {
+            DECODE,
+            DECODE_SCALAR,
+            DECODE_COLORS,
+            DECODE_COLORS_SCALAR,
+            MAP_COLORS,
+            MAP_COLORS_SCALAR
+        };
+
+        // TileDecoder kernels over the 384 tiles of vram
+        class TileDecoderFixture: public BenchmarkFixture
+        {
+        public:
+            TileDecoderFixture(TileKernel kernel): m_Kernel(kernel)
+            {
+                uint32_t seed = 0x2468ACE1;
+                for (uint8_t& byte: m_Data)
+                {
+                    seed = seed * 1664525 + 1013904223;
+                    byte = seed >> 24;
+                }
+
+                GBE::TileDecoder::DecodeRowsScalar(m_Data.data(), ROWS, false, m_Indices.data());
+            }
+
+            void Run(BenchmarkCounters& counters) override
+            {
+                for (uint32_t pass = 0; pass < TILE_DECODE_PASSES; pass++)
+                {
+                    uint8_t palette = static_cast<uint8_t>(0xE4 + pass);
+                    switch (m_Kernel)
+                    {
+                    case TileKernel::DECODE:
+                        GBE::TileDecoder::DecodeRows(m_Data.data(), ROWS, pass & 1, m_Pixels.data());
+                        break;
+                    case TileKernel::DECODE_SCALAR:
+                        GBE::TileDecoder::DecodeRowsScalar(m_Data.data(), ROWS, pass & 1, m_Pixels.data());
+                        break;
+                    case TileKernel::DECODE_COLORS:
+                        GBE::TileDecoder::DecodeRowsColors(m_Data.data(), ROWS, palette, m_Pixels.data());
+                        break;
+                    case TileKernel::DECODE_COLORS_SCALAR:
+                        GBE::TileDecoder::DecodeRowsColorsScalar(m_Data.data(), ROWS, palette, m_Pixels.data());
+                        break;
+                    case TileKernel::MAP_COLORS:
+                        GBE::TileDecoder::MapColors(m_Indices.data(), m_Indices.size(), palette, m_Pixels.data());
+                        break;
+                    case TileKernel::MAP_COLORS_SCALAR:
+                        GBE::TileDecoder::MapColorsScalar(m_Indices.data(), m_Indices.size(), palette, m_Pixels.data());
+                        break;
+                    }
+                }
+
+                m_Sink = m_Pixels[m_Pixels.size() / 2];
+                counters.Operations = static_cast<uint64_t>(TILE_DECODE_PASSES) * ROWS;
+            }
+
+        private:
+            static constexpr size_t ROWS = GBE::TILE_COUNT * GBE::TILE_SIZE;
+
+            TileKernel m_Kernel;
+            std::array<uint8_t, ROWS * 2> m_Data{};
+            std::array<uint8_t, ROWS * GBE::TILE_SIZE> m_Indices{};
+            std::array<uint8_t, ROWS * GBE::TILE_SIZE> m_Pixels{};
+            volatile uint8_t m_Sink = 0;
+        };
+
+        template<typename Fixture, typename... Args>
+        void Register(std::string name, std::string unit, Args... args)
+        {
+            RegisterBenchmark(BenchmarkEntry{
+                .Name = std::move(name),
+                .Unit = std::move(unit),
+                .CreateFixture = [=]() -> std::unique_ptr<BenchmarkFixture>
+                {
+                    return std::make_unique<Fixture>(args...);
+                }
+            });
+        }
+    } // namespace
+
+    void RegisterDefaultBenchmarks(const BenchmarkOptions& options)
+    {
+        const std::filesystem::path romsDirectory = options.RomsDirectory;
+
+        // bundled test roms
+        for (std::string_view romName: {"01-special.gb", "06-ld r,r.gb", "09-op r,r.gb", "dmg-acid2.gb"})
+        {
+            RomData rom{};
+            if (!ReadRom(romsDirectory / romName, rom))
+            {
+                std::println(stderr, "warning: skipping {}, rom not found in {}", romName, options.RomsDirectory);
+                continue;
+            }
+
+            Register<GameboyTickFixture>(std::format("gameboy_tick/{}", romName), "frame", rom);
+            Register<RewindFixture>(std::format("gameboy_tick_rewind/{}", romName), "frame", rom, RewindMode::PUSH);
+            Register<CpuRunFixture>(std::format("cpu_run/{}", romName), "instruction", rom);
+            Register<CpuRunFixture>(std::format("cpu_run_block/{}", romName), "instruction", rom, GBE::CpuEngine::BLOCK_CACHE);
+            Register<CpuRunFixture>(std::format("cpu_run_jit/{}", romName), "instruction", rom, GBE::CpuEngine::JIT);
+
+            if (romName == "dmg-acid2.gb")
+            {
+                Register<PpuTickFixture>(std::format("ppu_tick/{}", romName), "dot", rom);
+                Register<StateFixture>(std::format("save_load_state/{}", romName), "round trip", rom);
+                Register<ResetFixture>(std::format("gameboy_reset/{}", romName), "reset", rom, ResetMode::RESET);
+                Register<ResetFixture>(std::format("gameboy_restart/{}", romName), "restart", rom, ResetMode::RESTART);
+                Register<RewindFixture>(std::format("rewind_step_back/{}", romName), "frame", rom, RewindMode::STEP_BACK);
+                Register<RunAheadFixture>(std::format("gameboy_tick_run_ahead_1/{}", romName), "frame", rom, 1u);
+                Register<RunAheadFixture>(std::format("gameboy_tick_run_ahead_3/{}", romName), "frame", rom, 3u);
+            }
+        }
+
+        // synthetic loops
+        Register<GameboyTickFixture>("gameboy_tick/synthetic_alu", "frame", MakeSyntheticRom(SYNTHETIC_ALU_LOOP));
+        Register<CpuRunFixture>("cpu_run/synthetic_alu", "instruction", MakeSyntheticRom(SYNTHETIC_ALU_LOOP));
+        Register<CpuRunFixture>("cpu_run/synthetic_memory", "instruction", MakeSyntheticRom(SYNTHETIC_MEMORY_LOOP));
+        Register<CpuRunFixture>("cpu_run/synthetic_stack", "instruction", MakeSyntheticRom(SYNTHETIC_STACK_LOOP));
+        Register<CpuRunFixture>("cpu_run_block/synthetic_alu", "instruction", MakeSyntheticRom(SYNTHETIC_ALU_LOOP), GBE::CpuEngine::BLOCK_CACHE);
+        Register<CpuRunFixture>("cpu_run_block/synthetic_memory", "instruction", MakeSyntheticRom(SYNTHETIC_MEMORY_LOOP), GBE::CpuEngine::BLOCK_CACHE);
+        Register<CpuRunFixture>("cpu_run_jit/synthetic_alu", "instruction", MakeSyntheticRom(SYNTHETIC_ALU_LOOP), GBE::CpuEngine::JIT);
+        Register<CpuRunFixture>("cpu_run_jit/synthetic_memory", "instruction", MakeSyntheticRom(SYNTHETIC_MEMORY_LOOP), GBE::CpuEngine::JIT);
+        Register<PpuTickFixture>("ppu_tick/synthetic_alu", "dot", MakeSyntheticRom(SYNTHETIC_ALU_LOOP));
+
+        // memory bus
+        Register<MemoryFixture>("memory_get/wram", "access", MemoryAccess::GET, MakeAddresses({{0xC000, 0xDFFF}}));
+        Register<MemoryFixture>("memory_get/mixed", "access", MemoryAccess::GET, MakeAddresses({
+            {0x0000, 0x7FFF}, {0x8000, 0x9FFF}, {0xC000, 0xDFFF}, {0xFF80, 0xFFFE}, {0xFF00, 0xFF4B}
+        }));
+        Register<MemoryFixture>("memory_get16/mixed", "access", MemoryAccess::GET_16, MakeAddresses({
+            {0x0000, 0x7FFE}, {0xC000, 0xDFFE}, {0xFF80, 0xFFFD}
+        }));
+        Register<MemoryFixture>("memory_set/wram", "access", MemoryAccess::SET, MakeAddresses({{0xC000, 0xDFFF}}));
+        Register<MemoryFixture>("memory_set/hram", "access", MemoryAccess::SET, MakeAddresses({{0xFF80, 0xFFFE}}));
+
+        // timer
+        Register<TimerTickFixture>("timer_tick", "m-cycle");
+
+        // tile decoding, simd kernels against the scalar reference
+        Register<TileDecoderFixture>(std::format("tile_decode/{}", GBE::TileDecoder::GetKernelName()), "row", TileKernel::DECODE);
+        Register<TileDecoderFixture>("tile_decode/scalar", "row", TileKernel::DECODE_SCALAR);
+        Register<TileDecoderFixture>(std::format("tile_decode_colors/{}", GBE::TileDecoder::GetKernelName()), "row", TileKernel::DECODE_COLORS);
+        Register<TileDecoderFixture>("tile_decode_colors/scalar", "row", TileKernel::DECODE_COLORS_SCALAR);
+        Register<TileDecoderFixture>(std::format("palette_map/{}", GBE::TileDecoder::GetKernelName()), "row", TileKernel::MAP_COLORS);
+        Register<TileDecoderFixture>("palette_map/scalar", "row", TileKernel::MAP_COLORS_SCALAR);
+    }
+} // namespace GBEBench
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Benchmark.h"
+
+namespace GBEBench
+{
+    // register the gameboy, cpu, ppu, memory and timer benchmarks
+    // rom benchmarks are skipped when the rom is not found in the roms directory
+    void RegisterDefaultBenchmarks(const BenchmarkOptions& options);
+} // namespace GBEBench
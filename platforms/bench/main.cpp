@@ -0,0 +1,116 @@
+#include "Benchmark.h"
+#include "Benchmarks.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <print>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::println(stderr, "usage: gbe_bench [options]");
+        std::println(stderr, "  --warmup N     warmup repetitions per benchmark (default 2)");
+        std::println(stderr, "  --reps N       timed repetitions per benchmark (default 10)");
+        std::println(stderr, "  --filter TEXT  only run benchmarks whose name contains TEXT");
+        std::println(stderr, "  --roms DIR     test roms directory (default ./test_roms)");
+        std::println(stderr, "  --out FILE     write the json report to FILE instead of stdout");
+        std::println(stderr, "  --list         list the benchmarks and exit");
+    }
+} // namespace
+
+// run the benchmark suite and output a json report
+int main(int argc, char **argv)
+{
+    GBEBench::BenchmarkOptions options{};
+    std::string outputPath = "";
+    bool listOnly = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view arg = argv[i];
+
+        if (arg == "--list")
+        {
+            listOnly = true;
+            continue;
+        }
+
+        if (i + 1 >= argc)
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        std::string_view value = argv[++i];
+        if (arg == "--warmup")
+            options.Warmup = std::strtoul(value.data(), nullptr, 10);
+        else if (arg == "--reps")
+            options.Repetitions = std::strtoul(value.data(), nullptr, 10);
+        else if (arg == "--filter")
+            options.Filter = value;
+        else if (arg == "--roms")
+            options.RomsDirectory = value;
+        else if (arg == "--out")
+            outputPath = value;
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.Repetitions == 0)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    GBEBench::RegisterDefaultBenchmarks(options);
+
+    std::vector<GBEBench::BenchmarkReport> reports{};
+    for (const GBEBench::BenchmarkEntry& entry: GBEBench::GetBenchmarks())
+    {
+        if (!options.Filter.empty() && entry.Name.find(options.Filter) == std::string::npos)
+            continue;
+
+        if (listOnly)
+        {
+            std::println("{}", entry.Name);
+            continue;
+        }
+
+        GBEBench::BenchmarkReport report = GBEBench::RunBenchmark(entry, options);
+        std::println(stderr, "{:<32} {:>12.2f} ns/{} (p50 {:.2f}, p90 {:.2f}) {} allocs",
+            report.Name,
+            report.NanosecondsPerOperation.Mean,
+            report.Unit,
+            report.NanosecondsPerOperation.P50,
+            report.NanosecondsPerOperation.P90,
+            report.Allocations
+        );
+        reports.push_back(std::move(report));
+    }
+
+    if (listOnly)
+        return 0;
+
+    std::string json = GBEBench::ToJson(reports, options);
+    if (outputPath.empty())
+    {
+        std::print("{}", json);
+        return 0;
+    }
+
+    std::ofstream file(outputPath);
+    if (!file.is_open())
+    {
+        std::println(stderr, "cannot open output file: {}", outputPath);
+        return 1;
+    }
+    file << json;
+    return 0;
+}
@@ -0,0 +1,276 @@
+#include "gameboy/Gameboy.h"
+#include "cartridge/Cartridge.h"
+#include "batch/BatchRunner.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <print>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <magic_enum.hpp>
+
+namespace
+{
+    constexpr double GB_FRAMES_PER_SECOND = 59.7275;
+    constexpr uint64_t DEFAULT_FRAMES = 3600;
+
+    struct HeadlessOptions
+    {
+        std::string RomPath = "";
+        std::string BatchPath = "";
+        uint64_t Frames = 0;
+        uint64_t Cycles = 0;
+        size_t Threads = 0;
+        GBE::CpuEngine Engine = GBE::CpuEngine::INTERPRETER;
+        GBE::PpuRenderer Renderer = GBE::PpuRenderer::FIFO;
+        uint32_t FrameSkip = 0;
+    };
+
+    void PrintUsage()
+    {
+        std::println(stderr, "usage: gbe_headless <rom> [--frames N | --cycles N]");
+        std::println(stderr, "       gbe_headless --batch <jobs> [--threads N] [--frames N | --cycles N]");
+        std::println(stderr, "  --frames N    run N frames (default {})", DEFAULT_FRAMES);
+        std::println(stderr, "  --cycles N    run until at least N m-cycles are executed");
+        std::println(stderr, "  --batch FILE  run every job of FILE, one job per line: <rom>[<tab><input script>]");
+        std::println(stderr, "  --threads N   number of batch workers (default: hardware concurrency)");
+        std::println(stderr, "  --engine NAME cpu engine: interpreter, block_cache or jit (default interpreter)");
+        std::println(stderr, "  --renderer NAME ppu renderer: fifo or scanline (default fifo)");
+        std::println(stderr, "  --frame-skip N frames not drawn after each drawn frame (default 0)");
+    }
+
+    bool ParseOptions(int argc, char **argv, HeadlessOptions &options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string_view arg = argv[i];
+
+            if (arg.starts_with("--") && i + 1 < argc)
+            {
+                std::string_view value = argv[++i];
+                if (arg == "--frames")
+                    options.Frames = std::strtoull(value.data(), nullptr, 10);
+                else if (arg == "--cycles")
+                    options.Cycles = std::strtoull(value.data(), nullptr, 10);
+                else if (arg == "--threads")
+                    options.Threads = std::strtoull(value.data(), nullptr, 10);
+                else if (arg == "--frame-skip")
+                    options.FrameSkip = std::strtoul(value.data(), nullptr, 10);
+                else if (arg == "--batch")
+                    options.BatchPath = value;
+                else if (arg == "--engine")
+                {
+                    auto engine = magic_enum::enum_cast<GBE::CpuEngine>(value, magic_enum::case_insensitive);
+                    if (!engine.has_value())
+                        return false;
+                    options.Engine = engine.value();
+                }
+                else if (arg == "--renderer")
+                {
+                    auto renderer = magic_enum::enum_cast<GBE::PpuRenderer>(value, magic_enum::case_insensitive);
+                    if (!renderer.has_value())
+                        return false;
+                    options.Renderer = renderer.value();
+                }
+                else
+                    return false;
+                continue;
+            }
+
+            if (arg.starts_with("--") || !options.RomPath.empty())
+                return false;
+
+            options.RomPath = arg;
+        }
+
+        // either a single rom or a batch
+        if (options.RomPath.empty() == options.BatchPath.empty())
+            return false;
+
+        if (options.Frames == 0 && options.Cycles == 0)
+            options.Frames = DEFAULT_FRAMES;
+
+        return true;
+    }
+
+    // share of the m-cycles skipped by the idle loop detector
+    double IdlePercent(uint64_t idleLoopCycles, uint64_t cycles)
+    {
+        return cycles > 0 ? 100.0 * static_cast<double>(idleLoopCycles) / static_cast<double>(cycles) : 0.0;
+    }
+
+    bool LoadBatchJobs(const HeadlessOptions &options, std::vector<GBE::BatchJob> &jobs)
+    {
+        std::ifstream file(options.BatchPath);
+        if (!file.is_open())
+            return false;
+
+        std::string line{};
+        while (std::getline(file, line))
+        {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+
+            if (line.empty() || line.starts_with('#'))
+                continue;
+
+            GBE::BatchJob job{};
+            size_t separator = line.find('\t');
+            job.RomPath = line.substr(0, separator);
+            if (separator != std::string::npos)
+                job.InputScriptPath = line.substr(separator + 1);
+
+            job.MaxFrames = options.Frames;
+            job.MaxCycles = options.Cycles;
+            job.Engine = options.Engine;
+            job.Renderer = options.Renderer;
+            job.FrameSkip = options.FrameSkip;
+            jobs.push_back(std::move(job));
+        }
+
+        return true;
+    }
+
+    int RunBatch(const HeadlessOptions &options)
+    {
+        std::vector<GBE::BatchJob> jobs{};
+        if (!LoadBatchJobs(options, jobs))
+        {
+            std::println(stderr, "batch file not found: {}", options.BatchPath);
+            return 1;
+        }
+
+        GBE::BatchRunner runner{options.Threads};
+
+        const auto startTime = std::chrono::steady_clock::now();
+        std::vector<GBE::BatchResult> results = runner.Run(jobs);
+        const auto endTime = std::chrono::steady_clock::now();
+
+        uint64_t frames = 0;
+        uint64_t cycles = 0;
+        uint64_t instructions = 0;
+        uint64_t idleLoopCycles = 0;
+        int failedJobs = 0;
+
+        // one tab separated line per job
+        std::println("job\texit\tframes\tm-cycles\tinstructions\tframe-hash\tidle-m-cycles\trom\tinput");
+        for (size_t i = 0; i < jobs.size(); i++)
+        {
+            const GBE::BatchResult &result = results[i];
+            std::println("{}\t{}\t{}\t{}\t{}\t{:016x}\t{}\t{}\t{}",
+                i,
+                magic_enum::enum_name(result.ExitReason),
+                result.Frames,
+                result.Cycles,
+                result.Instructions,
+                result.FrameHash,
+                result.IdleLoopCycles,
+                jobs[i].RomPath,
+                jobs[i].InputScriptPath
+            );
+
+            frames += result.Frames;
+            instructions += result.Instructions;
+            idleLoopCycles += result.IdleLoopCycles;
+            cycles += result.Cycles;
+
+            if (result.ExitReason != GBE::BatchExitReason::FRAME_LIMIT && result.ExitReason != GBE::BatchExitReason::CYCLE_LIMIT)
+                failedJobs++;
+        }
+
+        double seconds = std::chrono::duration<double>(endTime - startTime).count();
+        if (seconds <= 0.0)
+            seconds = 1e-9;
+
+        const GBE::ThreadPool &threadPool = runner.GetThreadPool();
+        std::println(stderr, "jobs:           {} ({} failed)", jobs.size(), failedJobs);
+        std::println(stderr, "workers:        {} ({} jobs stolen)", threadPool.GetWorkersCount(), threadPool.GetStolenJobsCount());
+        std::println(stderr, "time:           {:.3f} s", seconds);
+        std::println(stderr, "frames/s:       {:.1f}", static_cast<double>(frames) / seconds);
+        std::println(stderr, "instructions/s: {:.0f}", static_cast<double>(instructions) / seconds);
+        std::println(stderr, "idle m-cycles:  {} ({:.1f}%)", idleLoopCycles, IdlePercent(idleLoopCycles, cycles));
+
+        return failedJobs == 0 ? 0 : 2;
+    }
+
+    int RunSingle(const HeadlessOptions &options)
+    {
+        if (!std::filesystem::is_regular_file(options.RomPath))
+        {
+            std::println(stderr, "ROM not found: {}", options.RomPath);
+            return 1;
+        }
+
+        auto cartridge = std::make_shared<GBE::Cartridge>();
+        cartridge->Load(options.RomPath);
+
+        GBE::Gameboy gameboy{options.Renderer};
+        gameboy.GetCpu().SetEngine(options.Engine);
+        gameboy.GetPpu().SetFrameSkip(options.FrameSkip);
+        gameboy.Start(cartridge);
+
+        uint64_t frames = 0;
+        uint64_t cycles = 0;
+
+        const auto startTime = std::chrono::steady_clock::now();
+        while (gameboy.IsRunning())
+        {
+            if (options.Frames > 0 && frames >= options.Frames)
+                break;
+
+            if (options.Cycles > 0 && cycles >= options.Cycles)
+                break;
+
+            cycles += gameboy.Tick();
+            frames++;
+        }
+        const auto endTime = std::chrono::steady_clock::now();
+
+        uint64_t instructions = gameboy.GetCpu().GetInstructionsCounter();
+        uint64_t idleLoopCycles = gameboy.GetCpu().GetIdleLoopSkippedCycles();
+        double seconds = std::chrono::duration<double>(endTime - startTime).count();
+        if (seconds <= 0.0)
+            seconds = 1e-9;
+
+        double framesPerSecond = static_cast<double>(frames) / seconds;
+        double instructionsPerSecond = static_cast<double>(instructions) / seconds;
+
+        std::println("rom:            {}", options.RomPath);
+        std::println("engine:         {}", magic_enum::enum_name(options.Engine));
+        std::println("renderer:       {}", magic_enum::enum_name(options.Renderer));
+        std::println("frame skip:     {}", options.FrameSkip);
+        std::println("frames:         {}", frames);
+        std::println("m-cycles:       {}", cycles);
+        std::println("instructions:   {}", instructions);
+        std::println("idle m-cycles:  {} ({:.1f}%)", idleLoopCycles, IdlePercent(idleLoopCycles, cycles));
+        std::println("frame hash:     {:016x}", gameboy.GetPpu().GetLcdScreen().GetHash());
+        std::println("time:           {:.3f} s", seconds);
+        std::println("frames/s:       {:.1f} ({:.1f}x realtime)", framesPerSecond, framesPerSecond / GB_FRAMES_PER_SECOND);
+        std::println("instructions/s: {:.0f}", instructionsPerSecond);
+
+        gameboy.Stop();
+        return 0;
+    }
+} // namespace
+
+// run roms as fast as the host allows and report the throughput
+int main(int argc, char **argv)
+{
+    HeadlessOptions options{};
+    if (!ParseOptions(argc, argv, options))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    if (!options.BatchPath.empty())
+        return RunBatch(options);
+
+    return RunSingle(options);
+}
@@ -0,0 +1,99 @@
+#include "GBETestSuite.h"
+
+#include "batch/BatchRunner.h"
+#include "batch/InputScript.h"
+#include "batch/ThreadPool.h"
+
+#include <atomic>
+#include <vector>
+
+GBE_TEST_SUITE(BatchRunnerTest)
+{
+    TEST_CASE("ThreadPool runs every job exactly once")
+    {
+        // arrange
+        constexpr size_t jobsCount = 1000;
+        std::vector<std::atomic<int>> executions(jobsCount);
+        GBE::ThreadPool threadPool{4};
+
+        // act
+        threadPool.Run(jobsCount, [&](size_t jobIndex, size_t)
+        {
+            executions[jobIndex]++;
+        });
+
+        // assert
+        for (size_t i = 0; i < jobsCount; i++)
+            CHECK_EQ(executions[i].load(), 1);
+    }
+
+    TEST_CASE("InputScript parse events sorted by frame")
+    {
+        // arrange
+        GBE::InputScript inputScript{};
+
+        // act
+        bool isValid = inputScript.Parse(
+            "# comment\n"
+            "120 start down\n"
+            "10 A down # inline comment\n"
+            "\n"
+            "121 START up\n"
+        );
+
+        // assert
+        REQUIRE(isValid);
+        REQUIRE_EQ(inputScript.GetEvents().size(), 3);
+        CHECK_EQ(inputScript.GetEvents()[0].Frame, 10);
+        CHECK_EQ(inputScript.GetEvents()[0].Event.Button, GBE::JoypadButton::A);
+        CHECK_EQ(inputScript.GetEvents()[1].Event.Button, GBE::JoypadButton::START);
+        CHECK(inputScript.GetEvents()[1].Event.Pressed);
+        CHECK_FALSE(inputScript.GetEvents()[2].Event.Pressed);
+    }
+
+    TEST_CASE("InputScript reject malformed lines")
+    {
+        GBE::InputScript inputScript{};
+
+        CHECK_FALSE(inputScript.Parse("abc A down"));
+        CHECK_FALSE(inputScript.Parse("10 TURBO down"));
+        CHECK_FALSE(inputScript.Parse("10 A pressed"));
+        CHECK_FALSE(inputScript.Parse("10 A down extra"));
+    }
+
+    TEST_CASE("BatchRunner results match a single threaded run")
+    {
+        // arrange
+        std::vector<GBE::BatchJob> jobs{};
+        for (int i = 0; i < 8; i++)
+        {
+            jobs.push_back(GBE::BatchJob{
+                .RomPath = i % 2 == 0 ? "./test_roms/01-special.gb" : "./test_roms/dmg-acid2.gb",
+                .MaxFrames = 30
+            });
+        }
+        jobs.push_back(GBE::BatchJob{
+            .RomPath = "./test_roms/missing.gb",
+            .MaxFrames = 30
+        });
+
+        GBE::BatchRunner singleRunner{1};
+        GBE::BatchRunner runner{4};
+
+        // act
+        std::vector<GBE::BatchResult> expectedResults = singleRunner.Run(jobs);
+        std::vector<GBE::BatchResult> results = runner.Run(jobs);
+
+        // assert
+        REQUIRE_EQ(results.size(), jobs.size());
+        for (size_t i = 0; i < jobs.size() - 1; i++)
+        {
+            CHECK_EQ(results[i].ExitReason, GBE::BatchExitReason::FRAME_LIMIT);
+            CHECK_EQ(results[i].Frames, 30);
+            CHECK_EQ(results[i].Cycles, expectedResults[i].Cycles);
+            CHECK_EQ(results[i].FrameHash, expectedResults[i].FrameHash);
+            CHECK_EQ(results[i].FrameHash, results[i % 2].FrameHash);
+        }
+        CHECK_EQ(results.back().ExitReason, GBE::BatchExitReason::ROM_NOT_FOUND);
+    }
+}
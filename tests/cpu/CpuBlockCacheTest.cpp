@@ -0,0 +1,135 @@
+#include "GBETestSuite.h"
+
+#include <memory>
+#include <vector>
+
+#include "memory/Memory.h"
+#include "memory/Ram.h"
+
+#include "cpu/block/CpuBlockCache.h"
+#include "cpu/instruction/Instruction.h"
+#include "cpu/instruction/InstructionResult.h"
+#include "cpu/Cpu.h"
+
+#include "io/interrupts/InterruptManager.h"
+
+GBE_TEST_SUITE(CpuBlockCache)
+{
+    // arrange
+    auto workRam    = std::make_shared<GBE::Ram>(GBE::MMAP_WRAM.GetSize());
+    auto memory     = std::make_shared<GBE::Memory>();
+
+    TEST_CASE("Init")
+    {
+        memory->MapMemoryArea({GBE::MMAP_WRAM}, workRam);
+        memory->Init();
+    }
+
+    TEST_CASE("Block ends on control flow")
+    {
+        // arrange
+        // INC A; LD B,$12; RLC B; JR -7; NOP
+        std::vector<uint8_t> program = {0x3C, 0x06, 0x12, 0xCB, 0x00, 0x18, 0xF9, 0x00};
+        memory->CopyBuffer(0xC000, program.data(), program.size());
+        GBE::CpuBlockCache blockCache{memory};
+
+        // act
+        const GBE::CpuBlock* block = blockCache.GetBlock(0xC000);
+
+        // assert
+        REQUIRE(block);
+        REQUIRE_EQ(block->Ops.size(), 4);
+        CHECK_EQ(block->Start, 0xC000);
+        CHECK_EQ(block->End, 0xC006);
+        CHECK_EQ(block->Ops[1].PC, 0xC001);
+        CHECK_EQ(block->Ops[2].OpcodeSize, 2);
+        CHECK_EQ(block->Ops[2].Instr->GetType(), GBE::InstructionType::RLC);
+        CHECK_EQ(block->Ops[3].Instr->GetType(), GBE::InstructionType::JR);
+
+        // outside of rom and ram
+        CHECK_FALSE(blockCache.GetBlock(0x8000));
+    }
+
+    TEST_CASE("Busy-wait loops polling io are idle loops")
+    {
+        // arrange
+        // LDH A,[$44]; CP $90; JR NZ,-6
+        std::vector<uint8_t> pollLY = {0xF0, 0x44, 0xFE, 0x90, 0x20, 0xFA};
+        // LD A,[$FF0F]; BIT 0,A; JR Z,-7
+        std::vector<uint8_t> pollIF = {0xFA, 0x0F, 0xFF, 0xCB, 0x47, 0x28, 0xF9};
+        // LDH A,[$44]; INC B; JR NZ,-5
+        std::vector<uint8_t> counting = {0xF0, 0x44, 0x04, 0x20, 0xFB};
+        // LDH A,[$80]; AND A; JR Z,-5
+        std::vector<uint8_t> pollRam = {0xF0, 0x80, 0xA7, 0x28, 0xFB};
+        memory->CopyBuffer(0xC200, pollLY.data(), pollLY.size());
+        memory->CopyBuffer(0xC210, pollIF.data(), pollIF.size());
+        memory->CopyBuffer(0xC220, counting.data(), counting.size());
+        memory->CopyBuffer(0xC230, pollRam.data(), pollRam.size());
+        GBE::CpuBlockCache blockCache{memory};
+
+        // act
+        const GBE::CpuBlock* pollLYBlock = blockCache.GetBlock(0xC200);
+        const GBE::CpuBlock* pollIFBlock = blockCache.GetBlock(0xC210);
+        const GBE::CpuBlock* countingBlock = blockCache.GetBlock(0xC220);
+        const GBE::CpuBlock* pollRamBlock = blockCache.GetBlock(0xC230);
+
+        // assert
+        REQUIRE(pollLYBlock);
+        REQUIRE(pollIFBlock);
+        REQUIRE(countingBlock);
+        REQUIRE(pollRamBlock);
+        CHECK(pollLYBlock->IsIdleLoop);
+        CHECK(pollIFBlock->IsIdleLoop);
+        CHECK_FALSE(countingBlock->IsIdleLoop);
+        CHECK_FALSE(pollRamBlock->IsIdleLoop);
+    }
+
+    TEST_CASE("Write to block code invalidates it")
+    {
+        // arrange
+        // NOP; NOP; HALT
+        std::vector<uint8_t> program = {0x00, 0x00, 0x76};
+        memory->CopyBuffer(0xC100, program.data(), program.size());
+        GBE::CpuBlockCache blockCache{memory};
+        const GBE::CpuBlock* block = blockCache.GetBlock(0xC100);
+        REQUIRE(block);
+        REQUIRE_EQ(block->Ops.size(), 3);
+
+        // act
+        memory->Set(0xC103, 0x00);
+        bool isValidAfterOutsideWrite = block->IsValid;
+        memory->Set(0xC101, 0x3C);
+
+        // assert
+        CHECK(isValidAfterOutsideWrite);
+        CHECK_FALSE(block->IsValid);
+        CHECK_EQ(blockCache.GetBlocksCount(), 0);
+
+        const GBE::CpuBlock* newBlock = blockCache.GetBlock(0xC100);
+        REQUIRE(newBlock);
+        CHECK_EQ(newBlock->Ops[1].Instr->GetType(), GBE::InstructionType::INC);
+    }
+
+    TEST_CASE("Self modifying code runs the written instruction")
+    {
+        // arrange
+        // LD A,$3C; LD [$C208],A; NOP; NOP; NOP; NOP (overwritten by INC A); JR -2
+        std::vector<uint8_t> program = {0x3E, 0x3C, 0xEA, 0x08, 0xC2, 0x00, 0x00, 0x00, 0x00, 0x18, 0xFE};
+        memory->CopyBuffer(0xC200, program.data(), program.size());
+
+        GBE::Cpu cpu{memory, std::make_shared<GBE::InterruptManager>()};
+        cpu.SetEngine(GBE::CpuEngine::BLOCK_CACHE);
+        cpu.Init();
+        cpu.GetRegisters().SetReg16(GBE::Reg16::PC, 0xC200);
+
+        // act
+        while (cpu.GetRegisters().GetReg16(GBE::Reg16::PC) != 0xC209)
+        {
+            GBE::InstructionResult result{};
+            cpu.Run(result);
+        }
+
+        // assert
+        CHECK_EQ(cpu.GetRegisters().GetReg8(GBE::Reg8::A), 0x3D);
+    }
+}
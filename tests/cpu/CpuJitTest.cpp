@@ -0,0 +1,65 @@
+#include "GBETestSuite.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gameboy/Gameboy.h"
+#include "cartridge/Cartridge.h"
+#include "cpu/Cpu.h"
+#include "cpu/jit/CpuJit.h"
+#include "io/graphics/lcd/LcdScreen.h"
+
+namespace GBETest
+{
+    // runs rom on the interpreter and the jit and compares them after every frame
+    static void CheckJitMatchesInterpreter(const std::string& romPath, uint32_t frames)
+    {
+        auto cartridge = std::make_shared<GBE::Cartridge>();
+        cartridge->Load(romPath);
+
+        GBE::Gameboy interpreter{};
+        interpreter.Start(cartridge);
+
+        GBE::Gameboy jit{};
+        jit.GetCpu().SetEngine(GBE::CpuEngine::JIT);
+        jit.Start(cartridge);
+
+        for (uint32_t frame = 0; frame < frames; frame++)
+        {
+            CAPTURE(frame);
+
+            REQUIRE_EQ(interpreter.Tick(), jit.Tick());
+
+            GBE::CpuRegistersSet& expected = interpreter.GetCpu().GetRegisters();
+            GBE::CpuRegistersSet& actual = jit.GetCpu().GetRegisters();
+            for (GBE::Reg16 reg: {GBE::Reg16::AF, GBE::Reg16::BC, GBE::Reg16::DE, GBE::Reg16::HL, GBE::Reg16::SP, GBE::Reg16::PC})
+            {
+                CAPTURE(reg);
+                REQUIRE_EQ(expected.GetReg16(reg), actual.GetReg16(reg));
+            }
+
+            REQUIRE_EQ(interpreter.GetCpu().GetInstructionsCounter(), jit.GetCpu().GetInstructionsCounter());
+            REQUIRE_EQ(interpreter.GetPpu().GetLcdScreen().GetHash(), jit.GetPpu().GetLcdScreen().GetHash());
+        }
+
+        CHECK_GT(jit.GetCpu().GetJit().GetCodeSize(), 0);
+    }
+} // namespace GBETest
+
+GBE_TEST_SUITE(CpuJit)
+{
+    TEST_CASE("Same state as the interpreter on every frame")
+    {
+        if (!GBE::CpuJit::IsSupported())
+            return;
+
+        for (std::string romName: {"01-special.gb", "02-interrupts.gb", "03-op sp,hl.gb", "04-op r,imm.gb",
+            "05-op rp.gb", "06-ld r,r.gb", "07-jr,jp,call,ret,rst.gb", "08-misc instrs.gb", "09-op r,r.gb",
+            "10-bit ops.gb", "11-op a,(hl).gb", "dmg-acid2.gb"})
+        {
+            CAPTURE(romName);
+            GBETest::CheckJitMatchesInterpreter("./test_roms/" + romName, 300);
+        }
+    }
+}
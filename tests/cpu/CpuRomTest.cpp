@@ -12,9 +12,17 @@ TEST_CASE(testName) \
     CHECK_EQ(result, 0); \
 }
 
+#define GBE_ADD_TEST_ROM_ENGINE(testName, successAddress, engine) \
+TEST_CASE(testName " (" #engine ")") \
+{ \
+    std::string romPath = "./test_roms/" testName; \
+    int result = GBETest::RunRomTest(romPath, successAddress, 10000, GBE::CpuEngine::engine); \
+    CHECK_EQ(result, 0); \
+}
+
 namespace GBETest
 {
-    static int RunRomTest(const std::string& romPath, uint16_t successAddress, uint16_t timeoutCycles)
+    static int RunRomTest(const std::string& romPath, uint16_t successAddress, uint16_t timeoutCycles, GBE::CpuEngine engine = GBE::CpuEngine::INTERPRETER)
     {
         // load cartridge
         GBE_ASSERT(!romPath.empty());
@@ -24,6 +32,7 @@ namespace GBETest
 
         // run the gameboy with the cartridge
         GBE::Gameboy gameboy{};
+        gameboy.GetCpu().SetEngine(engine);
         gameboy.Start(cartridge);
 
         // 
@@ -61,4 +70,19 @@ GBE_TEST_SUITE(CpuRom)
     GBE_ADD_TEST_ROM("09-op r,r.gb", 0xCE67);
     GBE_ADD_TEST_ROM("10-bit ops.gb", 0xCF58);
     GBE_ADD_TEST_ROM("11-op a,(hl).gb", 0xCC62);
-}
\ No newline at end of file
+}
+
+GBE_TEST_SUITE(CpuRomBlockCache)
+{
+    GBE_ADD_TEST_ROM_ENGINE("01-special.gb", 0xC7D2, BLOCK_CACHE);
+    GBE_ADD_TEST_ROM_ENGINE("02-interrupts.gb", 0xC7F4, BLOCK_CACHE);
+    GBE_ADD_TEST_ROM_ENGINE("03-op sp,hl.gb", 0xCB44, BLOCK_CACHE);
+    GBE_ADD_TEST_ROM_ENGINE("04-op r,imm.gb", 0xCB35, BLOCK_CACHE);
+    GBE_ADD_TEST_ROM_ENGINE("05-op rp.gb", 0xCB31, BLOCK_CACHE);
+    GBE_ADD_TEST_ROM_ENGINE("06-ld r,r.gb", 0xCC5F, BLOCK_CACHE);
+    GBE_ADD_TEST_ROM_ENGINE("07-jr,jp,call,ret,rst.gb", 0xCBB0, BLOCK_CACHE);
+    GBE_ADD_TEST_ROM_ENGINE("08-misc instrs.gb", 0xCB91, BLOCK_CACHE);
+    GBE_ADD_TEST_ROM_ENGINE("09-op r,r.gb", 0xCE67, BLOCK_CACHE);
+    GBE_ADD_TEST_ROM_ENGINE("10-bit ops.gb", 0xCF58, BLOCK_CACHE);
+    GBE_ADD_TEST_ROM_ENGINE("11-op a,(hl).gb", 0xCC62, BLOCK_CACHE);
+}
@@ -1,5 +1,6 @@
 #include "GBETestSuite.h"
 
+#include <array>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -14,6 +15,7 @@
 #include "cpu/alu/Alu.h"
 
 #include "io/IORegister.h"
+#include "io/interrupts/InterruptManager.h"
 
 namespace GBETest
 {
@@ -52,12 +54,15 @@ GBE_TEST_SUITE(Cpu)
     // arrange
     auto memoryCpu  = std::make_shared <GBETest::MemoryCpu>();
     auto memory     = std::make_shared<GBE::Memory>();
-    auto decoder    = std::make_shared<GBE::InstructionDecoder>();
-    auto cpu        = std::make_shared<GBE::Cpu>(memory, decoder);
+    auto interruptManager = std::make_shared<GBE::InterruptManager>();
+    auto cpu        = std::make_shared<GBE::Cpu>(memory, interruptManager);
 
     TEST_CASE("Init")
     {
-        memory->MapMemoryArea({GBE::MemoryMap{0, 0xFFFF}}, memoryCpu);
+        // IF and IE go to the interrupt manager
+        memory->MapMemoryArea({GBE::MemoryMap{0, 0xFF0E}, GBE::MemoryMap{0xFF10, 0xFFFE}}, memoryCpu);
+        memory->MapMemoryArea({GBE::MMAP_IF, GBE::MMAP_IE}, interruptManager);
+        interruptManager->Init();
     }
     
     TEST_CASE("SetImm8")
@@ -1076,4 +1081,68 @@ GBE_TEST_SUITE(Cpu)
             cpu->GetIME()
         );
     }
+
+    TEST_CASE("Specialised handlers match runtime handlers")
+    {
+        // alu operations of block 2 ordered by opcode (bits 5-3)
+        std::array<GBE::Alu::OperationDestSrc8, 8> aluOps = {
+            &GBE::Alu::Add8, &GBE::Alu::Add8, &GBE::Alu::Sub8, &GBE::Alu::Sub8,
+            &GBE::Alu::And8, &GBE::Alu::Xor8, &GBE::Alu::Or8, &GBE::Alu::Cmp8
+        };
+
+        auto resetState = [&]()
+        {
+            auto &regs = cpu->GetRegisters();
+            regs.SetReg8(GBE::Reg8::A, 0x3C);
+            regs.SetReg8(GBE::Reg8::B, 0x01);
+            regs.SetReg8(GBE::Reg8::C, 0x80);
+            regs.SetReg8(GBE::Reg8::D, 0xFF);
+            regs.SetReg8(GBE::Reg8::E, 0x0F);
+            regs.SetReg16(GBE::Reg16::HL, 0xC000);
+            regs.SetFlags(GBE::CpuFlag::C | GBE::CpuFlag::Z | GBE::CpuFlag::H | GBE::CpuFlag::N, GBE::CpuFlag::C | GBE::CpuFlag::H);
+            memory->Set(0xC000, 0x5A);
+        };
+
+        auto getState = [&]()
+        {
+            auto &regs = cpu->GetRegisters();
+            return std::array<uint8_t, 9>{
+                regs.GetReg8(GBE::Reg8::A), regs.GetReg8(GBE::Reg8::B), regs.GetReg8(GBE::Reg8::C),
+                regs.GetReg8(GBE::Reg8::D), regs.GetReg8(GBE::Reg8::E), regs.GetReg8(GBE::Reg8::H),
+                regs.GetReg8(GBE::Reg8::L), regs.GetFlags(), cpu->GetReg16Adr(GBE::Reg16::HL)
+            };
+        };
+
+        // ld r8, r8 and op a, r8
+        for (uint16_t opcode = 0x40; opcode < 0xC0; opcode++)
+        {
+            if (opcode == 0x76)
+                continue;
+
+            const GBE::Instruction &instr = GBE::InstructionDecoder::Decode(opcode);
+
+            // arrange
+            resetState();
+            GBE::InstructionResult expectedResult{};
+            if (opcode < 0x80)
+            {
+                cpu->LoadR8_R8(instr, expectedResult);
+            }
+            else
+            {
+                uint8_t aluOpcode = (opcode >> 3) & 0x7;
+                cpu->ExecAluOpA_R8(aluOps[aluOpcode], aluOpcode == 1 || aluOpcode == 3, instr, expectedResult);
+            }
+            auto expectedState = getState();
+
+            // act
+            resetState();
+            GBE::InstructionResult result{};
+            ((*cpu).*instr.GetMethod())(instr, result);
+
+            // assert
+            CHECK_EQ(getState(), expectedState);
+            CHECK_EQ(result.Cycles, expectedResult.Cycles);
+        }
+    }
 }
@@ -3,6 +3,7 @@
 #include "cpu/instruction/Instruction.h"
 #include "cpu/instruction/InstructionDecoder.h"
 #include "cpu/instruction/Operand.h"
+#include "cpu/Cpu.h"
 
 #include <print>
 #include <vector>
@@ -78,6 +79,21 @@ GBE_TEST_SUITE(InstructionDecoder)
         CHECK_EQ(&first, &second);
     }
 
+    TEST_CASE("Decode: shared instruction table")
+    {
+        const GBE::Instruction &instr = GBE::InstructionDecoder::Decode(0xCB);
+        const GBE::Instruction &prefixInstr = GBE::InstructionDecoder::DecodePrefix(0x37);
+
+        CHECK_EQ(&instr, &GBE::INSTRUCTION_TABLE[0xCB]);
+        CHECK_EQ(&prefixInstr, &GBE::INSTRUCTION_TABLE[GBE::INSTRUCTION_TABLE_PREFIX_OFFSET + 0x37]);
+        CHECK_EQ(instr.GetMethod(), &GBE::Cpu::Prefix);
+        CHECK_EQ(GBE::InstructionDecoder::Decode(0xD3).GetType(), GBE::InstructionType::INVALID);
+        CHECK_EQ(GBE::InstructionDecoder::Decode(0xD3).GetMethod(), &GBE::Cpu::InvalidInstruction);
+
+        // handlers are specialised for their operands
+        CHECK_NE(GBE::InstructionDecoder::Decode(0x41).GetMethod(), static_cast<GBE::Instruction::Method>(&GBE::Cpu::LoadR8_R8));
+    }
+
     TEST_CASE("All opcodes are decoded")
     {
         std::vector<uint8_t> invalidOpcodes = {0xD3, 0xDB, 0xDD, 0xE3, 0xE4, 0xEB, 0xEC, 0xED, 0xF4, 0xFC, 0xFD};
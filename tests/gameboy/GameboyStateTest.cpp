@@ -0,0 +1,317 @@
+#include "GBETestSuite.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gameboy/Gameboy.h"
+#include "cartridge/Cartridge.h"
+#include "cpu/Cpu.h"
+#include "cpu/jit/CpuJit.h"
+#include "io/graphics/lcd/LcdScreen.h"
+#include "io/joypad/Joypad.h"
+
+namespace GBETest
+{
+    // runs rom uninterrupted and, in parallel, moves the state between two gameboys after every frame
+    static void CheckStateRoundTrip(const std::string& romPath, uint32_t frames, GBE::CpuEngine engine)
+    {
+        auto cartridge = std::make_shared<GBE::Cartridge>();
+        cartridge->Load(romPath);
+
+        GBE::Gameboy expected{};
+        expected.GetCpu().SetEngine(engine);
+        expected.Start(cartridge);
+
+        auto actual = std::make_unique<GBE::Gameboy>();
+        auto other = std::make_unique<GBE::Gameboy>();
+        for (auto* gameboy: {actual.get(), other.get()})
+        {
+            gameboy->GetCpu().SetEngine(engine);
+            gameboy->Start(cartridge);
+        }
+
+        std::vector<uint8_t> state(actual->GetStateSize());
+        for (uint32_t frame = 0; frame < frames; frame++)
+        {
+            CAPTURE(frame);
+
+            REQUIRE_EQ(expected.Tick(), actual->Tick());
+
+            REQUIRE_EQ(actual->SaveState(state), state.size());
+            REQUIRE(other->LoadState(state));
+            std::swap(actual, other);
+
+            GBE::CpuRegistersSet& expectedRegs = expected.GetCpu().GetRegisters();
+            GBE::CpuRegistersSet& actualRegs = actual->GetCpu().GetRegisters();
+            for (GBE::Reg16 reg: {GBE::Reg16::AF, GBE::Reg16::BC, GBE::Reg16::DE, GBE::Reg16::HL, GBE::Reg16::SP, GBE::Reg16::PC})
+            {
+                CAPTURE(reg);
+                REQUIRE_EQ(expectedRegs.GetReg16(reg), actualRegs.GetReg16(reg));
+            }
+
+            REQUIRE_EQ(expected.GetCpu().GetInstructionsCounter(), actual->GetCpu().GetInstructionsCounter());
+            REQUIRE_EQ(expected.GetScheduler().GetCycles(), actual->GetScheduler().GetCycles());
+            REQUIRE_EQ(expected.GetPpu().GetLcdScreen().GetHash(), actual->GetPpu().GetLcdScreen().GetHash());
+        }
+
+        // the last state is saved again the same
+        std::vector<uint8_t> otherState(state.size());
+        REQUIRE_EQ(other->SaveState(otherState), otherState.size());
+        CHECK_EQ(state, otherState);
+    }
+} // namespace GBETest
+
+GBE_TEST_SUITE(GameboyState)
+{
+    TEST_CASE("Loading the state every frame gives the same run")
+    {
+        for (std::string romName: {"01-special.gb", "02-interrupts.gb", "03-op sp,hl.gb", "04-op r,imm.gb",
+            "05-op rp.gb", "06-ld r,r.gb", "07-jr,jp,call,ret,rst.gb", "08-misc instrs.gb", "09-op r,r.gb",
+            "10-bit ops.gb", "11-op a,(hl).gb", "dmg-acid2.gb"})
+        {
+            CAPTURE(romName);
+            GBETest::CheckStateRoundTrip("./test_roms/" + romName, 300, GBE::CpuEngine::INTERPRETER);
+        }
+    }
+
+    TEST_CASE("Loading the state every frame gives the same run with the jit")
+    {
+        if (!GBE::CpuJit::IsSupported())
+            return;
+
+        for (std::string romName: {"02-interrupts.gb", "dmg-acid2.gb"})
+        {
+            CAPTURE(romName);
+            GBETest::CheckStateRoundTrip("./test_roms/" + romName, 300, GBE::CpuEngine::JIT);
+        }
+    }
+
+    TEST_CASE("Clones run the same as the original")
+    {
+        auto cartridge = std::make_shared<GBE::Cartridge>();
+        cartridge->Load("./test_roms/dmg-acid2.gb");
+
+        GBE::Gameboy original{};
+        original.Start(cartridge);
+        for (uint32_t frame = 0; frame < 30; frame++)
+            original.Tick();
+
+        std::unique_ptr<GBE::Gameboy> clone = original.Clone();
+
+        // copy into a gameboy running another rom
+        auto otherCartridge = std::make_shared<GBE::Cartridge>();
+        otherCartridge->Load("./test_roms/01-special.gb");
+
+        GBE::Gameboy copy{};
+        copy.Start(otherCartridge);
+        copy.Tick();
+        copy.CopyFrom(original);
+
+        for (uint32_t frame = 0; frame < 120; frame++)
+        {
+            CAPTURE(frame);
+
+            uint16_t cycles = original.Tick();
+            REQUIRE_EQ(clone->Tick(), cycles);
+            REQUIRE_EQ(copy.Tick(), cycles);
+
+            uint64_t hash = original.GetPpu().GetLcdScreen().GetHash();
+            REQUIRE_EQ(clone->GetPpu().GetLcdScreen().GetHash(), hash);
+            REQUIRE_EQ(copy.GetPpu().GetLcdScreen().GetHash(), hash);
+
+            uint64_t instructions = original.GetCpu().GetInstructionsCounter();
+            REQUIRE_EQ(clone->GetCpu().GetInstructionsCounter(), instructions);
+            REQUIRE_EQ(copy.GetCpu().GetInstructionsCounter(), instructions);
+        }
+    }
+
+    TEST_CASE("Reset restores the reset snapshot")
+    {
+        auto cartridge = std::make_shared<GBE::Cartridge>();
+        cartridge->Load("./test_roms/02-interrupts.gb");
+
+        // fresh gameboy to compare with
+        GBE::Gameboy expected{};
+        expected.Start(cartridge);
+        std::vector<uint64_t> hashes{};
+        std::vector<uint64_t> instructions{};
+        for (uint32_t frame = 0; frame < 100; frame++)
+        {
+            expected.Tick();
+            hashes.push_back(expected.GetPpu().GetLcdScreen().GetHash());
+            instructions.push_back(expected.GetCpu().GetInstructionsCounter());
+        }
+
+        auto checkRun = [&](GBE::Gameboy& gameboy, uint32_t firstFrame)
+        {
+            for (uint32_t frame = firstFrame; frame < hashes.size(); frame++)
+            {
+                CAPTURE(frame);
+                gameboy.Tick();
+                REQUIRE_EQ(gameboy.GetPpu().GetLcdScreen().GetHash(), hashes[frame]);
+                REQUIRE_EQ(gameboy.GetCpu().GetInstructionsCounter(), instructions[frame]);
+            }
+        };
+
+        SUBCASE("Just booted")
+        {
+            GBE::Gameboy gameboy{};
+            gameboy.Start(cartridge);
+            checkRun(gameboy, 0);
+
+            gameboy.Reset();
+            CHECK_EQ(gameboy.GetCpu().GetInstructionsCounter(), 0);
+            checkRun(gameboy, 0);
+        }
+
+        SUBCASE("After warmup frames")
+        {
+            GBE::Gameboy gameboy{};
+            gameboy.SetResetWarmupFrames(10);
+            gameboy.Start(cartridge);
+            CHECK_EQ(gameboy.GetCpu().GetInstructionsCounter(), instructions[9]);
+            checkRun(gameboy, 10);
+
+            gameboy.Reset();
+            CHECK_EQ(gameboy.GetCpu().GetInstructionsCounter(), instructions[9]);
+            checkRun(gameboy, 10);
+        }
+
+        SUBCASE("Captured snapshot")
+        {
+            GBE::Gameboy gameboy{};
+            gameboy.Start(cartridge);
+            for (uint32_t frame = 0; frame < 50; frame++)
+                gameboy.Tick();
+
+            gameboy.CaptureResetSnapshot();
+            checkRun(gameboy, 50);
+
+            gameboy.Reset();
+            checkRun(gameboy, 50);
+        }
+
+        SUBCASE("Copied snapshot")
+        {
+            GBE::Gameboy gameboy{};
+            gameboy.SetResetWarmupFrames(10);
+            gameboy.Start(cartridge);
+            for (uint32_t frame = 10; frame < 50; frame++)
+                gameboy.Tick();
+
+            gameboy.CaptureResetSnapshot();
+            checkRun(gameboy, 50);
+
+            // the copy didn't boot on its own, it resets to the snapshot of the original
+            GBE::Gameboy copy{};
+            copy.CopyFrom(gameboy);
+            CHECK_EQ(copy.GetResetWarmupFrames(), 10);
+
+            std::unique_ptr<GBE::Gameboy> clone = gameboy.Clone();
+            for (GBE::Gameboy* other: {&copy, clone.get()})
+            {
+                other->Reset();
+                CHECK_EQ(other->GetCpu().GetInstructionsCounter(), instructions[49]);
+                checkRun(*other, 50);
+            }
+        }
+    }
+
+    TEST_CASE("Invalid states are rejected")
+    {
+        auto cartridge = std::make_shared<GBE::Cartridge>();
+        cartridge->Load("./test_roms/01-special.gb");
+
+        GBE::Gameboy gameboy{};
+        std::vector<uint8_t> state(1024 * 1024);
+
+        // not running
+        CHECK_EQ(gameboy.GetStateSize(), 0);
+        CHECK_EQ(gameboy.SaveState(state), 0);
+        CHECK_FALSE(gameboy.LoadState(state));
+
+        gameboy.Start(cartridge);
+        gameboy.Tick();
+
+        // buffer too small
+        size_t size = gameboy.GetStateSize();
+        CHECK_EQ(gameboy.SaveState(std::span(state).first(size - 1)), 0);
+
+        // larger buffers are fine
+        REQUIRE_EQ(gameboy.SaveState(state), size);
+        CHECK(gameboy.LoadState(state));
+
+        uint16_t pc = gameboy.GetCpu().GetRegisters().GetReg16(GBE::Reg16::PC);
+
+        // truncated
+        CHECK_FALSE(gameboy.LoadState(std::span(state).first(size - 1)));
+
+        // other version
+        std::vector<uint8_t> otherVersion(state.begin(), state.begin() + size);
+        otherVersion[4]++;
+        CHECK_FALSE(gameboy.LoadState(otherVersion));
+
+        // not a state
+        std::vector<uint8_t> garbage(size, 0xAB);
+        CHECK_FALSE(gameboy.LoadState(garbage));
+
+        // valid header but the components don't fit in the size
+        GBE::Gameboy later{};
+        later.Start(cartridge);
+        for (uint32_t frame = 0; frame < 10; frame++)
+            later.Tick();
+
+        std::vector<uint8_t> shorter(size);
+        REQUIRE_EQ(later.SaveState(shorter), size);
+        shorter.pop_back();
+        const uint32_t shorterSize = static_cast<uint32_t>(shorter.size());
+        std::memcpy(shorter.data() + 8, &shorterSize, sizeof(shorterSize));
+        CHECK_FALSE(gameboy.LoadState(shorter));
+
+        // nothing was loaded from the rejected states
+        CHECK_EQ(gameboy.GetCpu().GetRegisters().GetReg16(GBE::Reg16::PC), pc);
+
+        std::vector<uint8_t> unchanged(size);
+        REQUIRE_EQ(gameboy.SaveState(unchanged), size);
+        CHECK(std::equal(unchanged.begin(), unchanged.end(), state.begin()));
+    }
+
+    TEST_CASE("Queued input doesn't change the state size")
+    {
+        auto cartridge = std::make_shared<GBE::Cartridge>();
+        cartridge->Load("./test_roms/01-special.gb");
+
+        GBE::Gameboy gameboy{};
+        gameboy.Start(cartridge);
+        gameboy.Tick();
+
+        std::vector<uint8_t> state(gameboy.GetStateSize());
+        REQUIRE_EQ(gameboy.SaveState(state), state.size());
+
+        GBE::Joypad& joypad = gameboy.GetJoypad();
+        joypad.QueueJoypadEvent(GBE::JoypadEvent{.Button = GBE::JoypadButton::A, .Pressed = true});
+        joypad.QueueJoypadEvent(GBE::JoypadEvent{.Button = GBE::JoypadButton::START, .Pressed = true});
+        CHECK_EQ(gameboy.GetStateSize(), state.size());
+
+        // the queued events are part of the state
+        std::vector<uint8_t> queuedState(state.size());
+        REQUIRE_EQ(gameboy.SaveState(queuedState), state.size());
+        CHECK_NE(queuedState, state);
+
+        REQUIRE(gameboy.LoadState(state));
+        CHECK_FALSE(joypad.HasEvents());
+
+        REQUIRE(gameboy.LoadState(queuedState));
+        CHECK(joypad.HasEvents());
+
+        // the queue is empty again once the events are handled
+        gameboy.Tick();
+        CHECK_FALSE(joypad.HasEvents());
+        CHECK(joypad.IsPressed(GBE::JoypadButton::A));
+        CHECK_EQ(gameboy.GetStateSize(), state.size());
+    }
+}
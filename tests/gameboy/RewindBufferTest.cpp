@@ -0,0 +1,209 @@
+#include "GBETestSuite.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gameboy/Gameboy.h"
+#include "gameboy/RewindBuffer.h"
+#include "cartridge/Cartridge.h"
+#include "io/joypad/Joypad.h"
+
+namespace GBETest
+{
+    // joypad event queued before frame, at most one per frame
+    static void QueueScriptedInput(GBE::Gameboy& gameboy, uint64_t frame)
+    {
+        GBE::Joypad& joypad = gameboy.GetJoypad();
+        if (frame % 7 == 3)
+            joypad.QueueJoypadEvent(GBE::JoypadEvent{.Button = GBE::JoypadButton::A, .Pressed = true});
+        else if (frame % 7 == 5)
+            joypad.QueueJoypadEvent(GBE::JoypadEvent{.Button = GBE::JoypadButton::A, .Pressed = false});
+        else if (frame % 23 == 1)
+            joypad.QueueJoypadEvent(GBE::JoypadEvent{.Button = GBE::JoypadButton::RIGHT, .Pressed = (frame / 23) % 2 == 0});
+    }
+
+    static std::vector<uint8_t> SaveState(GBE::Gameboy& gameboy)
+    {
+        std::vector<uint8_t> state(gameboy.GetStateSize());
+        gameboy.SaveState(state);
+        return state;
+    }
+
+    // states of the rom after every frame with the scripted inputs, the first one is the boot state
+    static std::vector<std::vector<uint8_t>> RecordStates(const std::shared_ptr<GBE::Cartridge>& cartridge, uint64_t frames)
+    {
+        GBE::Gameboy gameboy{};
+        gameboy.Start(cartridge);
+
+        std::vector<std::vector<uint8_t>> states{};
+        states.push_back(SaveState(gameboy));
+        for (uint64_t frame = 1; frame <= frames; frame++)
+        {
+            QueueScriptedInput(gameboy, frame);
+            gameboy.Tick();
+            states.push_back(SaveState(gameboy));
+        }
+
+        return states;
+    }
+
+    // play frames from first to last, pushing each of them
+    static void PlayFrames(GBE::Gameboy& gameboy, GBE::RewindBuffer& rewind, uint64_t first, uint64_t last)
+    {
+        for (uint64_t frame = first; frame <= last; frame++)
+        {
+            QueueScriptedInput(gameboy, frame);
+            gameboy.Tick();
+            rewind.Push(gameboy);
+        }
+    }
+
+    // step back to the oldest frame, checking every state, returns the frame reached
+    static uint64_t StepBackAll(GBE::Gameboy& gameboy, GBE::RewindBuffer& rewind, uint64_t frame, const std::vector<std::vector<uint8_t>>& states)
+    {
+        uint64_t framesCount = rewind.GetFramesCount();
+        for (uint64_t i = 0; i < framesCount; i++)
+        {
+            frame--;
+            CAPTURE(frame);
+
+            REQUIRE(rewind.StepBack(gameboy));
+            REQUIRE_EQ(rewind.GetFramesCount(), framesCount - i - 1);
+            REQUIRE(SaveState(gameboy) == states[frame]);
+        }
+
+        CHECK_FALSE(rewind.StepBack(gameboy));
+        CHECK(SaveState(gameboy) == states[frame]);
+        return frame;
+    }
+} // namespace GBETest
+
+GBE_TEST_SUITE(RewindBuffer)
+{
+    TEST_CASE("Stepping back gives the recorded frames")
+    {
+        auto cartridge = std::make_shared<GBE::Cartridge>();
+        cartridge->Load("./test_roms/02-interrupts.gb");
+
+        auto states = GBETest::RecordStates(cartridge, 150);
+
+        for (uint32_t interval: {1, 4})
+        {
+            CAPTURE(interval);
+
+            GBE::Gameboy gameboy{};
+            gameboy.Start(cartridge);
+
+            GBE::RewindBuffer rewind{16 * 1024 * 1024, interval};
+            CHECK_FALSE(rewind.StepBack(gameboy));
+
+            GBETest::PlayFrames(gameboy, rewind, 1, 120);
+            REQUIRE(GBETest::SaveState(gameboy) == states[120]);
+
+            // the first pushed frame is the oldest snapshot, the frame after it is the oldest reachable
+            CHECK_EQ(rewind.GetFramesCount(), 118);
+            CHECK_EQ(rewind.GetSnapshotsCount(), interval == 1 ? 120 : 30);
+            CHECK_LE(rewind.GetUsedSize(), rewind.GetCapacity());
+
+            // back a few frames then play again
+            for (uint32_t i = 0; i < 30; i++)
+                REQUIRE(rewind.StepBack(gameboy));
+
+            REQUIRE(GBETest::SaveState(gameboy) == states[90]);
+            GBETest::PlayFrames(gameboy, rewind, 91, 150);
+            REQUIRE(GBETest::SaveState(gameboy) == states[150]);
+            CHECK_EQ(rewind.GetFramesCount(), 148);
+
+            CHECK_EQ(GBETest::StepBackAll(gameboy, rewind, 150, states), 2);
+        }
+    }
+
+    TEST_CASE("Stepping back while playing keeps a snapshot every interval")
+    {
+        auto cartridge = std::make_shared<GBE::Cartridge>();
+        cartridge->Load("./test_roms/02-interrupts.gb");
+
+        auto states = GBETest::RecordStates(cartridge, 140);
+
+        for (uint32_t interval: {1, 2, 4})
+        {
+            CAPTURE(interval);
+
+            GBE::Gameboy gameboy{};
+            gameboy.Start(cartridge);
+
+            GBE::RewindBuffer rewind{16 * 1024 * 1024, interval};
+            GBETest::PlayFrames(gameboy, rewind, 1, 20);
+
+            // one frame back, two forward, like tapping rewind while playing
+            uint64_t frame = 20;
+            for (uint32_t i = 0; i < 60; i++)
+            {
+                CAPTURE(frame);
+
+                REQUIRE(rewind.StepBack(gameboy));
+                frame--;
+                REQUIRE(GBETest::SaveState(gameboy) == states[frame]);
+
+                GBETest::PlayFrames(gameboy, rewind, frame + 1, frame + 2);
+                frame += 2;
+                REQUIRE(GBETest::SaveState(gameboy) == states[frame]);
+
+                // every snapshot holds at most interval frames of inputs
+                REQUIRE_EQ(rewind.GetFramesCount(), frame - 2);
+                REQUIRE_LT(rewind.GetFramesCount(), rewind.GetSnapshotsCount() * interval);
+            }
+
+            CHECK_EQ(GBETest::StepBackAll(gameboy, rewind, frame, states), 2);
+        }
+    }
+
+    TEST_CASE("Oldest snapshots are dropped when the ring is full")
+    {
+        auto cartridge = std::make_shared<GBE::Cartridge>();
+        cartridge->Load("./test_roms/dmg-acid2.gb");
+
+        auto states = GBETest::RecordStates(cartridge, 300);
+
+        GBE::Gameboy gameboy{};
+        gameboy.Start(cartridge);
+
+        GBE::RewindBuffer rewind{16 * 1024, 2};
+        GBETest::PlayFrames(gameboy, rewind, 1, 300);
+
+        CHECK_GT(rewind.GetFramesCount(), 0);
+        CHECK_LT(rewind.GetFramesCount(), 298);
+        CHECK_LE(rewind.GetUsedSize(), rewind.GetCapacity());
+
+        uint64_t oldest = GBETest::StepBackAll(gameboy, rewind, 300, states);
+        CHECK_GT(oldest, 2);
+    }
+
+    TEST_CASE("Running another rom clears the history")
+    {
+        auto cartridge = std::make_shared<GBE::Cartridge>();
+        cartridge->Load("./test_roms/02-interrupts.gb");
+
+        auto otherCartridge = std::make_shared<GBE::Cartridge>();
+        otherCartridge->Load("./test_roms/01-special.gb");
+
+        GBE::Gameboy gameboy{};
+        gameboy.Start(cartridge);
+
+        GBE::RewindBuffer rewind{1024 * 1024};
+        GBETest::PlayFrames(gameboy, rewind, 1, 10);
+        CHECK_EQ(rewind.GetFramesCount(), 8);
+
+        gameboy.Stop();
+        gameboy.Start(otherCartridge);
+        CHECK_FALSE(rewind.StepBack(gameboy));
+
+        GBETest::PlayFrames(gameboy, rewind, 1, 3);
+        CHECK_EQ(rewind.GetFramesCount(), 1);
+
+        rewind.Clear();
+        CHECK_EQ(rewind.GetFramesCount(), 0);
+        CHECK_EQ(rewind.GetUsedSize(), 0);
+    }
+}
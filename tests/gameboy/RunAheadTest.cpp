@@ -0,0 +1,90 @@
+#include "GBETestSuite.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gameboy/Gameboy.h"
+#include "gameboy/RunAhead.h"
+#include "cartridge/Cartridge.h"
+#include "io/graphics/lcd/LcdScreen.h"
+
+namespace GBETest
+{
+    static std::vector<uint8_t> SaveRunAheadState(GBE::Gameboy& gameboy)
+    {
+        std::vector<uint8_t> state(gameboy.GetStateSize());
+        gameboy.SaveState(state);
+        return state;
+    }
+
+    // hash of the last frame published
+    static uint64_t GetPresentedHash(GBE::Gameboy& gameboy)
+    {
+        GBE::LcdFrameBuffer& frameBuffer = gameboy.GetPpu().GetFrameBuffer();
+        frameBuffer.Acquire();
+        return frameBuffer.GetFrontScreen().GetHash();
+    }
+} // namespace GBETest
+
+GBE_TEST_SUITE(RunAhead)
+{
+    TEST_CASE("Running ahead presents the frames ahead and keeps the run")
+    {
+        constexpr uint32_t frames = 120;
+
+        for (std::string romName: {"02-interrupts.gb", "dmg-acid2.gb"})
+        {
+            CAPTURE(romName);
+
+            auto cartridge = std::make_shared<GBE::Cartridge>();
+            cartridge->Load("./test_roms/" + romName);
+
+            // states and presented frames without run ahead
+            GBE::Gameboy expected{};
+            expected.Start(cartridge);
+
+            std::vector<std::vector<uint8_t>> states{GBETest::SaveRunAheadState(expected)};
+            std::vector<uint64_t> hashes{GBETest::GetPresentedHash(expected)};
+            for (uint32_t frame = 1; frame <= frames + GBE::RunAhead::MAX_FRAMES; frame++)
+            {
+                expected.Tick();
+                states.push_back(GBETest::SaveRunAheadState(expected));
+                hashes.push_back(GBETest::GetPresentedHash(expected));
+            }
+
+            for (uint32_t aheadFrames = 0; aheadFrames <= GBE::RunAhead::MAX_FRAMES; aheadFrames++)
+            {
+                CAPTURE(aheadFrames);
+
+                GBE::Gameboy gameboy{};
+                gameboy.Start(cartridge);
+
+                GBE::RunAhead runAhead{aheadFrames};
+                for (uint32_t frame = 1; frame <= frames; frame++)
+                {
+                    CAPTURE(frame);
+
+                    runAhead.Tick(gameboy);
+                    REQUIRE(GBETest::SaveRunAheadState(gameboy) == states[frame]);
+                    REQUIRE_EQ(GBETest::GetPresentedHash(gameboy), hashes[frame + aheadFrames]);
+                }
+
+                CHECK_FALSE(gameboy.GetPpu().IsDrawOnRequest());
+                if (aheadFrames > 0)
+                    CHECK_GT(runAhead.GetFrameBudgetUsage(), 0.0);
+                else
+                    CHECK_EQ(runAhead.GetFrameBudgetUsage(), 0.0);
+            }
+        }
+    }
+
+    TEST_CASE("Frames ahead are clamped")
+    {
+        GBE::RunAhead runAhead{};
+        CHECK_EQ(runAhead.GetFrames(), 1);
+
+        runAhead.SetFrames(10);
+        CHECK_EQ(runAhead.GetFrames(), GBE::RunAhead::MAX_FRAMES);
+    }
+}
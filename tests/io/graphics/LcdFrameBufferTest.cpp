@@ -0,0 +1,84 @@
+#include "GBETestSuite.h"
+
+#include <thread>
+
+#include "io/graphics/lcd/LcdFrameBuffer.h"
+
+GBE_TEST_SUITE(LcdFrameBufferTest)
+{
+    TEST_CASE("Published frames are acquired in order")
+    {
+        // arrange
+        GBE::LcdFrameBuffer frameBuffer{};
+        CHECK_FALSE(frameBuffer.Acquire());
+        CHECK_EQ(0, frameBuffer.GetSequence());
+
+        // act
+        frameBuffer.GetBackScreen().SetPixel(0, 0, 1);
+        frameBuffer.Publish();
+        frameBuffer.GetBackScreen().SetPixel(1, 0, 2);
+
+        // assert, the back screen starts as a copy of the published frame
+        CHECK_EQ(1, frameBuffer.GetSequence());
+        CHECK_EQ(1, frameBuffer.GetBackScreen().GetPixel(0, 0));
+
+        REQUIRE(frameBuffer.Acquire());
+        CHECK_EQ(1, frameBuffer.GetFrontSequence());
+        CHECK_EQ(1, frameBuffer.GetFrontScreen().GetPixel(0, 0));
+        CHECK_EQ(0, frameBuffer.GetFrontScreen().GetPixel(1, 0));
+        CHECK_FALSE(frameBuffer.Acquire());
+
+        // act, two frames published before the next acquire
+        frameBuffer.Publish();
+        frameBuffer.GetBackScreen().SetPixel(2, 0, 3);
+        frameBuffer.Publish();
+
+        // assert, only the latest is seen
+        REQUIRE(frameBuffer.Acquire());
+        CHECK_EQ(3, frameBuffer.GetFrontSequence());
+        CHECK_EQ(2, frameBuffer.GetFrontScreen().GetPixel(1, 0));
+        CHECK_EQ(3, frameBuffer.GetFrontScreen().GetPixel(2, 0));
+    }
+
+    TEST_CASE("Consumer thread sees whole frames")
+    {
+        // arrange
+        constexpr uint64_t frames = 200;
+        GBE::LcdFrameBuffer frameBuffer{};
+
+        // act, every pixel of frame n is n
+        std::thread producer([&frameBuffer]()
+        {
+            for (uint64_t frame = 1; frame <= frames; frame++)
+            {
+                for (uint8_t y = 0; y < GBE::LCD_SCREEN_HEIGHT; y++)
+                {
+                    for (uint8_t x = 0; x < GBE::LCD_SCREEN_WIDTH; x++)
+                        frameBuffer.GetBackScreen().SetPixel(x, y, static_cast<uint8_t>(frame));
+                }
+
+                frameBuffer.Publish();
+            }
+        });
+
+        uint64_t sequence = 0;
+        bool isTorn = false;
+        while (sequence < frames)
+        {
+            frameBuffer.Wait(sequence);
+            if (!frameBuffer.Acquire())
+                continue;
+
+            const GBE::LcdScreen& screen = frameBuffer.GetFrontScreen();
+            sequence = frameBuffer.GetFrontSequence();
+            for (uint8_t pixel: screen.GetPixels())
+                isTorn |= pixel != static_cast<uint8_t>(sequence);
+        }
+
+        producer.join();
+
+        // assert
+        CHECK_FALSE(isTorn);
+        CHECK_EQ(frames, sequence);
+    }
+}
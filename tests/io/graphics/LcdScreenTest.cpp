@@ -0,0 +1,64 @@
+#include "GBETestSuite.h"
+
+#include <vector>
+
+#include "io/graphics/lcd/LcdScreen.h"
+
+GBE_TEST_SUITE(LcdScreenTest)
+{
+    TEST_CASE("Versions only change with the pixels")
+    {
+        // arrange
+        GBE::LcdScreen screen{};
+        uint64_t version = screen.GetVersion();
+        uint32_t line0Version = screen.GetLineVersion(0);
+        uint32_t line1Version = screen.GetLineVersion(1);
+
+        // act, same value
+        screen.SetPixel(3, 0, 0);
+
+        // assert
+        CHECK_EQ(version, screen.GetVersion());
+        CHECK_EQ(line0Version, screen.GetLineVersion(0));
+
+        // act, new value
+        screen.SetPixel(3, 0, 2);
+
+        // assert
+        CHECK_NE(version, screen.GetVersion());
+        CHECK_NE(line0Version, screen.GetLineVersion(0));
+        CHECK_EQ(line1Version, screen.GetLineVersion(1));
+    }
+
+    TEST_CASE("RGBA conversion matches the scalar version")
+    {
+        // arrange
+        GBE::LcdScreen screen{};
+        uint32_t seed = 0x13579BDF;
+        for (uint8_t y = 0; y < GBE::LCD_SCREEN_HEIGHT; y++)
+        {
+            for (uint8_t x = 0; x < GBE::LCD_SCREEN_WIDTH; x++)
+            {
+                seed = seed * 1664525 + 1013904223;
+                screen.SetPixel(x, y, (seed >> 24) & 3);
+            }
+        }
+
+        GBE::LcdScreen::PaletteRGBA palette = {0xFFD0F8E0, 0xFF70C088, 0xFF566834, 0xFF201808};
+
+        // act
+        std::vector<uint32_t> expected(GBE::LCD_SCREEN_WIDTH * GBE::LCD_SCREEN_HEIGHT);
+        screen.ToRGBAScalar(0, GBE::LCD_SCREEN_HEIGHT, palette, expected.data());
+
+        std::vector<uint32_t> rgba(GBE::LCD_SCREEN_WIDTH * GBE::LCD_SCREEN_HEIGHT);
+        screen.ToRGBA(0, GBE::LCD_SCREEN_HEIGHT, palette, rgba.data());
+
+        std::vector<uint32_t> line(GBE::LCD_SCREEN_WIDTH);
+        screen.ToRGBA(7, 1, palette, line.data());
+
+        // assert
+        CHECK_EQ(expected, rgba);
+        for (uint8_t x = 0; x < GBE::LCD_SCREEN_WIDTH; x++)
+            CHECK_EQ(palette[screen.GetPixel(x, 7)], line[x]);
+    }
+}
@@ -0,0 +1,67 @@
+#include "GBETestSuite.h"
+
+#include <vector>
+
+#include "io/graphics/oam/ObjectAttributesMemory.h"
+
+namespace GBETest
+{
+    static void SetObject(GBE::ObjectAttributesMemory& oam, uint8_t objectID, uint8_t y, uint8_t x)
+    {
+        oam.Set(objectID * GBE::OBJECT_ATTRIBUTE_SIZE, y);
+        oam.Set(objectID * GBE::OBJECT_ATTRIBUTE_SIZE + 1, x);
+    }
+
+    static std::vector<uint8_t> GetLineObjects(GBE::ObjectAttributesMemory& oam, uint8_t y, uint8_t objectSize)
+    {
+        const GBE::LineObjects& objects = oam.GetLineObjects(y, objectSize);
+        return std::vector<uint8_t>(objects.begin(), objects.end());
+    }
+} // namespace GBETest
+
+GBE_TEST_SUITE(ObjectAttributesMemoryTest)
+{
+    TEST_CASE("Line objects are the first 10 in oam order sorted by x")
+    {
+        // arrange
+        GBE::ObjectAttributesMemory oam{};
+        oam.Init();
+        oam.SetReadWriteFlags(true);
+
+        // 12 objects on lines 0-7, x decreasing, objects 3 and 4 share x
+        for (uint8_t objectID = 0; objectID < 12; objectID++)
+            GBETest::SetObject(oam, objectID, 16, 100 - objectID * 4);
+        GBETest::SetObject(oam, 4, 16, 88);
+
+        // act / assert
+        CHECK_EQ(std::vector<uint8_t>{9, 8, 7, 6, 5, 3, 4, 2, 1, 0}, GBETest::GetLineObjects(oam, 0, 1));
+        CHECK_EQ(GBETest::GetLineObjects(oam, 0, 1), GBETest::GetLineObjects(oam, 7, 1));
+        CHECK(GBETest::GetLineObjects(oam, 8, 1).empty());
+        CHECK_EQ(GBETest::GetLineObjects(oam, 0, 1), GBETest::GetLineObjects(oam, 15, 2));
+    }
+
+    TEST_CASE("Line objects follow oam writes")
+    {
+        // arrange
+        GBE::ObjectAttributesMemory oam{};
+        oam.Init();
+        oam.SetReadWriteFlags(true);
+
+        for (uint8_t objectID = 0; objectID < 11; objectID++)
+            GBETest::SetObject(oam, objectID, 20, 8 + objectID);
+        CHECK_EQ(10, GBETest::GetLineObjects(oam, 10, 1).size());
+
+        // act, object 0 moves down so object 10 is selected
+        GBETest::SetObject(oam, 0, 40, 50);
+
+        // assert
+        CHECK_EQ(std::vector<uint8_t>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10}, GBETest::GetLineObjects(oam, 10, 1));
+        CHECK_EQ(std::vector<uint8_t>{0}, GBETest::GetLineObjects(oam, 30, 1));
+
+        // act, x change reorders the line
+        GBETest::SetObject(oam, 10, 20, 0);
+
+        // assert
+        CHECK_EQ(std::vector<uint8_t>{10, 1, 2, 3, 4, 5, 6, 7, 8, 9}, GBETest::GetLineObjects(oam, 10, 1));
+    }
+}
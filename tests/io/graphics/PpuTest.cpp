@@ -1,6 +1,117 @@
 #include "GBETestSuite.h"
 
+#include <memory>
+#include <string>
+
+#include "gameboy/Gameboy.h"
+#include "cartridge/Cartridge.h"
+#include "cpu/Cpu.h"
+#include "io/graphics/Ppu.h"
+#include "io/graphics/lcd/LcdScreen.h"
+
+namespace GBETest
+{
+    // runs rom with the fifo and the scanline renderers and compares the screens after every frame
+    static void CheckScanlineMatchesFIFO(const std::string& romPath, uint32_t frames)
+    {
+        auto cartridge = std::make_shared<GBE::Cartridge>();
+        cartridge->Load(romPath);
+
+        GBE::Gameboy fifo{GBE::PpuRenderer::FIFO};
+        fifo.Start(cartridge);
+
+        GBE::Gameboy scanline{GBE::PpuRenderer::SCANLINE};
+        scanline.Start(cartridge);
+
+        for (uint32_t frame = 0; frame < frames; frame++)
+        {
+            CAPTURE(frame);
+
+            REQUIRE_EQ(fifo.Tick(), scanline.Tick());
+            REQUIRE_EQ(fifo.GetCpu().GetInstructionsCounter(), scanline.GetCpu().GetInstructionsCounter());
+            REQUIRE_EQ(fifo.GetPpu().GetLcdScreen().GetHash(), scanline.GetPpu().GetLcdScreen().GetHash());
+        }
+    }
+
+    // cpu state and cycles of both gameboys are the same
+    static void CheckSameTiming(GBE::Gameboy& expected, GBE::Gameboy& actual)
+    {
+        REQUIRE_EQ(expected.Tick(), actual.Tick());
+        REQUIRE_EQ(expected.GetCpu().GetInstructionsCounter(), actual.GetCpu().GetInstructionsCounter());
+        REQUIRE_EQ(expected.GetCpu().GetRegisters().GetReg16(GBE::Reg16::PC), actual.GetCpu().GetRegisters().GetReg16(GBE::Reg16::PC));
+        REQUIRE_EQ(expected.GetCpu().GetRegisters().GetReg16(GBE::Reg16::AF), actual.GetCpu().GetRegisters().GetReg16(GBE::Reg16::AF));
+    }
+} // namespace GBETest
 
 GBE_TEST_SUITE(PpuTest) 
 {
-}
\ No newline at end of file
+    TEST_CASE("Scanline renderer draws the same frames as the fifo")
+    {
+        for (std::string romName: {"01-special.gb", "02-interrupts.gb", "dmg-acid2.gb"})
+        {
+            CAPTURE(romName);
+            GBETest::CheckScanlineMatchesFIFO("./test_roms/" + romName, 300);
+        }
+    }
+
+    TEST_CASE("Skipped frames keep the timing and leave the screen")
+    {
+        auto cartridge = std::make_shared<GBE::Cartridge>();
+        cartridge->Load("./test_roms/dmg-acid2.gb");
+
+        GBE::Gameboy drawn{};
+        drawn.Start(cartridge);
+
+        GBE::Gameboy skipped{};
+        skipped.GetPpu().SetDrawOnRequest(true);
+        skipped.Start(cartridge);
+
+        const uint64_t version = skipped.GetPpu().GetLcdScreen().GetVersion();
+        for (uint32_t frame = 0; frame < 120; frame++)
+        {
+            CAPTURE(frame);
+            GBETest::CheckSameTiming(drawn, skipped);
+        }
+
+        CHECK_EQ(version, skipped.GetPpu().GetLcdScreen().GetVersion());
+        CHECK_EQ(0, skipped.GetPpu().GetFrameBuffer().GetSequence());
+        CHECK_GT(drawn.GetPpu().GetFrameBuffer().GetSequence(), 0);
+
+        // the acid2 screen is static, a requested frame draws it
+        skipped.GetPpu().RequestFrame();
+        for (uint32_t frame = 0; frame < 3; frame++)
+            GBETest::CheckSameTiming(drawn, skipped);
+
+        CHECK_EQ(drawn.GetPpu().GetLcdScreen().GetHash(), skipped.GetPpu().GetLcdScreen().GetHash());
+
+        // only the requested frame is published
+        GBE::LcdFrameBuffer& frameBuffer = skipped.GetPpu().GetFrameBuffer();
+        CHECK_EQ(1, frameBuffer.GetSequence());
+        REQUIRE(frameBuffer.Acquire());
+        CHECK_EQ(drawn.GetPpu().GetLcdScreen().GetHash(), frameBuffer.GetFrontScreen().GetHash());
+    }
+
+    TEST_CASE("Frame skip keeps the timing")
+    {
+        auto cartridge = std::make_shared<GBE::Cartridge>();
+        cartridge->Load("./test_roms/02-interrupts.gb");
+
+        GBE::Gameboy drawn{};
+        drawn.Start(cartridge);
+
+        GBE::Gameboy skipped{};
+        skipped.GetPpu().SetFrameSkip(2);
+        skipped.Start(cartridge);
+
+        uint32_t drawnFrames = 0;
+        for (uint32_t frame = 0; frame < 300; frame++)
+        {
+            CAPTURE(frame);
+            GBETest::CheckSameTiming(drawn, skipped);
+            drawnFrames += skipped.GetPpu().IsDrawingFrame();
+        }
+
+        CHECK_GT(drawnFrames, 0);
+        CHECK_LT(drawnFrames, 300);
+    }
+}
@@ -1,6 +1,7 @@
 #include "GBETestSuite.h"
 
 #include "io/graphics/vram/TileData.h"
+#include "io/graphics/vram/Vram.h"
 
 GBE_TEST_SUITE(TileDataTest)
 {
@@ -38,4 +39,38 @@ GBE_TEST_SUITE(TileDataTest)
             }
         }
     }
-}
\ No newline at end of file
+
+    TEST_CASE("Vram keeps the decoded tiles up to date")
+    {
+        // arrange
+        GBE::Vram vram{};
+        vram.Init();
+
+        std::vector<uint8_t> tileData = { 0x3C, 0x7E, 0x42, 0x42, 0x42, 0x42, 0x42, 0x42, 0x7E, 0x5E, 0x7E, 0x0A, 0x7C, 0x56, 0x38, 0x7C };
+        // tile 1 in block 0, tile -1 in block 2 for signed addressing
+        std::vector<uint16_t> tileAddresses = { GBE::TILE_VRAM_SIZE, 0x1000 - GBE::TILE_VRAM_SIZE };
+
+        // act
+        for (uint16_t address: tileAddresses)
+        {
+            for (uint16_t i = 0; i < static_cast<uint16_t>(tileData.size()); i++)
+                vram.Set(address + i, tileData[i]);
+        }
+
+        // assert
+        const GBE::TileData& tile = vram.GetObject(1);
+        for (const GBE::TilePixels* pixels: {&vram.GetObjectPixels(1), &vram.GetTilePixelsBGWin(0xFF, false)})
+        {
+            for (uint8_t y = 0; y < GBE::TILE_SIZE; y++)
+            {
+                for (uint8_t x = 0; x < GBE::TILE_SIZE; x++)
+                {
+                    CHECK_EQ(tile.GetPixel(x, y), pixels->GetRow(y, false)[x]);
+                    CHECK_EQ(tile.GetPixel(x, y), pixels->GetRow(y, true)[GBE::TILE_SIZE - x - 1]);
+                }
+            }
+        }
+
+        CHECK_EQ(vram.GetObjectPixels(0).GetRow(0, false)[1], 0);
+    }
+}
@@ -0,0 +1,84 @@
+#include "GBETestSuite.h"
+
+#include <vector>
+
+#include "io/graphics/vram/TileData.h"
+#include "io/graphics/vram/TileDecoder.h"
+
+namespace GBETest
+{
+    // pseudo random bitplanes
+    static std::vector<uint8_t> MakeTileRows(size_t rows)
+    {
+        std::vector<uint8_t> data(rows * 2);
+
+        uint32_t seed = 0x2468ACE1;
+        for (uint8_t& byte: data)
+        {
+            seed = seed * 1664525 + 1013904223;
+            byte = seed >> 24;
+        }
+
+        return data;
+    }
+} // namespace GBETest
+
+GBE_TEST_SUITE(TileDecoderTest)
+{
+    TEST_CASE("Decoded rows match the tile pixels")
+    {
+        // arrange, an odd number of rows to go through the remainders
+        constexpr size_t rows = 2 * GBE::TILE_SIZE + 3;
+        std::vector<uint8_t> data = GBETest::MakeTileRows(rows);
+
+        std::vector<uint8_t> indices(rows * GBE::TILE_SIZE);
+        std::vector<uint8_t> flippedIndices(rows * GBE::TILE_SIZE);
+
+        // act
+        GBE::TileDecoder::DecodeRows(data.data(), rows, false, indices.data());
+        GBE::TileDecoder::DecodeRows(data.data(), rows, true, flippedIndices.data());
+
+        // assert
+        for (size_t row = 0; row < rows; row++)
+        {
+            GBE::TileData tile{};
+            tile.Set(0, data[row * 2]);
+            tile.Set(1, data[row * 2 + 1]);
+
+            for (uint8_t x = 0; x < GBE::TILE_SIZE; x++)
+            {
+                CHECK_EQ(tile.GetPixel(x, 0), indices[row * GBE::TILE_SIZE + x]);
+                CHECK_EQ(tile.GetPixel(x, 0), flippedIndices[row * GBE::TILE_SIZE + GBE::TILE_SIZE - x - 1]);
+            }
+        }
+    }
+
+    TEST_CASE("Colors match the scalar kernels")
+    {
+        // arrange
+        constexpr size_t rows = 4 * GBE::TILE_SIZE + 1;
+        std::vector<uint8_t> data = GBETest::MakeTileRows(rows);
+
+        std::vector<uint8_t> indices(rows * GBE::TILE_SIZE);
+        GBE::TileDecoder::DecodeRowsScalar(data.data(), rows, false, indices.data());
+
+        for (uint8_t palette: {0x00, 0xE4, 0x1B, 0xD2, 0xFF})
+        {
+            CAPTURE(palette);
+
+            std::vector<uint8_t> expected(indices.size());
+            GBE::TileDecoder::MapColorsScalar(indices.data(), indices.size(), palette, expected.data());
+
+            // act
+            std::vector<uint8_t> colors(indices.size());
+            GBE::TileDecoder::MapColors(indices.data(), indices.size(), palette, colors.data());
+
+            std::vector<uint8_t> decodedColors(indices.size());
+            GBE::TileDecoder::DecodeRowsColors(data.data(), rows, palette, decodedColors.data());
+
+            // assert
+            CHECK_EQ(expected, colors);
+            CHECK_EQ(expected, decodedColors);
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#include "GBETestSuite.h"
+
+#include "io/interrupts/InterruptManager.h"
+#include "memory/Memory.h"
+
+GBE_TEST_SUITE(InterruptManagerTest)
+{
+    TEST_CASE("Pending interrupts follow IE and IF")
+    {
+        // arrange
+        auto interruptManager = std::make_shared<GBE::InterruptManager>();
+        GBE::Memory memory{};
+        memory.MapMemoryArea({GBE::MMAP_IF, GBE::MMAP_IE}, interruptManager);
+        memory.Init();
+
+        // IF starts at $E1, its upper bits are never pending
+        CHECK_EQ(interruptManager->GetPendingInterrupts(), 0);
+
+        // act
+        memory.Set(GBE::MMAP_IE.GetStart(), 0xFF);
+
+        // assert
+        CHECK_EQ(interruptManager->GetPendingInterrupts(), 0b00001);
+
+        // act
+        interruptManager->QueueInterrupt(GBE::InterruptFlag::TIMER);
+        interruptManager->AcknowledgeInterrupt(GBE::InterruptFlag::V_BLANK);
+
+        // assert
+        CHECK_EQ(interruptManager->GetPendingInterrupts(), 0b00100);
+        CHECK_EQ(memory.Get(GBE::MMAP_IF.GetStart()), 0xE4);
+
+        // act
+        memory.Set(GBE::MMAP_IE.GetStart(), 0b00011);
+
+        // assert
+        CHECK_EQ(interruptManager->GetPendingInterrupts(), 0);
+    }
+}
@@ -0,0 +1,57 @@
+#include "GBETestSuite.h"
+
+#include "io/scheduler/Scheduler.h"
+
+GBE_TEST_SUITE(SchedulerTest)
+{
+    TEST_CASE("Events are due at their deadline")
+    {
+        // arrange
+        GBE::Scheduler scheduler{};
+        CHECK_EQ(scheduler.GetNextDeadline(), GBE::Scheduler::NEVER);
+
+        // act
+        scheduler.Schedule(GBE::SchedulerEvent::PPU, 20);
+        scheduler.Schedule(GBE::SchedulerEvent::TIMER, 10);
+
+        // assert
+        CHECK_EQ(scheduler.GetNextDeadline(), 10);
+        CHECK_FALSE(scheduler.HasDueEvent());
+
+        // act
+        scheduler.Advance(12);
+
+        // assert
+        CHECK(scheduler.IsDue(GBE::SchedulerEvent::TIMER));
+        CHECK_FALSE(scheduler.IsDue(GBE::SchedulerEvent::PPU));
+        CHECK_EQ(scheduler.PopDueEvent(), GBE::SchedulerEvent::TIMER);
+        CHECK_EQ(scheduler.PopDueEvent(), GBE::SchedulerEvent::COUNT);
+        CHECK_EQ(scheduler.GetNextDeadline(), 20);
+
+        // act
+        scheduler.Cancel(GBE::SchedulerEvent::PPU);
+
+        // assert
+        CHECK_EQ(scheduler.GetNextDeadline(), GBE::Scheduler::NEVER);
+    }
+
+    TEST_CASE("Due events are popped in priority order")
+    {
+        // arrange
+        GBE::Scheduler scheduler{};
+        scheduler.Schedule(GBE::SchedulerEvent::INPUT, 0);
+        scheduler.Schedule(GBE::SchedulerEvent::DMA, 1);
+        scheduler.Schedule(GBE::SchedulerEvent::TIMER, 3);
+        scheduler.Schedule(GBE::SchedulerEvent::PPU, 100);
+
+        // act
+        scheduler.Advance(4);
+
+        // assert
+        CHECK_EQ(scheduler.PopDueEvent(), GBE::SchedulerEvent::TIMER);
+        CHECK_EQ(scheduler.PopDueEvent(), GBE::SchedulerEvent::DMA);
+        CHECK_EQ(scheduler.PopDueEvent(), GBE::SchedulerEvent::INPUT);
+        CHECK_FALSE(scheduler.HasDueEvent());
+        CHECK_EQ(scheduler.GetNextDeadline(), 100);
+    }
+}
@@ -0,0 +1,103 @@
+#include "GBETestSuite.h"
+
+#include "io/timer/Timer.h"
+#include "io/interrupts/InterruptManager.h"
+#include "io/scheduler/Scheduler.h"
+#include "memory/Memory.h"
+
+namespace GBETest
+{
+    constexpr uint16_t ADDRESS_DIV = 0xFF04;
+    constexpr uint16_t ADDRESS_TIMA = 0xFF05;
+    constexpr uint16_t ADDRESS_TMA = 0xFF06;
+    constexpr uint16_t ADDRESS_TAC = 0xFF07;
+
+    struct TimerFixture
+    {
+        std::shared_ptr<GBE::InterruptManager> InterruptManager = std::make_shared<GBE::InterruptManager>();
+        std::shared_ptr<GBE::Scheduler> Scheduler = std::make_shared<GBE::Scheduler>();
+        std::shared_ptr<GBE::Timer> Timer = std::make_shared<GBE::Timer>(InterruptManager, Scheduler);
+        GBE::Memory Memory{};
+
+        TimerFixture()
+        {
+            Memory.MapMemoryArea({GBE::MMAP_TIMER}, Timer);
+            Memory.MapMemoryArea({GBE::MMAP_IF, GBE::MMAP_IE}, InterruptManager);
+            Memory.Init();
+            Memory.Set(GBE::MMAP_IE.GetStart(), 0xFF);
+        }
+
+        bool IsTimerInterruptPending() const
+        {
+            return InterruptManager->GetPendingInterrupts() & (1 << static_cast<uint8_t>(GBE::InterruptFlag::TIMER));
+        }
+    };
+} // namespace GBETest
+
+GBE_TEST_SUITE(TimerTest)
+{
+    TEST_CASE("DIV and TIMA follow the scheduler clock")
+    {
+        // arrange
+        GBETest::TimerFixture fixture{};
+        GBE::Memory& memory = fixture.Memory;
+        memory.Set(GBETest::ADDRESS_TAC, 0x05);
+
+        // act
+        fixture.Scheduler->Advance(64 * 3 + 10);
+
+        // assert
+        CHECK_EQ(memory.Get(GBETest::ADDRESS_DIV), 0x18 + 3);
+        CHECK_EQ(memory.Get(GBETest::ADDRESS_TIMA), (64 * 3 + 10) / 4);
+    }
+
+    TEST_CASE("TIMA overflow is scheduled and reloads TMA")
+    {
+        // arrange
+        GBETest::TimerFixture fixture{};
+        GBE::Memory& memory = fixture.Memory;
+        memory.Set(GBETest::ADDRESS_TMA, 0xF0);
+        memory.Set(GBETest::ADDRESS_TIMA, 0xFE);
+        memory.Set(GBETest::ADDRESS_TAC, 0x05);
+
+        // assert
+        CHECK_EQ(fixture.Scheduler->GetDeadline(GBE::SchedulerEvent::TIMER), 8);
+
+        // act
+        fixture.Scheduler->Advance(8);
+        CHECK(fixture.Scheduler->IsDue(GBE::SchedulerEvent::TIMER));
+        fixture.Timer->Update();
+
+        // assert
+        CHECK(fixture.IsTimerInterruptPending());
+        CHECK_EQ(memory.Get(GBETest::ADDRESS_TIMA), 0xF0);
+        CHECK_EQ(fixture.Scheduler->GetDeadline(GBE::SchedulerEvent::TIMER), 8 + 16 * 4);
+    }
+
+    TEST_CASE("Falling edges on DIV and TAC writes increment TIMA")
+    {
+        // arrange
+        GBETest::TimerFixture fixture{};
+        GBE::Memory& memory = fixture.Memory;
+        memory.Set(GBETest::ADDRESS_TAC, 0x05);
+
+        // bit 1 of the counter is set
+        fixture.Scheduler->Advance(2);
+        CHECK_EQ(memory.Get(GBETest::ADDRESS_TIMA), 0);
+
+        // act
+        memory.Set(GBETest::ADDRESS_DIV, 0x42);
+
+        // assert
+        CHECK_EQ(memory.Get(GBETest::ADDRESS_DIV), 0);
+        CHECK_EQ(memory.Get(GBETest::ADDRESS_TIMA), 1);
+
+        // act
+        fixture.Scheduler->Advance(2);
+        memory.Set(GBETest::ADDRESS_TAC, 0x00);
+
+        // assert
+        CHECK_EQ(memory.Get(GBETest::ADDRESS_TIMA), 2);
+        CHECK_EQ(fixture.Scheduler->GetDeadline(GBE::SchedulerEvent::TIMER), GBE::Scheduler::NEVER);
+    }
+}
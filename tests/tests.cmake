@@ -2,6 +2,8 @@ set (GBE_TESTS_SOURCES
     ${CMAKE_CURRENT_LIST_DIR}/GBETestSuite.h
     ${CMAKE_CURRENT_LIST_DIR}/cpu/CpuTest.cpp
     ${CMAKE_CURRENT_LIST_DIR}/cpu/CpuRomTest.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/cpu/CpuBlockCacheTest.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/cpu/CpuJitTest.cpp
     ${CMAKE_CURRENT_LIST_DIR}/cpu/InstructionDecoderTest.cpp
     ${CMAKE_CURRENT_LIST_DIR}/cpu/CpuRegistersSetTest.cpp
     ${CMAKE_CURRENT_LIST_DIR}/cpu/CpuRegisterTest.cpp
@@ -9,7 +11,18 @@ set (GBE_TESTS_SOURCES
     ${CMAKE_CURRENT_LIST_DIR}/cpu/InstructionTest.cpp
     ${CMAKE_CURRENT_LIST_DIR}/memory/MemoryTest.cpp
     ${CMAKE_CURRENT_LIST_DIR}/io/graphics/LcdPaletteTest.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/io/graphics/LcdScreenTest.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/io/graphics/LcdFrameBufferTest.cpp
     ${CMAKE_CURRENT_LIST_DIR}/io/graphics/TileDataTest.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/io/graphics/TileDecoderTest.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/io/graphics/ObjectAttributesMemoryTest.cpp
     ${CMAKE_CURRENT_LIST_DIR}/io/graphics/PpuTest.cpp
-    ${CMAKE_CURRENT_LIST_DIR}/io/joypad/JoypadTest.cpp 
+    ${CMAKE_CURRENT_LIST_DIR}/io/interrupts/InterruptManagerTest.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/io/joypad/JoypadTest.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/io/scheduler/SchedulerTest.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/io/timer/TimerTest.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/gameboy/GameboyStateTest.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/gameboy/RewindBufferTest.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/gameboy/RunAheadTest.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/batch/BatchRunnerTest.cpp
 )
\ No newline at end of file
@@ -11,7 +11,7 @@ namespace GBE
     void AssertImpl(bool condition, const char *conditionStr, const char *file, int line);
     
     template<typename T>
-    void Assert(T condition, const char *conditionStr, const char *file, int line)
+    constexpr void Assert(T condition, const char *conditionStr, const char *file, int line)
     {
         if (condition)
             return;
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <bit>
+#include <span>
+#include <type_traits>
+
+namespace GBE
+{
+    // reads a save state written by StateWriter
+    // reading past the end of the buffer returns zeros and marks the reader as underflowed
+    class StateReader
+    {
+    public:
+        StateReader(std::span<const uint8_t> buffer):
+            m_Buffer(buffer)
+        {
+        }
+
+        ~StateReader() = default;
+
+        // bytes read
+        inline size_t GetSize() const
+        {
+            return m_Size;
+        }
+
+        inline bool IsUnderflowed() const
+        {
+            return m_IsUnderflowed;
+        }
+
+        // integers, enums and bools
+        template <typename T>
+        inline T Read()
+        {
+            if constexpr (std::is_enum_v<T>)
+            {
+                return static_cast<T>(Read<std::underlying_type_t<T>>());
+            }
+            else
+            {
+                static_assert(std::is_integral_v<T>, "only integers can be read from a state");
+
+                T value{};
+                ReadBytes(reinterpret_cast<uint8_t*>(&value), sizeof(T));
+
+                if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1)
+                    value = std::byteswap(value);
+
+                return value;
+            }
+        }
+
+        template <typename T>
+        inline void Read(T& value)
+        {
+            value = Read<T>();
+        }
+
+        inline void ReadBytes(uint8_t* data, size_t size)
+        {
+            const uint8_t* bytes = ReadData(size);
+            if (bytes)
+                std::memcpy(data, bytes, size);
+            else
+                std::memset(data, 0, size);
+        }
+
+        // next size bytes of the buffer, nullptr if there aren't enough
+        inline const uint8_t* ReadData(size_t size)
+        {
+            if (m_Size + size > m_Buffer.size())
+            {
+                m_IsUnderflowed = true;
+                return nullptr;
+            }
+
+            const uint8_t* data = m_Buffer.data() + m_Size;
+            m_Size += size;
+            return data;
+        }
+
+    private:
+        std::span<const uint8_t> m_Buffer{};
+        size_t m_Size = 0;
+        bool m_IsUnderflowed = false;
+    };
+} // namespace GBE
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <bit>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace GBE
+{
+    // writes a save state to a caller buffer, values are stored little-endian
+    // once the buffer is full the writer only counts the size, so an empty buffer measures the state
+    class StateWriter
+    {
+    public:
+        StateWriter(std::span<uint8_t> buffer):
+            m_Buffer(buffer)
+        {
+        }
+
+        ~StateWriter() = default;
+
+        // bytes written (or needed if the buffer is too small)
+        inline size_t GetSize() const
+        {
+            return m_Size;
+        }
+
+        inline bool IsOverflowed() const
+        {
+            return m_Size > m_Buffer.size();
+        }
+
+        // integers, enums and bools
+        template <typename T>
+        inline void Write(T value)
+        {
+            if constexpr (std::is_enum_v<T>)
+            {
+                Write(std::to_underlying(value));
+            }
+            else
+            {
+                static_assert(std::is_integral_v<T>, "only integers can be written to a state");
+
+                if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1)
+                    value = std::byteswap(value);
+
+                WriteBytes(reinterpret_cast<const uint8_t*>(&value), sizeof(T));
+            }
+        }
+
+        inline void WriteBytes(const uint8_t* data, size_t size)
+        {
+            if (m_Size + size <= m_Buffer.size())
+                std::memcpy(m_Buffer.data() + m_Size, data, size);
+
+            m_Size += size;
+        }
+
+    private:
+        std::span<uint8_t> m_Buffer{};
+        size_t m_Size = 0;
+    };
+} // namespace GBE
@@ -1,6 +1,8 @@
 set (GBE_HEADERS ${GBE_HEADERS}
     ${CMAKE_CURRENT_LIST_DIR}/Binary.h
     ${CMAKE_CURRENT_LIST_DIR}/Assert.h
+    ${CMAKE_CURRENT_LIST_DIR}/StateWriter.h
+    ${CMAKE_CURRENT_LIST_DIR}/StateReader.h
 )
 
 set(GBE_SOURCES ${GBE_SOURCES}